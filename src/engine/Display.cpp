@@ -1,6 +1,8 @@
 #include "Display.hpp"
 #include "ConfigLoader.hpp"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 Camera::~Camera()
 {
@@ -18,9 +20,9 @@ void Camera::init(sf::Vector2f center, sf::Vector2f size)
     view.setCenter(center);
     view.setSize(size);
 
-    // 初始化最小X值为屏幕一半
+    // 初始化最小X值为屏幕一半，右边界在关卡加载后由setHorizontalBounds根据关卡宽度设置
     minX = size.x / 2.f;
-    maxX = 3500.f; // 假设最大X值为3500，可以根据实际场景调整
+    maxX = std::numeric_limits<float>::max();
     followoffsetX = size.x / 10.f; // 跟随偏移设为屏幕宽度的十分之一（玩家位于屏幕左边2/5位置）
 }
 
@@ -59,15 +61,23 @@ void Camera::setSize(sf::Vector2f size)
     view.setSize(size);
 }
 
+void Camera::setHorizontalBounds(float left, float right)
+{
+    // 相机中心距离边界至少半个屏幕；关卡比屏幕窄时固定在左边界
+    float halfWidth = view.getSize().x / 2.f;
+    minX = left + halfWidth;
+    maxX = std::max(minX, right - halfWidth);
+}
+
 Display::Display()
 {
     // Display类的构造函数实现
-    windowLoader.setBaseDir("");
-    windowLoader.loadConfig("config\\engine.ini", "Display");
-    int width = std::get<int>(windowLoader.getValue("DisplayWidth"));
-    int height = std::get<int>(windowLoader.getValue("DisplayHeight"));
-    int frameLimit = std::get<int>(windowLoader.getValue("FrameLimit"));
-    std::string title = std::get<std::string>(windowLoader.getValue("WindowTitle"));
+    // 与main共用engine.ini的解析结果
+    std::shared_ptr<const ConfigLoader> config = ConfigLoader::shared("config/engine.ini");
+    int width = config->getInt("Display", "DisplayWidth", 1920);
+    int height = config->getInt("Display", "DisplayHeight", 1080);
+    int frameLimit = config->getInt("Display", "FrameLimit", 60);
+    std::string title = config->getString("Display", "WindowTitle", "");
     window = sf::RenderWindow(sf::VideoMode({static_cast<unsigned int>(width), static_cast<unsigned int>(height)}), title);
     window.setFramerateLimit(frameLimit);
     // 初始化相机
@@ -0,0 +1,623 @@
+#include "EntityStore.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENEMY_SYSTEM_SSE2 1
+#endif
+
+// -------------------------------- EntityIndex --------------------------------
+
+EntityIndex::Entity EntityIndex::create()
+{
+    Entity entity;
+    if (!freeEntities.empty()) {
+        entity = freeEntities.back();
+        freeEntities.pop_back();
+    } else {
+        entity = static_cast<Entity>(sparse.size());
+        sparse.push_back(0);
+    }
+    sparse[entity] = static_cast<std::uint32_t>(entities.size());
+    entities.push_back(entity);
+    return entity;
+}
+
+void EntityIndex::erase(Entity entity)
+{
+    std::size_t index = sparse[entity];
+    std::size_t last = entities.size() - 1;
+    if (index != last) {
+        entities[index] = entities[last];
+        sparse[entities[index]] = static_cast<std::uint32_t>(index);
+    }
+    entities.pop_back();
+    sparse[entity] = nullEntity;
+    freeEntities.push_back(entity);
+}
+
+void EntityIndex::reserve(std::size_t count)
+{
+    entities.reserve(count);
+    sparse.reserve(count);
+}
+
+void EntityIndex::clear()
+{
+    entities.clear();
+    sparse.clear();
+    freeEntities.clear();
+}
+
+// -------------------------------- EntityStore --------------------------------
+
+EntityStore::EntityStore()
+{
+    // 构造函数
+}
+
+EntityStore::~EntityStore()
+{
+    // 析构函数
+}
+
+void EntityStore::resizeComponents(std::size_t count)
+{
+    posX.resize(count, 0.0f);
+    posY.resize(count, 0.0f);
+    prevX.resize(count, 0.0f);
+    prevY.resize(count, 0.0f);
+    velX.resize(count, 0.0f);
+    velY.resize(count, 0.0f);
+    body.resize(count, b2_nullBodyId);
+    halfW.resize(count, 0.0f);
+    halfH.resize(count, 0.0f);
+    patrolMinX.resize(count, 0.0f);
+    patrolMaxX.resize(count, 0.0f);
+    patrolSpeed.resize(count, 0.0f);
+    faceRight.resize(count, 1);
+    health.resize(count, 0.0f);
+    maxHealth.resize(count, 0.0f);
+    attackCooldown.resize(count, 0.0f);
+    alive.resize(count, 1);
+    awake.resize(count, 1);
+    dirty.resize(count, 1);
+    blending.resize(count, 0);
+    lod.resize(count, 0);
+    lodAccum.resize(count, 0.0f);
+    stepDt.resize(count, 0.0f);
+    animTimer.resize(count, 0.0f);
+    animFrameTime.resize(count, 0.15f);
+    animFrame.resize(count, 0);
+    animFrameCount.resize(count, 0);
+    sprite.resize(count, nullptr);
+    frames.resize(count, nullptr);
+}
+
+void EntityStore::moveComponents(std::size_t from, std::size_t to)
+{
+    posX[to] = posX[from];
+    posY[to] = posY[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    velX[to] = velX[from];
+    velY[to] = velY[from];
+    body[to] = body[from];
+    halfW[to] = halfW[from];
+    halfH[to] = halfH[from];
+    patrolMinX[to] = patrolMinX[from];
+    patrolMaxX[to] = patrolMaxX[from];
+    patrolSpeed[to] = patrolSpeed[from];
+    faceRight[to] = faceRight[from];
+    health[to] = health[from];
+    maxHealth[to] = maxHealth[from];
+    attackCooldown[to] = attackCooldown[from];
+    alive[to] = alive[from];
+    awake[to] = awake[from];
+    dirty[to] = dirty[from];
+    blending[to] = blending[from];
+    lod[to] = lod[from];
+    lodAccum[to] = lodAccum[from];
+    stepDt[to] = stepDt[from];
+    animTimer[to] = animTimer[from];
+    animFrameTime[to] = animFrameTime[from];
+    animFrame[to] = animFrame[from];
+    animFrameCount[to] = animFrameCount[from];
+    sprite[to] = sprite[from];
+    frames[to] = frames[from];
+}
+
+EntityStore::Entity EntityStore::create()
+{
+    Entity entity = ids.create();
+    resizeComponents(ids.size());
+    return entity;
+}
+
+void EntityStore::destroy(Entity entity)
+{
+    if (!ids.valid(entity)) {
+        return;
+    }
+    // 最后一个实体搬到被删除的位置，数组保持连续
+    std::size_t index = ids.index(entity);
+    std::size_t last = ids.size() - 1;
+    if (index != last) {
+        moveComponents(last, index);
+    }
+    ids.erase(entity);
+    resizeComponents(ids.size());
+}
+
+void EntityStore::reserve(std::size_t count)
+{
+    ids.reserve(count);
+    posX.reserve(count);
+    posY.reserve(count);
+    prevX.reserve(count);
+    prevY.reserve(count);
+    velX.reserve(count);
+    velY.reserve(count);
+    body.reserve(count);
+    halfW.reserve(count);
+    halfH.reserve(count);
+    patrolMinX.reserve(count);
+    patrolMaxX.reserve(count);
+    patrolSpeed.reserve(count);
+    faceRight.reserve(count);
+    health.reserve(count);
+    maxHealth.reserve(count);
+    attackCooldown.reserve(count);
+    alive.reserve(count);
+    awake.reserve(count);
+    dirty.reserve(count);
+    blending.reserve(count);
+    lod.reserve(count);
+    lodAccum.reserve(count);
+    stepDt.reserve(count);
+    animTimer.reserve(count);
+    animFrameTime.reserve(count);
+    animFrame.reserve(count);
+    animFrameCount.reserve(count);
+    sprite.reserve(count);
+    frames.reserve(count);
+}
+
+void EntityStore::clear()
+{
+    ids.clear();
+    resizeComponents(0);
+}
+
+void EntityStore::clearDirty()
+{
+    std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+void EntityStore::onBodyMoved(Entity entity, b2Vec2 position, bool fellAsleep)
+{
+    if (!valid(entity)) {
+        return;
+    }
+    std::size_t i = ids.index(entity);
+    posX[i]  = position.x;
+    posY[i]  = position.y;
+    awake[i] = fellAsleep ? 0 : 1;
+    dirty[i] = 1;
+}
+
+void EntityStore::savePrevious()
+{
+    std::copy(posX.begin(), posX.end(), prevX.begin());
+    std::copy(posY.begin(), posY.end(), prevY.begin());
+}
+
+// -------------------------------- BlockStore --------------------------------
+
+void BlockStore::resizeComponents(std::size_t count)
+{
+    left.resize(count, 0.0f);
+    top.resize(count, 0.0f);
+    right.resize(count, 0.0f);
+    bottom.resize(count, 0.0f);
+    collision.resize(count);
+    type.resize(count, 0);
+    health.resize(count, 0.0f);
+    destroyed.resize(count, 0);
+    body.resize(count, b2_nullBodyId);
+}
+
+void BlockStore::moveComponents(std::size_t from, std::size_t to)
+{
+    left[to] = left[from];
+    top[to] = top[from];
+    right[to] = right[from];
+    bottom[to] = bottom[from];
+    collision[to] = collision[from];
+    type[to] = type[from];
+    health[to] = health[from];
+    destroyed[to] = destroyed[from];
+    body[to] = body[from];
+}
+
+BlockStore::Entity BlockStore::create()
+{
+    Entity entity = ids.create();
+    resizeComponents(ids.size());
+    return entity;
+}
+
+void BlockStore::destroy(Entity entity)
+{
+    if (!ids.valid(entity)) {
+        return;
+    }
+    std::size_t index = ids.index(entity);
+    std::size_t last = ids.size() - 1;
+    if (index != last) {
+        moveComponents(last, index);
+    }
+    ids.erase(entity);
+    resizeComponents(ids.size());
+}
+
+void BlockStore::reserve(std::size_t count)
+{
+    ids.reserve(count);
+    left.reserve(count);
+    top.reserve(count);
+    right.reserve(count);
+    bottom.reserve(count);
+    collision.reserve(count);
+    type.reserve(count);
+    health.reserve(count);
+    destroyed.reserve(count);
+    body.reserve(count);
+}
+
+void BlockStore::clear()
+{
+    ids.clear();
+    resizeComponents(0);
+}
+
+// -------------------------------- BlockSystem --------------------------------
+
+std::uint32_t BlockSystem::touchedTypes(const BlockStore& store, const sf::FloatRect& bounds)
+{
+    float left   = bounds.position.x;
+    float top    = bounds.position.y;
+    float right  = left + bounds.size.x;
+    float bottom = top + bounds.size.y;
+    std::uint32_t types = 0;
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        bool intersect = left < store.right[i] && right > store.left[i] &&
+                         top < store.bottom[i] && bottom > store.top[i];
+        if (intersect && !store.destroyed[i]) {
+            types |= 1u << store.type[i];
+        }
+    }
+    return types;
+}
+
+// -------------------------------- EnemySystem --------------------------------
+
+EnemySystem::LodStats EnemySystem::updateLod(EntityStore& store, const sf::FloatRect& view, const LodSettings& settings)
+{
+    LodStats stats;
+    float left   = view.position.x;
+    float top    = view.position.y;
+    float right  = left + view.size.x;
+    float bottom = top + view.size.y;
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        if (!store.alive[i]) continue;
+        // 中心到视野矩形的距离（在视野内为0）
+        float dx = std::max({ left - store.posX[i], 0.0f, store.posX[i] - right });
+        float dy = std::max({ top - store.posY[i], 0.0f, store.posY[i] - bottom });
+        float distance = std::sqrt(dx * dx + dy * dy);
+
+        std::int32_t level = LodFull;
+        if (settings.enabled && distance > 0.0f) {
+            level = distance <= settings.nearDistance ? LodNear : LodFrozen;
+        }
+
+        std::int32_t previous = store.lod[i];
+        if (level != previous) {
+            if (level == LodFrozen) {
+                // 冻结：实体不再参与模拟，或至少停在原地
+                if (settings.disableBodies) {
+                    b2Body_Disable(store.body[i]);
+                } else {
+                    b2Vec2 velocity = b2Body_GetLinearVelocity(store.body[i]);
+                    b2Body_SetLinearVelocity(store.body[i], { 0.0f, velocity.y });
+                }
+            } else if (previous == LodFrozen) {
+                if (!b2Body_IsEnabled(store.body[i])) {
+                    b2Body_Enable(store.body[i]);
+                }
+                store.awake[i] = 1;
+                store.dirty[i] = 1;
+            }
+            store.lod[i] = level;
+            store.lodAccum[i] = 0.0f;
+        }
+
+        if (level == LodFull) {
+            ++stats.full;
+        } else if (level == LodNear) {
+            ++stats.nearby;
+        } else {
+            ++stats.frozen;
+        }
+    }
+    return stats;
+}
+
+void EnemySystem::scheduleSteps(EntityStore& store, float deltaTime, int nearInterval, std::size_t begin, std::size_t end)
+{
+    std::uint32_t interval = static_cast<std::uint32_t>(std::max(1, nearInterval));
+    std::uint32_t frame = store.frameIndex++;
+    for (std::size_t i = begin; i < end; ++i) {
+        std::int32_t level = store.lod[i];
+        if (level == LodFull) {
+            store.stepDt[i] = deltaTime;
+        } else if (level == LodNear) {
+            // 附近的敌人按下标错开，每interval帧用累积的时间更新一次
+            store.lodAccum[i] += deltaTime;
+            if ((frame + static_cast<std::uint32_t>(i)) % interval == 0) {
+                store.stepDt[i] = store.lodAccum[i];
+                store.lodAccum[i] = 0.0f;
+            } else {
+                store.stepDt[i] = 0.0f;
+            }
+        } else {
+            store.stepDt[i] = 0.0f;
+        }
+    }
+}
+
+void EnemySystem::update(EntityStore& store, float deltaTime, std::size_t begin, std::size_t end, int nearInterval)
+{
+    if (end == 0 || end > store.size()) {
+        end = store.size();
+    }
+    if (begin >= end) {
+        return;
+    }
+
+    // 1) 按LOD决定每个敌人本帧推进的时间
+    scheduleSteps(store, deltaTime, nearInterval, begin, end);
+
+    // 2) 巡逻、攻击冷却、帧动画：只读写紧凑数组
+    stepPatrol(store, begin, end, Path::Simd);
+
+    // 3) 速度一次性写回Box2D；本帧不更新的、睡眠且不需要移动的实体不调用Box2D
+    for (std::size_t i = begin; i < end; ++i) {
+        if (!store.alive[i] || store.stepDt[i] <= 0.0f) continue;
+        if (!store.awake[i] && store.velX[i] == 0.0f && store.velY[i] == 0.0f) continue;
+        b2Body_SetLinearVelocity(store.body[i], { store.velX[i], store.velY[i] });
+        store.awake[i] = 1;    // 非零速度会唤醒实体
+    }
+
+    // 4) 只同步dirty的sprite：位置、动画帧、朝向
+    for (std::size_t i = begin; i < end; ++i) {
+        sf::Sprite* sprite = store.sprite[i];
+        if (!store.dirty[i] || !store.alive[i] || !sprite) continue;
+        sprite->setPosition({ store.posX[i] - store.halfW[i], store.posY[i] - store.halfH[i] });
+        if (store.frames[i] && store.animFrameCount[i] > 0) {
+            sprite->setTextureRect(store.frames[i][store.animFrame[i]]);
+        }
+        float scaleX = store.faceRight[i] ? spriteScale : -spriteScale;
+        sprite->setScale({ scaleX, spriteScale });
+    }
+}
+
+void EnemySystem::interpolate(EntityStore& store, float alpha)
+{
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        sf::Sprite* sprite = store.sprite[i];
+        if (!store.alive[i] || !sprite) continue;
+        bool moved = store.prevX[i] != store.posX[i] || store.prevY[i] != store.posY[i];
+        // 两步之间没有移动、且sprite已经在当前位置的实体不需要处理
+        if (!moved && !store.blending[i]) continue;
+        float x = store.prevX[i] + (store.posX[i] - store.prevX[i]) * alpha;
+        float y = store.prevY[i] + (store.posY[i] - store.prevY[i]) * alpha;
+        sprite->setPosition({ x - store.halfW[i], y - store.halfH[i] });
+        store.blending[i] = moved ? 1 : 0;
+        store.dirty[i] = 1;
+    }
+}
+
+void EnemySystem::stepPatrol(EntityStore& store, std::size_t begin, std::size_t end, Path path)
+{
+    if (path == Path::Simd) {
+        begin = stepPatrolSimd(store, begin, end);
+    }
+    stepPatrolScalar(store, begin, end);
+}
+
+int EnemySystem::simdWidth()
+{
+#if defined(__AVX2__)
+    return 8;
+#elif defined(ENEMY_SYSTEM_SSE2)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+void EnemySystem::stepPatrolScalar(EntityStore& store, std::size_t begin, std::size_t end)
+{
+    for (std::size_t i = begin; i < end; ++i) {
+        float deltaTime = store.stepDt[i];
+        if (!store.alive[i] || deltaTime <= 0.0f) continue;
+        // 按当前朝向给速度，到达端点调头（下一帧生效）
+        bool right = store.faceRight[i] != 0;
+        store.velX[i] = right ? store.patrolSpeed[i] : -store.patrolSpeed[i];
+        if (right && store.posX[i] >= store.patrolMaxX[i]) {
+            store.faceRight[i] = 0;
+            store.dirty[i] = 1;
+        } else if (!right && store.posX[i] <= store.patrolMinX[i]) {
+            store.faceRight[i] = 1;
+            store.dirty[i] = 1;
+        }
+        store.attackCooldown[i] = std::max(0.0f, store.attackCooldown[i] - deltaTime);
+
+        if (store.animFrameCount[i] <= 0) continue;
+        store.animTimer[i] += deltaTime;
+        if (store.animTimer[i] >= store.animFrameTime[i]) {
+            store.animTimer[i] -= store.animFrameTime[i];
+            store.animFrame[i] = (store.animFrame[i] + 1) % store.animFrameCount[i];
+            store.dirty[i] = 1;
+        }
+    }
+}
+
+#if defined(__AVX2__)
+
+std::size_t EnemySystem::stepPatrolSimd(EntityStore& store, std::size_t begin, std::size_t end)
+{
+    const __m256 zeroF    = _mm256_setzero_ps();
+    const __m256i zeroI   = _mm256_setzero_si256();
+    const __m256i oneI    = _mm256_set1_epi32(1);
+    const __m256 signBit  = _mm256_set1_ps(-0.0f);
+
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        // 掩码：本帧更新（存活且stepDt大于0）、朝右、有动画
+        __m256  dt     = _mm256_loadu_ps(&store.stepDt[i]);
+        __m256i aliveI = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&store.alive[i]));
+        __m256  alive  = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(aliveI, zeroI), _mm256_set1_epi32(-1)));
+        alive = _mm256_and_ps(alive, _mm256_cmp_ps(dt, zeroF, _CMP_GT_OQ));
+        __m256i rightI = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&store.faceRight[i]));
+        __m256  right  = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(rightI, zeroI), _mm256_set1_epi32(-1)));
+
+        // 巡逻：velX = right ? speed : -speed
+        __m256 speed = _mm256_loadu_ps(&store.patrolSpeed[i]);
+        __m256 velX  = _mm256_blendv_ps(_mm256_xor_ps(speed, signBit), speed, right);
+        _mm256_storeu_ps(&store.velX[i], _mm256_blendv_ps(_mm256_loadu_ps(&store.velX[i]), velX, alive));
+
+        // 调头：朝右且越过右端点，或朝左且越过左端点
+        __m256 pos   = _mm256_loadu_ps(&store.posX[i]);
+        __m256 flipR = _mm256_and_ps(right, _mm256_cmp_ps(pos, _mm256_loadu_ps(&store.patrolMaxX[i]), _CMP_GE_OQ));
+        __m256 flipL = _mm256_andnot_ps(right, _mm256_cmp_ps(pos, _mm256_loadu_ps(&store.patrolMinX[i]), _CMP_LE_OQ));
+        __m256i flip = _mm256_castps_si256(_mm256_and_ps(_mm256_or_ps(flipR, flipL), alive));
+        rightI = _mm256_xor_si256(rightI, _mm256_and_si256(flip, oneI));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&store.faceRight[i]), rightI);
+
+        // 攻击冷却
+        __m256 cooldown = _mm256_loadu_ps(&store.attackCooldown[i]);
+        __m256 cooled   = _mm256_max_ps(zeroF, _mm256_sub_ps(cooldown, dt));
+        _mm256_storeu_ps(&store.attackCooldown[i], _mm256_blendv_ps(cooldown, cooled, alive));
+
+        // 帧动画：计时器累加，到时间推进一帧并回绕
+        __m256i countI = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&store.animFrameCount[i]));
+        __m256  animOn = _mm256_and_ps(alive, _mm256_castsi256_ps(_mm256_cmpgt_epi32(countI, zeroI)));
+        __m256 timer     = _mm256_loadu_ps(&store.animTimer[i]);
+        __m256 frameTime = _mm256_loadu_ps(&store.animFrameTime[i]);
+        __m256 advanced  = _mm256_add_ps(timer, dt);
+        __m256 step      = _mm256_and_ps(animOn, _mm256_cmp_ps(advanced, frameTime, _CMP_GE_OQ));
+        advanced = _mm256_blendv_ps(advanced, _mm256_sub_ps(advanced, frameTime), step);
+        _mm256_storeu_ps(&store.animTimer[i], _mm256_blendv_ps(timer, advanced, animOn));
+
+        __m256i frameI = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&store.animFrame[i]));
+        __m256i nextI  = _mm256_add_epi32(frameI, oneI);
+        // next >= count 时回到0（帧号始终小于帧数）
+        nextI  = _mm256_andnot_si256(_mm256_cmpgt_epi32(oneI, _mm256_sub_epi32(countI, nextI)), nextI);
+        frameI = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(frameI), _mm256_castsi256_ps(nextI), step));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&store.animFrame[i]), frameI);
+
+        // 调头或换帧的sprite需要重新同步
+        __m256i changed = _mm256_and_si256(_mm256_or_si256(flip, _mm256_castps_si256(step)), oneI);
+        __m256i dirtyI  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&store.dirty[i]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&store.dirty[i]), _mm256_or_si256(dirtyI, changed));
+    }
+    return i;
+}
+
+#elif defined(ENEMY_SYSTEM_SSE2)
+
+namespace {
+    // SSE2没有blendv：mask为全1的通道取b，否则取a
+    inline __m128 select(__m128 a, __m128 b, __m128 mask)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+    }
+    inline __m128i select(__m128i a, __m128i b, __m128i mask)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, b), _mm_andnot_si128(mask, a));
+    }
+}
+
+std::size_t EnemySystem::stepPatrolSimd(EntityStore& store, std::size_t begin, std::size_t end)
+{
+    const __m128 zeroF   = _mm_setzero_ps();
+    const __m128i zeroI  = _mm_setzero_si128();
+    const __m128i oneI   = _mm_set1_epi32(1);
+    const __m128i allI   = _mm_set1_epi32(-1);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        // 掩码：本帧更新（存活且stepDt大于0）、朝右、有动画
+        __m128  dt     = _mm_loadu_ps(&store.stepDt[i]);
+        __m128i aliveI = _mm_xor_si128(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&store.alive[i])), zeroI), allI);
+        __m128  alive  = _mm_and_ps(_mm_castsi128_ps(aliveI), _mm_cmpgt_ps(dt, zeroF));
+        __m128i rightI = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&store.faceRight[i]));
+        __m128  right  = _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(rightI, zeroI), allI));
+
+        // 巡逻：velX = right ? speed : -speed
+        __m128 speed = _mm_loadu_ps(&store.patrolSpeed[i]);
+        __m128 velX  = select(_mm_xor_ps(speed, signBit), speed, right);
+        _mm_storeu_ps(&store.velX[i], select(_mm_loadu_ps(&store.velX[i]), velX, alive));
+
+        // 调头：朝右且越过右端点，或朝左且越过左端点
+        __m128 pos   = _mm_loadu_ps(&store.posX[i]);
+        __m128 flipR = _mm_and_ps(right, _mm_cmpge_ps(pos, _mm_loadu_ps(&store.patrolMaxX[i])));
+        __m128 flipL = _mm_andnot_ps(right, _mm_cmple_ps(pos, _mm_loadu_ps(&store.patrolMinX[i])));
+        __m128i flip = _mm_castps_si128(_mm_and_ps(_mm_or_ps(flipR, flipL), alive));
+        rightI = _mm_xor_si128(rightI, _mm_and_si128(flip, oneI));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&store.faceRight[i]), rightI);
+
+        // 攻击冷却
+        __m128 cooldown = _mm_loadu_ps(&store.attackCooldown[i]);
+        __m128 cooled   = _mm_max_ps(zeroF, _mm_sub_ps(cooldown, dt));
+        _mm_storeu_ps(&store.attackCooldown[i], select(cooldown, cooled, alive));
+
+        // 帧动画：计时器累加，到时间推进一帧并回绕
+        __m128i countI   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&store.animFrameCount[i]));
+        __m128  animOn   = _mm_and_ps(alive, _mm_castsi128_ps(_mm_cmpgt_epi32(countI, zeroI)));
+        __m128 timer     = _mm_loadu_ps(&store.animTimer[i]);
+        __m128 frameTime = _mm_loadu_ps(&store.animFrameTime[i]);
+        __m128 advanced  = _mm_add_ps(timer, dt);
+        __m128 step      = _mm_and_ps(animOn, _mm_cmpge_ps(advanced, frameTime));
+        advanced = select(advanced, _mm_sub_ps(advanced, frameTime), step);
+        _mm_storeu_ps(&store.animTimer[i], select(timer, advanced, animOn));
+
+        __m128i frameI = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&store.animFrame[i]));
+        __m128i nextI  = _mm_add_epi32(frameI, oneI);
+        // next >= count 时回到0（帧号始终小于帧数）
+        nextI  = _mm_andnot_si128(_mm_cmplt_epi32(_mm_sub_epi32(countI, nextI), oneI), nextI);
+        frameI = select(frameI, nextI, _mm_castps_si128(step));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&store.animFrame[i]), frameI);
+
+        // 调头或换帧的sprite需要重新同步
+        __m128i changed = _mm_and_si128(_mm_or_si128(flip, _mm_castps_si128(step)), oneI);
+        __m128i dirtyI  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&store.dirty[i]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&store.dirty[i]), _mm_or_si128(dirtyI, changed));
+    }
+    return i;
+}
+
+#else
+
+std::size_t EnemySystem::stepPatrolSimd(EntityStore&, std::size_t begin, std::size_t)
+{
+    // 没有可用的指令集，全部交给标量实现
+    return begin;
+}
+
+#endif
@@ -14,7 +14,7 @@ EventSys::~EventSys()
 void EventSys::regImmEvent(const ImmEventPriority eventType, const EventFunc& func)
 {
     // 注册即时事件的实现
-    ImmEvent newEvent{eventType, func};
+    ImmEvent newEvent{eventType, func, immEventSeq++};
     immEventQueue.push(newEvent);
 }
 
@@ -66,6 +66,30 @@ void EventSys::executeTimedEvents()
     }
 }
 
+void EventSys::regFrameEvent(const EventFunc& func)
+{
+    frameEvents.push_back(func);
+}
+
+void EventSys::executeFrameEvents()
+{
+    // 先取出再执行：执行中注册的帧边界事件留到下一帧
+    std::vector<EventFunc> events;
+    events.swap(frameEvents);
+    for (const EventFunc& func : events)
+    {
+        try
+        {
+            func();
+        }
+        catch (const std::exception& e)
+        {
+            // 处理异常：输出日志
+            std::cerr << "Error occurred while executing frame event: " << e.what() << std::endl;
+        }
+    }
+}
+
 sf::Time EventSys::getElapsedTime() const
 {
     return eventSysClock.getElapsedTime();
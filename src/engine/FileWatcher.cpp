@@ -0,0 +1,154 @@
+#include "FileWatcher.hpp"
+#include <cstdio>
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 没有系统通知时比较修改时间的间隔
+constexpr std::chrono::milliseconds scanInterval(250);
+
+} // namespace
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+    notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notifyFd < 0) {
+        printf("[FileWatcher] inotify unavailable, falling back to polling modification times\n");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+    if (notifyFd >= 0) {
+        close(notifyFd);
+    }
+#endif
+}
+
+fs::file_time_type FileWatcher::modifiedTime(const fs::path& path)
+{
+    std::error_code ec;
+    fs::file_time_type mtime = fs::last_write_time(path, ec);
+    return ec ? fs::file_time_type{} : mtime;
+}
+
+bool FileWatcher::watch(const std::string& path, Callback callback)
+{
+    fs::path file = fs::path(path).lexically_normal();
+    fs::path directory = file.parent_path();
+    if (directory.empty()) {
+        directory = ".";
+    }
+    std::string name = file.filename().string();
+    for (Watch& watch : watches) {
+        if (watch.directory == directory && watch.name == name) {
+            watch.callback = std::move(callback);
+            return true;
+        }
+    }
+
+    Watch watch;
+    watch.path = path;
+    watch.directory = directory;
+    watch.name = name;
+    watch.mtime = modifiedTime(file);
+    watch.callback = std::move(callback);
+#if defined(__linux__)
+    if (notifyFd >= 0) {
+        auto it = directoryWatches.find(directory.string());
+        if (it == directoryWatches.end()) {
+            // 写入完成与改名替换；不监视IN_CREATE，新建的文件要等写完才通知
+            int wd = inotify_add_watch(notifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (wd < 0) {
+                printf("[FileWatcher] Cannot watch %s\n", directory.string().c_str());
+                return false;
+            }
+            it = directoryWatches.emplace(directory.string(), wd).first;
+        }
+        watch.directoryWatch = it->second;
+    }
+#endif
+    watches.push_back(std::move(watch));
+    return true;
+}
+
+void FileWatcher::readNotifications()
+{
+#if defined(__linux__)
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(notifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN：没有更多事件
+            if (length < 0 && errno != EAGAIN && errno != EINTR) {
+                printf("[FileWatcher] Failed to read notifications\n");
+            }
+            return;
+        }
+        for (char* ptr = buffer; ptr < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+            if (event->len == 0) {
+                continue;
+            }
+            for (Watch& watch : watches) {
+                if (watch.directoryWatch == event->wd && watch.name == event->name) {
+                    watch.changed = true;
+                }
+            }
+        }
+    }
+#endif
+}
+
+void FileWatcher::scanModifiedTimes()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastScan < scanInterval) {
+        return;
+    }
+    lastScan = now;
+    for (Watch& watch : watches) {
+        fs::file_time_type mtime = modifiedTime(watch.directory / watch.name);
+        if (mtime != watch.mtime) {
+            watch.mtime = mtime;
+            // 文件被删除时不通知，重新出现时再通知
+            watch.changed = mtime != fs::file_time_type{};
+        }
+    }
+}
+
+std::size_t FileWatcher::poll()
+{
+    if (notifyFd >= 0) {
+        readNotifications();
+    } else {
+        scanModifiedTimes();
+    }
+
+    std::size_t count = 0;
+    std::shared_ptr<EventSys> eventSys = eventSysPtr.lock();
+    for (Watch& watch : watches) {
+        if (!watch.changed) {
+            continue;
+        }
+        watch.changed = false;
+        ++count;
+        printf("[FileWatcher] %s changed\n", watch.path.c_str());
+        if (eventSys) {
+            eventSys->regFrameEvent([callback = watch.callback, path = watch.path]() { callback(path); });
+        } else {
+            watch.callback(watch.path);
+        }
+    }
+    return count;
+}
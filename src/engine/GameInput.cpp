@@ -7,7 +7,7 @@ GameInputRead::GameInputRead()
     Keys = {
         sf::Keyboard::Key::W, sf::Keyboard::Key::A, sf::Keyboard::Key::S, sf::Keyboard::Key::D,
         sf::Keyboard::Key::Space, sf::Keyboard::Key::Escape, sf::Keyboard::Key::R,
-        sf::Keyboard::Key::J, sf::Keyboard::Key::K
+        sf::Keyboard::Key::J, sf::Keyboard::Key::K, sf::Keyboard::Key::Backspace
         // 可以根据需要添加更多按键
     };
 }
@@ -0,0 +1,94 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+Profiler::Profiler(std::size_t maxEvents) : maxEvents(maxEvents)
+{
+}
+
+void Profiler::record(const std::string& name, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    Stat& stat = stats[name];
+    ++stat.count;
+    stat.totalMs += ms;
+    stat.maxMs = std::max(stat.maxMs, ms);
+    stat.lastMs = ms;
+}
+
+void Profiler::event(const std::string& category, const std::string& name, double ms)
+{
+    record(category, ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (maxEvents == 0) {
+        return;
+    }
+    if (events.size() >= maxEvents) {
+        events.pop_front();
+    }
+    events.push_back(Event{category, name, ms});
+}
+
+void Profiler::setCounter(const std::string& name, double value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    counters[name] = value;
+}
+
+Profiler::Stat Profiler::getStat(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = stats.find(name);
+    return it != stats.end() ? it->second : Stat{};
+}
+
+double Profiler::getCounter(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = counters.find(name);
+    return it != counters.end() ? it->second : 0.0;
+}
+
+std::vector<Profiler::Event> Profiler::getEvents(const std::string& category) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Event> result;
+    for (const Event& e : events) {
+        if (category.empty() || e.category == category) {
+            result.push_back(e);
+        }
+    }
+    return result;
+}
+
+void Profiler::report() const
+{
+    std::vector<std::pair<std::string, Stat>> sorted;
+    std::vector<std::pair<std::string, double>> counterList;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted.assign(stats.begin(), stats.end());
+        counterList.assign(counters.begin(), counters.end());
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.totalMs > b.second.totalMs;
+    });
+    printf("[Profiler] %-32s %8s %10s %10s %10s\n", "name", "count", "total ms", "avg ms", "max ms");
+    for (const auto& [name, stat] : sorted) {
+        double avg = stat.count ? stat.totalMs / static_cast<double>(stat.count) : 0.0;
+        printf("[Profiler] %-32s %8llu %10.2f %10.3f %10.3f\n", name.c_str(),
+               static_cast<unsigned long long>(stat.count), stat.totalMs, avg, stat.maxMs);
+    }
+    std::sort(counterList.begin(), counterList.end());
+    for (const auto& [name, value] : counterList) {
+        printf("[Profiler] %-32s %12.0f\n", name.c_str(), value);
+    }
+}
+
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.clear();
+    counters.clear();
+    events.clear();
+}
@@ -0,0 +1,239 @@
+#include "RawImageCache.hpp"
+#include "AssetPack.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// 头部按字节写入、按指针直接读取，布局必须固定
+static_assert(sizeof(RawImageCache::Header) == 48, "RawImageCache::Header layout changed");
+
+namespace {
+
+bool readFile(const std::string& path, std::vector<char>& bytes)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+bool RawImageCache::Entry::upload(sf::Texture& texture) const
+{
+    if (!pixels || !texture.resize(size)) {
+        return false;
+    }
+    texture.update(pixels);
+    return true;
+}
+
+RawImageCache::RawImageCache(std::string directory) : directory(std::move(directory))
+{
+    std::error_code ec;
+    fs::create_directories(this->directory, ec);
+    if (ec) {
+        printf("[RawImageCache] Cannot create %s: %s\n", this->directory.c_str(), ec.message().c_str());
+    }
+}
+
+bool RawImageCache::statSource(const std::string& sourcePath, SourceInfo& info)
+{
+    if (AssetPack::View view = AssetVfs::find(sourcePath)) {
+        info.packed = true;
+        info.size   = view.size;
+        info.mtime  = 0;
+        return true;
+    }
+    std::error_code ec;
+    std::uintmax_t size = fs::file_size(sourcePath, ec);
+    if (ec) {
+        return false;
+    }
+    fs::file_time_type mtime = fs::last_write_time(sourcePath, ec);
+    if (ec) {
+        return false;
+    }
+    info.packed = false;
+    info.size   = size;
+    info.mtime  = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+std::uint64_t RawImageCache::hashBytes(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = 1469598103934665603ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool RawImageCache::hashSource(const std::string& sourcePath, std::uint64_t& hash)
+{
+    if (AssetPack::View view = AssetVfs::find(sourcePath)) {
+        hash = hashBytes(view.data, view.size);
+        return true;
+    }
+    std::vector<char> bytes;
+    if (!readFile(sourcePath, bytes)) {
+        return false;
+    }
+    hash = hashBytes(bytes.data(), bytes.size());
+    return true;
+}
+
+std::string RawImageCache::cachePathFor(const std::string& sourcePath) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.rgba",
+             static_cast<unsigned long long>(AssetPack::hashPath(AssetPack::normalize(sourcePath))));
+    return (fs::path(directory) / name).string();
+}
+
+std::shared_ptr<const RawImageCache::Entry> RawImageCache::find(const std::string& sourcePath)
+{
+    auto miss = [this]() {
+        ++misses;
+        return nullptr;
+    };
+    SourceInfo info;
+    if (!statSource(sourcePath, info)) {
+        return miss();
+    }
+    std::string cachePath = cachePathFor(sourcePath);
+    auto entry = std::make_shared<Entry>();
+    if (!entry->file.open(cachePath) || entry->file.size() < sizeof(Header)) {
+        return miss();
+    }
+
+    // 校验头部：格式、源路径（排除文件名哈希冲突）与像素范围
+    const std::uint8_t* base = entry->file.data();
+    const std::size_t length = entry->file.size();
+    Header h;
+    std::memcpy(&h, base, sizeof(h));
+    std::string path = AssetPack::normalize(sourcePath);
+    std::uint64_t pixelBytes = static_cast<std::uint64_t>(h.width) * h.height * 4;
+    if (std::memcmp(h.magic, "RGBA", 4) != 0 || h.version != version ||
+        h.width == 0 || h.height == 0 || h.pixelOffset % alignment != 0 ||
+        h.pathLength != path.size() || sizeof(Header) + h.pathLength > h.pixelOffset ||
+        h.pixelOffset > length || pixelBytes > length - h.pixelOffset ||
+        std::memcmp(base + sizeof(Header), path.data(), path.size()) != 0) {
+        return miss();
+    }
+    if (h.sourceSize != info.size) {
+        return miss();
+    }
+    if (info.packed || h.sourceMtime != info.mtime) {
+        // 修改时间对不上（或没有修改时间）时比对内容
+        std::uint64_t hash = 0;
+        if (!hashSource(sourcePath, hash) || hash != h.sourceHash) {
+            return miss();
+        }
+        if (!info.packed) {
+            // 内容没变，只刷新头部的修改时间，下次不必再算哈希
+            std::fstream file(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+            if (file.is_open()) {
+                file.seekp(static_cast<std::streamoff>(offsetof(Header, sourceMtime)));
+                file.write(reinterpret_cast<const char*>(&info.mtime), sizeof(info.mtime));
+            }
+        }
+    }
+
+    entry->size   = sf::Vector2u(h.width, h.height);
+    entry->pixels = base + h.pixelOffset;
+    ++hits;
+    return entry;
+}
+
+bool RawImageCache::decode(const std::string& sourcePath, sf::Image& image)
+{
+    SourceInfo info;
+    if (!statSource(sourcePath, info)) {
+        return false;
+    }
+    // 源文件只读一次：同一份字节既算哈希又用来解码
+    std::vector<char> bytes;
+    const void* data = nullptr;
+    std::size_t size = 0;
+    if (AssetPack::View view = AssetVfs::find(sourcePath)) {
+        data = view.data;
+        size = view.size;
+    } else {
+        if (!readFile(sourcePath, bytes)) {
+            return false;
+        }
+        data = bytes.data();
+        size = bytes.size();
+    }
+    if (!image.loadFromMemory(data, size)) {
+        return false;
+    }
+    // 读取期间文件又被修改时，以实际读到的内容为准
+    info.size = size;
+    store(sourcePath, info, hashBytes(data, size), image);
+    return true;
+}
+
+bool RawImageCache::store(const std::string& sourcePath, const SourceInfo& info, std::uint64_t hash,
+                          const sf::Image& image) const
+{
+    sf::Vector2u imageSize = image.getSize();
+    if (imageSize.x == 0 || imageSize.y == 0) {
+        return false;
+    }
+    std::string path = AssetPack::normalize(sourcePath);
+    Header h{};
+    std::memcpy(h.magic, "RGBA", 4);
+    h.version     = version;
+    h.width       = imageSize.x;
+    h.height      = imageSize.y;
+    h.sourceSize  = info.size;
+    h.sourceMtime = info.mtime;
+    h.sourceHash  = hash;
+    h.pathLength  = static_cast<std::uint32_t>(path.size());
+    h.pixelOffset = static_cast<std::uint32_t>((sizeof(Header) + path.size() + alignment - 1) / alignment * alignment);
+
+    // 先写临时文件再改名，其它线程或进程不会映射到写了一半的缓存
+    static std::atomic<unsigned> tempCounter{0};
+    std::string cachePath = cachePathFor(sourcePath);
+    std::string tempPath = cachePath + "." + std::to_string(tempCounter.fetch_add(1)) + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            printf("[RawImageCache] Cannot write %s\n", tempPath.c_str());
+            return false;
+        }
+        static const char zeros[alignment] = {};
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(path.data(), static_cast<std::streamsize>(path.size()));
+        out.write(zeros, static_cast<std::streamsize>(h.pixelOffset - sizeof(h) - path.size()));
+        out.write(reinterpret_cast<const char*>(image.getPixelsPtr()),
+                  static_cast<std::streamsize>(static_cast<std::uint64_t>(imageSize.x) * imageSize.y * 4));
+        if (!out.good()) {
+            out.close();
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            printf("[RawImageCache] Failed to write %s\n", tempPath.c_str());
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        // 旧缓存仍被映射（Windows）等情况：保留旧文件，下次再试
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
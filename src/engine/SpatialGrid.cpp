@@ -0,0 +1,163 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize > 0.0f ? cellSize : 512.0f)
+{
+    // 构造函数
+}
+
+SpatialGrid::~SpatialGrid()
+{
+    // 析构函数
+}
+
+void SpatialGrid::clear()
+{
+    entries.clear();
+    cells.clear();
+    stamps.clear();
+    count = 0;
+}
+
+void SpatialGrid::setCellSize(float size)
+{
+    clear();
+    cellSize = size > 0.0f ? size : 512.0f;
+}
+
+int SpatialGrid::toCell(float v) const
+{
+    return static_cast<int>(std::floor(v / cellSize));
+}
+
+void SpatialGrid::link(std::uint32_t id, const Entry& entry)
+{
+    for (int y = entry.minY; y <= entry.maxY; ++y) {
+        for (int x = entry.minX; x <= entry.maxX; ++x) {
+            cells[cellKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(std::uint32_t id, const Entry& entry)
+{
+    for (int y = entry.minY; y <= entry.maxY; ++y) {
+        for (int x = entry.minX; x <= entry.maxX; ++x) {
+            auto it = cells.find(cellKey(x, y));
+            if (it == cells.end()) {
+                continue;
+            }
+            auto& list = it->second;
+            auto pos = std::find(list.begin(), list.end(), id);
+            if (pos != list.end()) {
+                // 格子内顺序无关，用尾元素覆盖后弹出
+                *pos = list.back();
+                list.pop_back();
+            }
+            if (list.empty()) {
+                cells.erase(it);
+            }
+        }
+    }
+}
+
+void SpatialGrid::insert(std::uint32_t id, const sf::FloatRect& bounds)
+{
+    if (id >= entries.size()) {
+        entries.resize(static_cast<std::size_t>(id) + 1);
+        stamps.resize(entries.size(), 0);
+    }
+    if (entries[id].active) {
+        update(id, bounds);
+        return;
+    }
+    Entry& entry = entries[id];
+    entry.bounds = bounds;
+    entry.minX = toCell(bounds.position.x);
+    entry.minY = toCell(bounds.position.y);
+    entry.maxX = toCell(bounds.position.x + bounds.size.x);
+    entry.maxY = toCell(bounds.position.y + bounds.size.y);
+    entry.active = true;
+    link(id, entry);
+    ++count;
+}
+
+void SpatialGrid::update(std::uint32_t id, const sf::FloatRect& bounds)
+{
+    if (id >= entries.size() || !entries[id].active) {
+        insert(id, bounds);
+        return;
+    }
+    Entry& entry = entries[id];
+    int minX = toCell(bounds.position.x);
+    int minY = toCell(bounds.position.y);
+    int maxX = toCell(bounds.position.x + bounds.size.x);
+    int maxY = toCell(bounds.position.y + bounds.size.y);
+    entry.bounds = bounds;
+    if (minX == entry.minX && minY == entry.minY && maxX == entry.maxX && maxY == entry.maxY) {
+        // 仍在原来的格子里，只需更新矩形
+        return;
+    }
+    unlink(id, entry);
+    entry.minX = minX;
+    entry.minY = minY;
+    entry.maxX = maxX;
+    entry.maxY = maxY;
+    link(id, entry);
+}
+
+void SpatialGrid::remove(std::uint32_t id)
+{
+    if (id >= entries.size() || !entries[id].active) {
+        return;
+    }
+    unlink(id, entries[id]);
+    entries[id].active = false;
+    --count;
+}
+
+bool SpatialGrid::contains(std::uint32_t id) const
+{
+    return id < entries.size() && entries[id].active;
+}
+
+void SpatialGrid::query(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const
+{
+    // 时间戳回绕时重置，保证去重正确
+    if (++queryStamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        queryStamp = 1;
+    }
+    std::size_t first = out.size();
+
+    float areaRight  = area.position.x + area.size.x;
+    float areaBottom = area.position.y + area.size.y;
+    int minX = toCell(area.position.x);
+    int minY = toCell(area.position.y);
+    int maxX = toCell(areaRight);
+    int maxY = toCell(areaBottom);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            auto it = cells.find(cellKey(x, y));
+            if (it == cells.end()) {
+                continue;
+            }
+            for (std::uint32_t id : it->second) {
+                if (stamps[id] == queryStamp) {
+                    continue;
+                }
+                stamps[id] = queryStamp;
+                // 格子只是粗筛，再做一次精确的AABB相交判断
+                const sf::FloatRect& b = entries[id].bounds;
+                if (b.position.x < areaRight && b.position.x + b.size.x > area.position.x &&
+                    b.position.y < areaBottom && b.position.y + b.size.y > area.position.y) {
+                    out.push_back(id);
+                }
+            }
+        }
+    }
+    // 按id排序，保证每帧的绘制顺序稳定
+    std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end());
+}
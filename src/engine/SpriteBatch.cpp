@@ -0,0 +1,131 @@
+#include "SpriteBatch.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpriteBatch::SpriteBatch()
+{
+    // 构造函数
+}
+
+SpriteBatch::~SpriteBatch()
+{
+    // 析构函数
+}
+
+void SpriteBatch::setPtrs(const std::weak_ptr<EventSys>& eventSys,
+                          const std::weak_ptr<sf::RenderWindow>& window)
+{
+    eventSysPtr = eventSys;
+    windowPtr = window;
+}
+
+void SpriteBatch::submit(EventSys::ImmEventPriority layer, const sf::Sprite& sprite, bool dirty)
+{
+    std::size_t layerIndex = static_cast<std::size_t>(layer);
+    if (layerIndex >= LayerCount) {
+        return;
+    }
+    Layer& target = layers[layerIndex];
+
+    // 查找该纹理的批次（同一图层通常只有少数几张纹理，线性查找即可）
+    const sf::Texture* texture = &sprite.getTexture();
+    Batch* batch = nullptr;
+    for (Batch& b : target.batches) {
+        if (b.texture == texture) {
+            batch = &b;
+            break;
+        }
+    }
+    if (!batch) {
+        target.batches.emplace_back();
+        batch = &target.batches.back();
+        batch->texture = texture;
+    }
+    batch->sprites.push_back(&sprite);
+    batch->dirty.push_back(dirty ? 1 : 0);
+
+    // 每帧每个图层只注册一次绘制事件
+    if (!target.flushRegistered) {
+        auto eventSys = eventSysPtr.lock();
+        if (!eventSys) {
+            batch->sprites.pop_back();
+            batch->dirty.pop_back();
+            return;
+        }
+        target.flushRegistered = true;
+        std::weak_ptr<SpriteBatch> self = weak_from_this();
+        eventSys->regImmEvent(layer, [self, layerIndex]() {
+            if (auto batcher = self.lock()) {
+                batcher->flush(layerIndex);
+            }
+        });
+    }
+}
+
+void SpriteBatch::appendQuad(sf::Vertex* out, const sf::Sprite& sprite)
+{
+    // 与sf::Sprite内部的顶点布局一致：局部坐标为纹理矩形的绝对尺寸，
+    // 翻转与缩放全部由精灵的变换矩阵完成
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color color = sprite.getColor();
+
+    float width  = std::fabs(static_cast<float>(rect.size.x));
+    float height = std::fabs(static_cast<float>(rect.size.y));
+
+    float left   = static_cast<float>(rect.position.x);
+    float top    = static_cast<float>(rect.position.y);
+    float right  = left + static_cast<float>(rect.size.x);
+    float bottom = top + static_cast<float>(rect.size.y);
+
+    sf::Vertex topLeft{transform.transformPoint({0.0f, 0.0f}), color, {left, top}};
+    sf::Vertex bottomLeft{transform.transformPoint({0.0f, height}), color, {left, bottom}};
+    sf::Vertex topRight{transform.transformPoint({width, 0.0f}), color, {right, top}};
+    sf::Vertex bottomRight{transform.transformPoint({width, height}), color, {right, bottom}};
+
+    out[0] = topLeft;
+    out[1] = bottomLeft;
+    out[2] = topRight;
+    out[3] = topRight;
+    out[4] = bottomLeft;
+    out[5] = bottomRight;
+}
+
+void SpriteBatch::flush(std::size_t layerIndex)
+{
+    Layer& layer = layers[layerIndex];
+    layer.flushRegistered = false;
+
+    auto window = windowPtr.lock();
+    auto cache = textureCachePtr.lock();
+    for (Batch& batch : layer.batches) {
+        if (batch.sprites.empty()) {
+            batch.lastSprites.clear();
+            continue;
+        }
+        if (window) {
+            // 每个精灵两个三角形共6个顶点
+            // 同一位置上一帧是同一个精灵且它没有变化时，顶点数组中的数据仍然有效
+            std::size_t reusable = std::min(batch.lastSprites.size(), batch.sprites.size());
+            batch.vertices.resize(batch.sprites.size() * 6);
+            for (std::size_t i = 0; i < batch.sprites.size(); ++i) {
+                if (i < reusable && !batch.dirty[i] && batch.lastSprites[i] == batch.sprites[i]) {
+                    ++reusedQuads;
+                    continue;
+                }
+                appendQuad(&batch.vertices[i * 6], *batch.sprites[i]);
+                ++rebuiltQuads;
+            }
+            if (cache) {
+                cache->touch(batch.texture);
+            }
+            window->draw(batch.vertices, sf::RenderStates(batch.texture));
+            batch.lastSprites.swap(batch.sprites);
+        } else {
+            batch.lastSprites.clear();
+        }
+        // 清空本帧提交（保留容量供下一帧复用）
+        batch.sprites.clear();
+        batch.dirty.clear();
+    }
+}
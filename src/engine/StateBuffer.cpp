@@ -0,0 +1,68 @@
+#include "StateBuffer.hpp"
+
+SnapshotRing::SnapshotRing(std::size_t slotCount, std::size_t slotCapacity)
+{
+    reset(slotCount, slotCapacity);
+}
+
+void SnapshotRing::reset(std::size_t slotCount, std::size_t slotCapacity)
+{
+    capacity = slotCapacity;
+    storage.assign(slotCount * slotCapacity, 0);
+    lengths.assign(slotCount, 0);
+    head = 0;
+    count = 0;
+}
+
+void SnapshotRing::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+StateWriter SnapshotRing::beginWrite()
+{
+    if (lengths.empty()) {
+        return StateWriter(nullptr, 0);
+    }
+    return StateWriter(storage.data() + head * capacity, capacity);
+}
+
+bool SnapshotRing::commit(const StateWriter& writer)
+{
+    if (lengths.empty() || !writer.ok()) {
+        return false;
+    }
+    lengths[head] = writer.size();
+    head = (head + 1) % lengths.size();
+    if (count < lengths.size()) {
+        ++count;
+    }
+    return true;
+}
+
+std::size_t SnapshotRing::slotIndex(std::size_t back) const
+{
+    std::size_t slots = lengths.size();
+    return (head + slots - 1 - back) % slots;
+}
+
+bool SnapshotRing::peek(std::size_t back, StateReader& out) const
+{
+    if (back >= count) {
+        return false;
+    }
+    std::size_t index = slotIndex(back);
+    out = StateReader(storage.data() + index * capacity, lengths[index]);
+    return true;
+}
+
+bool SnapshotRing::pop(StateReader& out)
+{
+    if (!peek(0, out)) {
+        return false;
+    }
+    head = slotIndex(0);
+    --count;
+    return true;
+}
@@ -0,0 +1,173 @@
+#include "StaticBodyMerger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 坐标比较的容差（关卡坐标为像素）
+    const float mergeEpsilon = 0.01f;
+
+    // 边界坐标量化后再比较，排序与合并使用同一标准
+    long long quantize(float value)
+    {
+        return std::llround(value / mergeEpsilon);
+    }
+}
+
+StaticBodyMerger::StaticBodyMerger()
+{
+    // 构造函数
+}
+
+StaticBodyMerger::~StaticBodyMerger()
+{
+    // 析构函数：合并实体随物理世界一起销毁，这里不再访问Box2D
+}
+
+void StaticBodyMerger::addTile(std::uint32_t tileId, std::uint32_t group, const Tile& tile)
+{
+    removeTile(tileId);
+    Group& target = groups[group];
+    target.tiles[tileId] = tile;
+    tileGroups[tileId] = group;
+    if (!target.dirty) {
+        target.dirty = true;
+        dirtyGroups.push_back(group);
+    }
+    ++stats.tiles;
+}
+
+void StaticBodyMerger::removeTile(std::uint32_t tileId)
+{
+    auto it = tileGroups.find(tileId);
+    if (it == tileGroups.end()) {
+        return;
+    }
+    Group& group = groups[it->second];
+    group.tiles.erase(tileId);
+    if (!group.dirty) {
+        group.dirty = true;
+        dirtyGroups.push_back(it->second);
+    }
+    tileGroups.erase(it);
+    --stats.tiles;
+}
+
+void StaticBodyMerger::rebuildDirty()
+{
+    if (dirtyGroups.empty()) {
+        return;
+    }
+    for (std::uint32_t index : dirtyGroups) {
+        auto it = groups.find(index);
+        if (it == groups.end()) {
+            continue;
+        }
+        rebuildGroup(it->second);
+        if (it->second.tiles.empty()) {
+            groups.erase(it);
+        }
+    }
+    dirtyGroups.clear();
+}
+
+void StaticBodyMerger::clear()
+{
+    for (auto& [index, group] : groups) {
+        if (b2Body_IsValid(group.body)) {
+            b2DestroyBody(group.body);
+        }
+    }
+    groups.clear();
+    tileGroups.clear();
+    dirtyGroups.clear();
+    stats = Stats{};
+}
+
+void StaticBodyMerger::rebuildGroup(Group& group)
+{
+    group.dirty = false;
+    if (b2Body_IsValid(group.body)) {
+        b2DestroyBody(group.body);
+        --stats.bodies;
+    }
+    group.body = b2_nullBodyId;
+    stats.shapes -= group.shapes;
+    group.shapes = 0;
+    if (group.tiles.empty() || !b2World_IsValid(world)) {
+        return;
+    }
+
+    std::vector<Tile> tiles;
+    tiles.reserve(group.tiles.size());
+    for (const auto& [id, tile] : group.tiles) {
+        tiles.push_back(tile);
+    }
+    std::vector<Tile> merged = mergeTiles(std::move(tiles));
+
+    // 实体放在原点，每个合并矩形作为一个偏移盒子
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = b2_staticBody;
+    group.body = b2CreateBody(world, &bodyDef);
+    ++stats.bodies;
+    for (const Tile& tile : merged) {
+        float halfW = (tile.right - tile.left) * 0.5f;
+        float halfH = (tile.bottom - tile.top) * 0.5f;
+        b2Vec2 center = { tile.left + halfW, tile.top + halfH };
+        b2Polygon box = b2MakeOffsetBox(halfW, halfH, center, b2Rot_identity);
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        shapeDef.material.userMaterialId = tile.material;
+        b2CreatePolygonShape(group.body, &shapeDef, &box);
+    }
+    group.shapes = merged.size();
+    stats.shapes += group.shapes;
+}
+
+std::vector<StaticBodyMerger::Tile> StaticBodyMerger::mergeTiles(std::vector<Tile> tiles)
+{
+    if (tiles.size() < 2) {
+        return tiles;
+    }
+
+    // 1) 横向：同材质、同上下边的矩形按左边排序，首尾相接（或重叠）的合并
+    std::sort(tiles.begin(), tiles.end(), [](const Tile& a, const Tile& b) {
+        if (a.material != b.material) return a.material < b.material;
+        if (quantize(a.top) != quantize(b.top)) return quantize(a.top) < quantize(b.top);
+        if (quantize(a.bottom) != quantize(b.bottom)) return quantize(a.bottom) < quantize(b.bottom);
+        return a.left < b.left;
+    });
+    std::vector<Tile> rows;
+    rows.reserve(tiles.size());
+    for (const Tile& tile : tiles) {
+        if (!rows.empty()) {
+            Tile& last = rows.back();
+            if (last.material == tile.material && quantize(last.top) == quantize(tile.top) &&
+                quantize(last.bottom) == quantize(tile.bottom) && tile.left <= last.right + mergeEpsilon) {
+                last.right = std::max(last.right, tile.right);
+                continue;
+            }
+        }
+        rows.push_back(tile);
+    }
+
+    // 2) 纵向：同材质、同左右边的横条按上边排序，上下相接的合并
+    std::sort(rows.begin(), rows.end(), [](const Tile& a, const Tile& b) {
+        if (a.material != b.material) return a.material < b.material;
+        if (quantize(a.left) != quantize(b.left)) return quantize(a.left) < quantize(b.left);
+        if (quantize(a.right) != quantize(b.right)) return quantize(a.right) < quantize(b.right);
+        return a.top < b.top;
+    });
+    std::vector<Tile> merged;
+    merged.reserve(rows.size());
+    for (const Tile& row : rows) {
+        if (!merged.empty()) {
+            Tile& last = merged.back();
+            if (last.material == row.material && quantize(last.left) == quantize(row.left) &&
+                quantize(last.right) == quantize(row.right) && row.top <= last.bottom + mergeEpsilon) {
+                last.bottom = std::max(last.bottom, row.bottom);
+                continue;
+            }
+        }
+        merged.push_back(row);
+    }
+    return merged;
+}
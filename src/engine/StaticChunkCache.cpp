@@ -0,0 +1,229 @@
+#include "StaticChunkCache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+StaticChunkCache::StaticChunkCache(unsigned chunkSize)
+    : chunkSize(chunkSize > 0 ? chunkSize : 1024)
+{
+    // 构造函数
+}
+
+StaticChunkCache::~StaticChunkCache()
+{
+    // 析构函数
+}
+
+void StaticChunkCache::setPtrs(const std::weak_ptr<EventSys>& eventSys,
+                               const std::weak_ptr<sf::RenderWindow>& window)
+{
+    eventSysPtr = eventSys;
+    windowPtr = window;
+}
+
+void StaticChunkCache::setChunkSize(unsigned size)
+{
+    clear();
+    chunkSize = size > 0 ? size : 1024;
+}
+
+void StaticChunkCache::clear()
+{
+    members.clear();
+    chunks.clear();
+    chunkIndex.clear();
+    visibleByLayer.clear();
+    drawnChunks = 0;
+}
+
+void StaticChunkCache::add(std::uint32_t id, EventSys::ImmEventPriority layer, const sf::Sprite* sprite)
+{
+    if (!sprite || members.count(id)) {
+        return;
+    }
+    Member& member = members[id];
+    member.layer = layer;
+    member.sprite = sprite;
+    member.bounds = sprite->getGlobalBounds();
+
+    // 把精灵分配到覆盖的区块
+    float size = static_cast<float>(chunkSize);
+    const sf::FloatRect& b = member.bounds;
+    int minX = static_cast<int>(std::floor(b.position.x / size));
+    int minY = static_cast<int>(std::floor(b.position.y / size));
+    // 右/下边界恰好落在区块边上时不算进下一个区块
+    int maxX = static_cast<int>(std::ceil((b.position.x + b.size.x) / size)) - 1;
+    int maxY = static_cast<int>(std::ceil((b.position.y + b.size.y) / size)) - 1;
+    maxX = std::max(maxX, minX);
+    maxY = std::max(maxY, minY);
+    for (int y = minY; y <= maxY; ++y) {
+        for (int x = minX; x <= maxX; ++x) {
+            ChunkKey key{static_cast<int>(layer), x, y};
+            auto it = chunkIndex.find(key);
+            std::size_t index;
+            if (it == chunkIndex.end()) {
+                index = chunks.size();
+                chunkIndex.emplace(key, index);
+                chunks.emplace_back();
+                chunks.back().layer = layer;
+                chunks.back().coord = {x, y};
+            } else {
+                index = it->second;
+            }
+            Chunk& chunk = chunks[index];
+            // 区块内按id顺序绘制，与逐个绘制时的顺序一致
+            chunk.members.insert(std::upper_bound(chunk.members.begin(), chunk.members.end(), id), id);
+            ++chunk.aliveCount;
+            chunk.dirty = true;
+            member.chunks.push_back(index);
+        }
+    }
+}
+
+sf::FloatRect StaticChunkCache::chunkRect(const Chunk& chunk) const
+{
+    float size = static_cast<float>(chunkSize);
+    return sf::FloatRect({chunk.coord.x * size, chunk.coord.y * size}, {size, size});
+}
+
+bool StaticChunkCache::bake()
+{
+    std::size_t rebuilt = 0;
+    for (Chunk& chunk : chunks) {
+        if (!chunk.dirty) {
+            continue;
+        }
+        if (!rebakeChunk(chunk)) {
+            return false;
+        }
+        ++rebuilt;
+    }
+    printf("[StaticChunkCache] Baked %zu sprite(s), rebuilt %zu of %zu chunk(s).\n",
+           members.size(), rebuilt, chunks.size());
+    return true;
+}
+
+bool StaticChunkCache::rebakeChunk(Chunk& chunk)
+{
+    chunk.dirty = false;
+    if (chunk.aliveCount == 0) {
+        // 区块内已经没有精灵，释放显存
+        chunk.target.reset();
+        return true;
+    }
+    if (!chunk.target) {
+        chunk.target = std::make_unique<sf::RenderTexture>();
+        if (!chunk.target->resize({chunkSize, chunkSize})) {
+            printf("[StaticChunkCache] ERROR: failed to create %ux%u render texture.\n", chunkSize, chunkSize);
+            chunk.target.reset();
+            return false;
+        }
+    }
+    // 区块的视图对准它覆盖的世界区域，精灵按世界坐标直接绘制
+    chunk.target->clear(sf::Color::Transparent);
+    chunk.target->setView(sf::View(chunkRect(chunk)));
+    auto cache = textureCachePtr.lock();
+    for (std::uint32_t id : chunk.members) {
+        const Member& member = members[id];
+        if (member.alive && member.sprite) {
+            if (cache) {
+                cache->touch(&member.sprite->getTexture());
+            }
+            chunk.target->draw(*member.sprite);
+        }
+    }
+    chunk.target->display();
+    return true;
+}
+
+void StaticChunkCache::invalidate(std::uint32_t id)
+{
+    auto it = members.find(id);
+    if (it == members.end() || !it->second.alive) {
+        return;
+    }
+    Member& member = it->second;
+    member.alive = false;
+    // 对象即将销毁，不再持有它的精灵指针
+    member.sprite = nullptr;
+    for (std::size_t index : member.chunks) {
+        --chunks[index].aliveCount;
+        chunks[index].dirty = true;
+    }
+}
+
+void StaticChunkCache::remove(std::uint32_t id)
+{
+    auto it = members.find(id);
+    if (it == members.end()) {
+        return;
+    }
+    for (std::size_t index : it->second.chunks) {
+        Chunk& chunk = chunks[index];
+        auto pos = std::lower_bound(chunk.members.begin(), chunk.members.end(), id);
+        if (pos != chunk.members.end() && *pos == id) {
+            chunk.members.erase(pos);
+        }
+        if (it->second.alive) {
+            --chunk.aliveCount;
+        }
+        chunk.dirty = true;
+    }
+    members.erase(it);
+}
+
+void StaticChunkCache::draw(const sf::FloatRect& viewRect)
+{
+    drawnChunks = 0;
+    for (auto& entry : visibleByLayer) {
+        entry.second.clear();
+    }
+
+    float viewRight  = viewRect.position.x + viewRect.size.x;
+    float viewBottom = viewRect.position.y + viewRect.size.y;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        sf::FloatRect rect = chunkRect(chunk);
+        if (rect.position.x >= viewRight || rect.position.x + rect.size.x <= viewRect.position.x ||
+            rect.position.y >= viewBottom || rect.position.y + rect.size.y <= viewRect.position.y) {
+            continue;
+        }
+        // 只重建即将绘制的脏区块，视野外的等进入视野时再重建
+        if (chunk.dirty && !rebakeChunk(chunk)) {
+            continue;
+        }
+        if (!chunk.target) {
+            continue;
+        }
+        visibleByLayer[static_cast<int>(chunk.layer)].push_back(i);
+        ++drawnChunks;
+    }
+
+    auto eventSys = eventSysPtr.lock();
+    if (!eventSys) {
+        return;
+    }
+    std::weak_ptr<StaticChunkCache> self = weak_from_this();
+    for (auto& entry : visibleByLayer) {
+        if (entry.second.empty()) {
+            continue;
+        }
+        int layer = entry.first;
+        eventSys->regImmEvent(static_cast<EventSys::ImmEventPriority>(layer), [self, layer]() {
+            auto cache = self.lock();
+            if (!cache) {
+                return;
+            }
+            auto window = cache->windowPtr.lock();
+            if (!window) {
+                return;
+            }
+            for (std::size_t index : cache->visibleByLayer[layer]) {
+                const Chunk& chunk = cache->chunks[index];
+                sf::Sprite sprite(chunk.target->getTexture());
+                sprite.setPosition(cache->chunkRect(chunk).position);
+                window->draw(sprite);
+            }
+        });
+    }
+}
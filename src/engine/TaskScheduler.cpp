@@ -0,0 +1,155 @@
+#include "TaskScheduler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+TaskScheduler::TaskScheduler(int workerCount)
+{
+    // 构造函数：创建workerCount-1个工作线程（调用线程为0号）
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->workerCount = std::max(1, workerCount);
+    for (int i = 0; i < this->workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 1; i < this->workerCount; ++i) {
+        threads.emplace_back(&TaskScheduler::workerLoop, this, static_cast<std::uint32_t>(i));
+    }
+    printf("[TaskScheduler] %d workers\n", this->workerCount);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    // 析构函数：唤醒并等待全部工作线程退出
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping.store(true);
+    }
+    wakeUp.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TaskScheduler::Task* TaskScheduler::submit(RangeFunc func, int itemCount, int minRange, void* context)
+{
+    if (itemCount <= 0) {
+        return nullptr;
+    }
+    minRange = std::max(1, minRange);
+    if (workerCount == 1 || itemCount <= minRange) {
+        func(0, itemCount, 0, context);
+        return nullptr;
+    }
+
+    // 区段数为线程数的两倍左右，给窃取留出平衡负载的余地
+    int rangeSize = std::max(minRange, (itemCount + workerCount * 2 - 1) / (workerCount * 2));
+    int rangeCount = (itemCount + rangeSize - 1) / rangeSize;
+
+    Task* task = acquireTask();
+    task->func = func;
+    task->context = context;
+    task->remaining.store(rangeCount, std::memory_order_relaxed);
+
+    for (int begin = 0; begin < itemCount; begin += rangeSize) {
+        WorkItem item{ task, begin, std::min(itemCount, begin + rangeSize) };
+        WorkerQueue& queue = *queues[nextQueue];
+        nextQueue = (nextQueue + 1) % static_cast<std::uint32_t>(workerCount);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(item);
+    }
+    pendingItems.fetch_add(rangeCount);
+    // 先经过一次sleepMutex再通知，避免工作线程检查完条件、尚未进入等待时丢失唤醒
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeUp.notify_all();
+    return task;
+}
+
+void TaskScheduler::wait(Task* task)
+{
+    if (!task) {
+        return;
+    }
+    while (task->remaining.load(std::memory_order_acquire) > 0) {
+        if (!runOne(0)) {
+            std::this_thread::yield();
+        }
+    }
+    releaseTask(task);
+}
+
+void* TaskScheduler::enqueueBox2DTask(RangeFunc task, int itemCount, int minRange, void* taskContext, void* userContext)
+{
+    return static_cast<TaskScheduler*>(userContext)->submit(task, itemCount, minRange, taskContext);
+}
+
+void TaskScheduler::finishBox2DTask(void* userTask, void* userContext)
+{
+    static_cast<TaskScheduler*>(userContext)->wait(static_cast<Task*>(userTask));
+}
+
+bool TaskScheduler::runOne(std::uint32_t worker)
+{
+    if (pendingItems.load(std::memory_order_acquire) <= 0) {
+        return false;
+    }
+    WorkItem item{ nullptr, 0, 0 };
+    // 自己的队列从尾部取（刚放入、缓存较热），其它队列从头部窃取
+    for (int offset = 0; offset < workerCount && !item.task; ++offset) {
+        WorkerQueue& queue = *queues[(worker + offset) % workerCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.items.empty()) {
+            continue;
+        }
+        if (offset == 0) {
+            item = queue.items.back();
+            queue.items.pop_back();
+        } else {
+            item = queue.items.front();
+            queue.items.pop_front();
+        }
+    }
+    if (!item.task) {
+        return false;
+    }
+    pendingItems.fetch_sub(1);
+    item.task->func(item.begin, item.end, worker, item.task->context);
+    item.task->remaining.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void TaskScheduler::workerLoop(std::uint32_t worker)
+{
+    while (!stopping.load()) {
+        if (runOne(worker)) {
+            continue;
+        }
+        // 物理步进中各阶段的任务间隔很短，先短暂让出再休眠
+        for (int spin = 0; spin < 64 && pendingItems.load() <= 0 && !stopping.load(); ++spin) {
+            std::this_thread::yield();
+        }
+        if (pendingItems.load() > 0) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping.load() || pendingItems.load() > 0; });
+    }
+}
+
+TaskScheduler::Task* TaskScheduler::acquireTask()
+{
+    std::lock_guard<std::mutex> lock(taskMutex);
+    if (freeTasks.empty()) {
+        taskPool.push_back(std::make_unique<Task>());
+        return taskPool.back().get();
+    }
+    Task* task = freeTasks.back();
+    freeTasks.pop_back();
+    return task;
+}
+
+void TaskScheduler::releaseTask(Task* task)
+{
+    std::lock_guard<std::mutex> lock(taskMutex);
+    freeTasks.push_back(task);
+}
@@ -0,0 +1,239 @@
+#include "TextureAtlas.hpp"
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cstdio>
+
+TextureAtlas::TextureAtlas(unsigned pageSize, unsigned padding)
+    : pageSize(pageSize), padding(padding)
+{
+    // 单页尺寸不能超过显卡支持的最大纹理尺寸
+    unsigned maxSize = sf::Texture::getMaximumSize();
+    if (maxSize > 0 && this->pageSize > maxSize) {
+        this->pageSize = maxSize;
+    }
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    // 析构函数
+}
+
+bool TextureAtlas::accepts(sf::Vector2u size) const
+{
+    // 只打包不超过半页的纹理，超大的纹理单独加载
+    unsigned limit = pageSize / 2;
+    return size.x > 0 && size.y > 0 &&
+           size.x + padding * 2 <= limit &&
+           size.y + padding * 2 <= limit;
+}
+
+bool TextureAtlas::addFile(const std::string& path)
+{
+    if (built || pathIndex.count(path)) {
+        return pathIndex.count(path) > 0;
+    }
+    sf::Image image;
+    if (!AssetVfs::load(image, path)) {
+        printf("[TextureAtlas] Failed to load image: %s\n", path.c_str());
+        return false;
+    }
+    addImage(path, image);
+    return true;
+}
+
+void TextureAtlas::addImage(const std::string& path, const sf::Image& image)
+{
+    if (built || pathIndex.count(path)) {
+        return;
+    }
+    if (!accepts(image.getSize())) {
+        // 过大的图片不进图集，由对象自己加载
+        printf("[TextureAtlas] Skip large image %s (%ux%u)\n",
+               path.c_str(), image.getSize().x, image.getSize().y);
+        return;
+    }
+    pathIndex[path] = pending.size();
+    pending.push_back({path, image, Region{}});
+}
+
+bool TextureAtlas::findPosition(const PageBuilder& page, int w, int h,
+                                int& outX, int& outY, std::size_t& outNode) const
+{
+    int bestTop = -1;
+    int bestWidth = 0;
+    for (std::size_t i = 0; i < page.skyline.size(); ++i) {
+        int x = page.skyline[i].x;
+        if (x + w > static_cast<int>(pageSize)) {
+            break;
+        }
+        // 矩形覆盖的所有节点中的最高点即为可放置的y
+        int y = 0;
+        int widthLeft = w;
+        std::size_t j = i;
+        while (widthLeft > 0 && j < page.skyline.size()) {
+            y = std::max(y, page.skyline[j].y);
+            widthLeft -= page.skyline[j].width;
+            ++j;
+        }
+        if (widthLeft > 0 || y + h > static_cast<int>(pageSize)) {
+            continue;
+        }
+        // 优先放在更低的位置，高度相同时选择更窄的节点以减少浪费
+        int top = y + h;
+        if (bestTop < 0 || top < bestTop ||
+            (top == bestTop && page.skyline[i].width < bestWidth)) {
+            bestTop = top;
+            bestWidth = page.skyline[i].width;
+            outX = x;
+            outY = y;
+            outNode = i;
+        }
+    }
+    return bestTop >= 0;
+}
+
+void TextureAtlas::placeRect(PageBuilder& page, std::size_t node, int x, int y, int w, int h)
+{
+    // 插入新的天际线节点
+    page.skyline.insert(page.skyline.begin() + static_cast<std::ptrdiff_t>(node), SkylineNode{x, y + h, w});
+
+    // 收缩或删除被新节点覆盖的后续节点
+    for (std::size_t i = node + 1; i < page.skyline.size();) {
+        SkylineNode& prev = page.skyline[i - 1];
+        SkylineNode& cur = page.skyline[i];
+        int overlap = prev.x + prev.width - cur.x;
+        if (overlap <= 0) {
+            break;
+        }
+        cur.x += overlap;
+        cur.width -= overlap;
+        if (cur.width <= 0) {
+            page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            break;
+        }
+    }
+
+    // 合并高度相同的相邻节点
+    for (std::size_t i = 0; i + 1 < page.skyline.size();) {
+        if (page.skyline[i].y == page.skyline[i + 1].y) {
+            page.skyline[i].width += page.skyline[i + 1].width;
+            page.skyline.erase(page.skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+    page.usedHeight = std::max(page.usedHeight, y + h);
+}
+
+void TextureAtlas::blitWithExtrude(sf::Image& pageImage, const sf::Image& src, sf::Vector2u dest) const
+{
+    sf::Vector2u size = src.getSize();
+    // 主体
+    (void)pageImage.copy(src, dest);
+    if (padding == 0) {
+        return;
+    }
+    // 四条边各向外复制一像素
+    (void)pageImage.copy(src, {dest.x, dest.y - 1}, sf::IntRect({0, 0}, {static_cast<int>(size.x), 1}));
+    (void)pageImage.copy(src, {dest.x, dest.y + size.y},
+                         sf::IntRect({0, static_cast<int>(size.y) - 1}, {static_cast<int>(size.x), 1}));
+    (void)pageImage.copy(src, {dest.x - 1, dest.y}, sf::IntRect({0, 0}, {1, static_cast<int>(size.y)}));
+    (void)pageImage.copy(src, {dest.x + size.x, dest.y},
+                         sf::IntRect({static_cast<int>(size.x) - 1, 0}, {1, static_cast<int>(size.y)}));
+}
+
+void TextureAtlas::build()
+{
+    if (built) {
+        return;
+    }
+    built = true;
+
+    // 按高度从大到小排序后依次放置，天际线算法在这种顺序下利用率最高
+    std::vector<std::size_t> order(pending.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        auto sa = pending[a].image.getSize();
+        auto sb = pending[b].image.getSize();
+        return sa.y != sb.y ? sa.y > sb.y : sa.x > sb.x;
+    });
+
+    std::vector<PageBuilder> builders;
+    for (std::size_t idx : order) {
+        PendingImage& img = pending[idx];
+        int w = static_cast<int>(img.image.getSize().x + padding * 2);
+        int h = static_cast<int>(img.image.getSize().y + padding * 2);
+
+        bool placed = false;
+        for (std::size_t p = 0; p < builders.size() && !placed; ++p) {
+            int x = 0, y = 0;
+            std::size_t node = 0;
+            if (findPosition(builders[p], w, h, x, y, node)) {
+                placeRect(builders[p], node, x, y, w, h);
+                img.region.page = static_cast<int>(p);
+                img.region.rect = sf::IntRect({x + static_cast<int>(padding), y + static_cast<int>(padding)},
+                                              {w - static_cast<int>(padding * 2), h - static_cast<int>(padding * 2)});
+                builders[p].members.push_back(idx);
+                placed = true;
+            }
+        }
+        if (!placed) {
+            // 现有页放不下，开新的一页
+            PageBuilder page;
+            page.skyline.push_back({0, 0, static_cast<int>(pageSize)});
+            int x = 0, y = 0;
+            std::size_t node = 0;
+            if (findPosition(page, w, h, x, y, node)) {
+                placeRect(page, node, x, y, w, h);
+                img.region.page = static_cast<int>(builders.size());
+                img.region.rect = sf::IntRect({x + static_cast<int>(padding), y + static_cast<int>(padding)},
+                                              {w - static_cast<int>(padding * 2), h - static_cast<int>(padding * 2)});
+                page.members.push_back(idx);
+                builders.push_back(std::move(page));
+            }
+        }
+    }
+
+    // 合成每一页的图片并上传GPU（页高度裁剪到实际使用的高度）
+    for (std::size_t p = 0; p < builders.size(); ++p) {
+        unsigned height = static_cast<unsigned>(builders[p].usedHeight);
+        sf::Image pageImage({pageSize, height}, sf::Color::Transparent);
+        for (std::size_t idx : builders[p].members) {
+            const PendingImage& img = pending[idx];
+            blitWithExtrude(pageImage, img.image,
+                            {static_cast<unsigned>(img.region.rect.position.x),
+                             static_cast<unsigned>(img.region.rect.position.y)});
+        }
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(pageImage)) {
+            printf("[TextureAtlas] Failed to upload atlas page %zu\n", p);
+        }
+        pages.push_back(std::move(texture));
+        printf("[TextureAtlas] Page %zu: %ux%u, %zu images\n",
+               p, pageSize, height, builders[p].members.size());
+    }
+
+    // 像素数据已经上传，释放CPU端的图片
+    for (auto& img : pending) {
+        img.image = sf::Image();
+    }
+}
+
+const TextureAtlas::Region* TextureAtlas::find(const std::string& path) const
+{
+    if (!built) {
+        return nullptr;
+    }
+    auto it = pathIndex.find(path);
+    if (it == pathIndex.end() || pending[it->second].region.page < 0) {
+        return nullptr;
+    }
+    return &pending[it->second].region;
+}
+
+const sf::Texture& TextureAtlas::getPage(int page) const
+{
+    return *pages.at(static_cast<std::size_t>(page));
+}
@@ -0,0 +1,319 @@
+#include "TextureCache.hpp"
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+TextureCache::TextureCache()
+{
+    // 构造函数
+}
+
+TextureCache::~TextureCache()
+{
+    // 析构函数
+}
+
+std::size_t TextureCache::textureBytes(const sf::Texture& texture)
+{
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+std::size_t TextureCache::rawBytes(const Entry& entry)
+{
+    if (!entry.raw) {
+        return 0;
+    }
+    sf::Vector2u size = entry.raw->getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4;
+}
+
+TextureCache::Entry* TextureCache::findEntry(const std::string& path)
+{
+    auto it = entries.find(path);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+TextureCache::Entry& TextureCache::createEntry(const std::string& path, bool repeated)
+{
+    Entry& entry = entries[path];
+    entry.path = path;
+    entry.texture = std::make_shared<sf::Texture>();
+    entry.repeated = repeated;
+    byTexture[entry.texture.get()] = &entry;
+    return entry;
+}
+
+void TextureCache::removeEntry(const std::string& path)
+{
+    auto it = entries.find(path);
+    if (it == entries.end()) {
+        return;
+    }
+    Entry& entry = it->second;
+    stats.cpuBytes -= rawBytes(entry);
+    if (entry.resident) {
+        stats.gpuBytes -= textureBytes(*entry.texture);
+        --stats.resident;
+    }
+    byTexture.erase(entry.texture.get());
+    entries.erase(it);
+}
+
+void TextureCache::setRaw(Entry& entry, std::shared_ptr<const RawImageCache::Entry> raw)
+{
+    stats.cpuBytes -= rawBytes(entry);
+    entry.raw = std::move(raw);
+    stats.cpuBytes += rawBytes(entry);
+}
+
+bool TextureCache::load(Entry& entry, const sf::Image* image)
+{
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+    bool ok = false;
+    if (image) {
+        ok = entry.texture->loadFromImage(*image);
+    } else {
+        // 没有CPU副本时先查解码缓存，仍然没有才解码源文件
+        if (!entry.raw && rawCache) {
+            setRaw(entry, rawCache->find(entry.path));
+        }
+        if (entry.raw) {
+            ok = entry.raw->upload(*entry.texture);
+        } else if (rawCache) {
+            sf::Image decoded;
+            ok = rawCache->decode(entry.path, decoded) && entry.texture->loadFromImage(decoded);
+        } else {
+            ok = AssetVfs::load(*entry.texture, entry.path);
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+    entry.texture->setRepeated(entry.repeated);
+    entry.resident = true;
+    entry.queued = false;
+    stats.gpuBytes += textureBytes(*entry.texture);
+    ++stats.resident;
+    if (entry.evicted) {
+        entry.evicted = false;
+        ++stats.reloads;
+        if (profiler) {
+            profiler->event("reload", entry.path, Profiler::elapsedMs(start));
+        }
+    }
+    return true;
+}
+
+void TextureCache::evict(Entry& entry)
+{
+    if (!entry.resident) {
+        return;
+    }
+    stats.gpuBytes -= textureBytes(*entry.texture);
+    --stats.resident;
+    // 只释放显存：对象地址不变，引用它的精灵在重新加载后继续有效
+    *entry.texture = sf::Texture();
+    entry.resident = false;
+    entry.evicted = true;
+    ++stats.evictions;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::acquire(const std::string& path, bool repeated)
+{
+    Entry* entry = findEntry(path);
+    bool created = entry == nullptr;
+    if (created) {
+        entry = &createEntry(path, repeated);
+    }
+    entry->lastUsed = frame;
+    if (!entry->resident && !load(*entry, nullptr)) {
+        printf("[TextureCache] Failed to load texture: %s\n", path.c_str());
+        if (created) {
+            removeEntry(path);
+        }
+        return nullptr;
+    }
+    return entry->texture;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::insert(const std::string& path, const sf::Image& image,
+                                                        bool repeated)
+{
+    Entry* entry = findEntry(path);
+    bool created = entry == nullptr;
+    if (created) {
+        entry = &createEntry(path, repeated);
+    }
+    entry->lastUsed = frame;
+    if (!entry->resident && !load(*entry, &image)) {
+        printf("[TextureCache] Failed to upload texture: %s\n", path.c_str());
+        if (created) {
+            removeEntry(path);
+        }
+        return nullptr;
+    }
+    return entry->texture;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::insert(const std::string& path,
+                                                        std::shared_ptr<const RawImageCache::Entry> raw,
+                                                        bool repeated)
+{
+    Entry* entry = findEntry(path);
+    bool created = entry == nullptr;
+    if (created) {
+        entry = &createEntry(path, repeated);
+    }
+    entry->lastUsed = frame;
+    if (raw && !entry->raw) {
+        setRaw(*entry, std::move(raw));
+    }
+    if (!entry->resident && !load(*entry, nullptr)) {
+        printf("[TextureCache] Failed to upload texture: %s\n", path.c_str());
+        if (created) {
+            removeEntry(path);
+        }
+        return nullptr;
+    }
+    return entry->texture;
+}
+
+void TextureCache::touch(const sf::Texture* texture)
+{
+    auto it = byTexture.find(texture);
+    if (it == byTexture.end()) {
+        return;
+    }
+    Entry& entry = *it->second;
+    entry.lastUsed = frame;
+    if (!entry.resident && !load(entry, nullptr)) {
+        printf("[TextureCache] Failed to reload texture: %s\n", entry.path.c_str());
+    }
+}
+
+void TextureCache::prefetch(const std::string& path)
+{
+    Entry* entry = findEntry(path);
+    if (!entry) {
+        entry = &createEntry(path, false);
+    }
+    if (entry->resident || entry->queued) {
+        return;
+    }
+    entry->queued = true;
+    prefetchQueue.push_back(path);
+}
+
+void TextureCache::update(float budgetMs)
+{
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+    while (!prefetchQueue.empty()) {
+        if (budgetMs > 0.0f && Profiler::elapsedMs(start) >= budgetMs) {
+            break;
+        }
+        std::string path = std::move(prefetchQueue.front());
+        prefetchQueue.pop_front();
+        Entry* entry = findEntry(path);
+        if (!entry || entry->resident) {
+            continue;
+        }
+        entry->queued = false;
+        // 预取的纹理视为本帧用到，不会在这一帧就被驱逐
+        entry->lastUsed = frame;
+        if (load(*entry, nullptr)) {
+            ++stats.prefetches;
+        } else {
+            printf("[TextureCache] Failed to prefetch texture: %s\n", path.c_str());
+            if (entry->texture.use_count() == 1) {
+                removeEntry(path);
+            }
+        }
+    }
+    enforceBudget();
+    stats.textures = entries.size();
+    publishStats();
+    ++frame;
+}
+
+void TextureCache::enforceBudget()
+{
+    // 最近idleFrames帧内用到的纹理正在使用，不参与驱逐
+    auto idle = [this](const Entry& entry) {
+        return entry.lastUsed + budget.idleFrames < frame;
+    };
+    auto oldestFirst = [](const Entry* a, const Entry* b) { return a->lastUsed < b->lastUsed; };
+
+    if (budget.gpuBytes > 0 && stats.gpuBytes > budget.gpuBytes) {
+        std::vector<Entry*> candidates;
+        for (auto& [path, entry] : entries) {
+            if (entry.resident && idle(entry)) {
+                candidates.push_back(&entry);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), oldestFirst);
+        for (Entry* entry : candidates) {
+            if (stats.gpuBytes <= budget.gpuBytes) {
+                break;
+            }
+            evict(*entry);
+        }
+    }
+    if (budget.cpuBytes > 0 && stats.cpuBytes > budget.cpuBytes) {
+        std::vector<Entry*> candidates;
+        for (auto& [path, entry] : entries) {
+            if (entry.raw) {
+                candidates.push_back(&entry);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), oldestFirst);
+        for (Entry* entry : candidates) {
+            if (stats.cpuBytes <= budget.cpuBytes) {
+                break;
+            }
+            setRaw(*entry, nullptr);
+        }
+    }
+    // 被驱逐且已经没有外部引用的条目不会再被绘制，直接删除
+    purge();
+}
+
+void TextureCache::publishStats() const
+{
+    if (!profiler) {
+        return;
+    }
+    profiler->setCounter("Residency.textures", static_cast<double>(entries.size()));
+    profiler->setCounter("Residency.resident", static_cast<double>(stats.resident));
+    profiler->setCounter("Residency.gpuBytes", static_cast<double>(stats.gpuBytes));
+    profiler->setCounter("Residency.cpuBytes", static_cast<double>(stats.cpuBytes));
+    profiler->setCounter("Residency.evictions", static_cast<double>(stats.evictions));
+    profiler->setCounter("Residency.reloads", static_cast<double>(stats.reloads));
+    profiler->setCounter("Residency.prefetches", static_cast<double>(stats.prefetches));
+}
+
+void TextureCache::purge()
+{
+    for (auto it = entries.begin(); it != entries.end();) {
+        Entry& entry = it->second;
+        if (!entry.resident && !entry.queued && entry.texture.use_count() == 1) {
+            stats.cpuBytes -= rawBytes(entry);
+            byTexture.erase(entry.texture.get());
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::size_t TextureCache::size() const
+{
+    std::size_t count = 0;
+    for (const auto& entry : entries) {
+        if (entry.second.texture.use_count() > 1) {
+            ++count;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 单文件资源包（.pak）：把assets/、audio/、config/下的散文件打包成一个文件，运行时整体内存映射，
+// 资源直接从映射内存交给SFML的loadFromMemory/openFromMemory，省去逐个文件的打开与读缓冲拷贝。
+// 数据区按打包顺序（目录内按路径排序）连续排放，同一目录的资源读取时是顺序缺页
+//
+// 文件布局（小端，数据按16字节对齐）：
+//   Header | 文件数据... | Entry[entryCount]（按pathHash排序） | 路径字符串表（以'\0'结尾）
+class AssetPack
+{
+    public:
+        static constexpr std::uint32_t version   = 1;
+        static constexpr std::uint32_t endianTag = 0x01020304u;
+        static constexpr std::uint32_t alignment = 16;
+
+        struct Header
+        {
+            char magic[4];                  // "APAK"
+            std::uint32_t version;
+            std::uint32_t endianTag;
+            std::uint32_t entryCount;
+            std::uint64_t indexOffset;      // Entry数组在文件中的偏移
+            std::uint64_t stringTableOffset;
+            std::uint64_t stringTableSize;
+            std::uint64_t reserved;
+        };
+        struct Entry
+        {
+            std::uint64_t pathHash;         // 规范化路径的FNV-1a
+            std::uint64_t offset;           // 数据在文件中的偏移
+            std::uint64_t size;
+            std::uint32_t path;             // 路径（字符串表偏移）
+            std::uint32_t checksum;         // 数据的FNV-1a（32位），仅verify时校验
+        };
+
+        // 包内一个文件的只读视图，指向映射内存，包关闭前有效
+        struct View
+        {
+            const void* data = nullptr;
+            std::size_t size = 0;
+
+            explicit operator bool() const { return data != nullptr; }
+            std::string_view text() const { return { static_cast<const char*>(data), size }; }
+        };
+
+        AssetPack() = default;
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        // 映射并校验文件头与索引，失败时返回false并打印原因（文件不存在时不打印）
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return file.isOpen(); }
+
+        // 按路径查找（路径会先规范化），找不到返回空视图
+        View find(std::string_view path) const;
+        std::size_t entryCount() const { return isOpen() ? header().entryCount : 0; }
+        std::string_view entryPath(std::size_t index) const;
+        // 重新计算全部数据的校验和，逐个打印不一致的文件，全部一致时返回true
+        bool verify() const;
+
+        // 把files（相对仓库根目录的路径，运行时按同样的路径查找）打包到outPath，出错时打印原因并返回false
+        static bool build(const std::vector<std::string>& files, const std::string& outPath);
+        // 统一路径写法："./assets\\a.png" -> "assets/a.png"
+        static std::string normalize(std::string_view path);
+        static std::uint64_t hashPath(std::string_view normalized);
+        static std::uint32_t checksum(const void* data, std::size_t size);
+
+    private:
+        const Header& header() const { return *reinterpret_cast<const Header*>(file.data()); }
+        const Entry* entries() const
+        {
+            return reinterpret_cast<const Entry*>(file.data() + header().indexOffset);
+        }
+        bool validate(const std::string& path) const;
+
+        MappedFile file;
+};
+
+// 进程内唯一的资源包挂载点。挂载后，资源读取先查包，包中没有（或没有挂载）时退回磁盘上的散文件，
+// 所以开发时不打包也能直接运行。mount/unmount只应在启动和退出时于主线程调用；
+// 挂载期间find只读，可在解码线程中并发使用
+class AssetVfs
+{
+    public:
+        // 挂载资源包；文件不存在时静默返回false，损坏时打印原因并返回false
+        static bool mount(const std::string& packPath);
+        // 卸载后之前取得的View以及用openFromMemory打开的字体、音乐全部失效
+        static void unmount();
+        static bool isMounted();
+        static AssetPack::View find(std::string_view path);
+
+        // 纹理、图片、音效：包中用loadFromMemory直接从映射内存解码，否则loadFromFile
+        template <typename T>
+        static bool load(T& resource, const std::string& path)
+        {
+            if (AssetPack::View view = find(path)) {
+                return resource.loadFromMemory(view.data, view.size);
+            }
+            return resource.loadFromFile(path);
+        }
+        // 字体、音乐（边用边读的流式资源）：包中用openFromMemory引用映射内存，零拷贝，
+        // 资源在使用期间一直读取映射，必须在unmount之前释放
+        template <typename T>
+        static bool open(T& resource, const std::string& path)
+        {
+            if (AssetPack::View view = find(path)) {
+                return resource.openFromMemory(view.data, view.size);
+            }
+            return resource.openFromFile(path);
+        }
+        // 文本（配置、关卡JSON）：包中直接返回映射内存视图，否则把散文件读入storage后返回其视图；
+        // 两者都没有时返回false。preferDisk为true时散文件优先（热重载读取刚在磁盘上编辑过的文件，
+        // 资源包中是打包时的旧内容），没有散文件时才读包中的
+        static bool readText(const std::string& path, std::string& storage, std::string_view& text,
+                             bool preferDisk = false);
+
+    private:
+        static AssetPack& pack();
+};
@@ -72,6 +72,10 @@ public:
     
     // 响应场景事件（如切换场景等）
     void onSceneEvent(const std::string& eventType);
+
+    // 重新读取音频配置（热重载）：只应用改变的音量与音乐映射，
+    // 当前曲目的文件改变时从头播放新文件，不播放default_music
+    void reloadConfig(const std::string& configPath);
     
 private:
     // ========== 私有成员变量 ==========
@@ -1,30 +1,101 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <variant>
+#include <vector>
 #include <string>
-#include <fstream>
+#include <string_view>
 
+// INI配置加载器：一次解析整个文件，节名与键名解析时驻留为整数id，所有值按（节id, 键id）放在一张表里。
+// 按名字查找时先把两个名字换成id，再做一次整数键的查找；反复读取的值可以先用key取得句柄，
+// 之后每次查找只剩一次整数哈希查找。
+// 同一个文件可以通过shared在多个子系统之间共用一个解析结果，不必各自重新读文件。
+// 值的类型在解析时推断（整数、浮点、布尔、字符串、空值），类型化的getter在整数与浮点之间自动转换，
+// 键不存在或类型不符时返回调用方给出的缺省值
 class ConfigLoader
 {
-    // 使用std::variant来存储不同类型的配置值，例如屏幕分辨率int，角色名称string等
-    using ConfigValue = std::variant<std::monostate, bool, int, float, std::string>;
-    // 使用std::unordered_map来存储键值对形式的配置数据
-    using ConfigDict = std::unordered_map<std::string, ConfigValue>;
-
     public:
+        // 使用std::variant来存储不同类型的配置值，例如屏幕分辨率int，角色名称string等
+        using ConfigValue = std::variant<std::monostate, bool, int, float, std::string>;
+        // 使用std::unordered_map来存储键值对形式的配置数据
+        using ConfigDict = std::unordered_map<std::string, ConfigValue>;
+
         ConfigLoader();
         ~ConfigLoader();
+        // 解析整个文件的所有节（替换之前的内容），文件打不开时返回false；
+        // preferDisk为true时磁盘上的散文件优先于已挂载资源包中的同名文件
+        bool load(const std::string& filepath, bool preferDisk = false);
+        // 取得路径对应的共享实例：第一次调用时解析，之后直接返回同一个实例（可跨线程调用）
+        static std::shared_ptr<const ConfigLoader> shared(const std::string& filepath);
+        // 重新解析文件并替换共享实例（热重载，读取磁盘上刚编辑过的散文件）；解析失败时保留原实例并返回nullptr。
+        // 已经取得旧实例的调用方继续持有旧的解析结果，需要时用diff比较
+        static std::shared_ptr<const ConfigLoader> reload(const std::string& filepath);
+        // 与other相比新增、删除或取值改变的（节, 键）
+        std::vector<std::pair<std::string, std::string>> diff(const ConfigLoader& other) const;
+
         // 加载配置文件,需要两个参数：文件路径和节名称
+        // 文件已经解析过时只切换当前节，之后getValue从该节读取
         void loadConfig(const std::string& filepath, const std::string& section);
-        // 根据键获取配置值
+        // 根据键获取当前节的配置值
         ConfigValue getValue(const std::string& key) const;
         // 获取指定节的所有键值对
         ConfigDict getAllValues(const std::string& section) const;
-        // 设置基础目录
+        // 设置基础目录（只记录，与原来一样不影响加载的路径）
         void setBaseDir(const std::string& dir);
-        
+
+        // （节, 键）句柄：只对取得它的实例有效（reload得到的新实例需要重新取得）
+        struct Key
+        {
+            std::uint64_t id = invalidKey;
+            bool valid() const { return id != invalidKey; }
+        };
+        // 取得句柄，节或键不存在时返回无效句柄（用它查找得到缺省值）
+        Key key(const std::string& section, const std::string& key) const;
+
+        // 按节与键查找，不存在时返回nullptr
+        const ConfigValue* find(const std::string& section, const std::string& key) const;
+        const ConfigValue* find(Key key) const;
+        bool hasSection(const std::string& section) const;
+        // 类型化查找：整数与浮点互相转换，键不存在或类型不符时返回fallback
+        int getInt(const std::string& section, const std::string& key, int fallback) const;
+        float getFloat(const std::string& section, const std::string& key, float fallback) const;
+        bool getBool(const std::string& section, const std::string& key, bool fallback) const;
+        std::string getString(const std::string& section, const std::string& key,
+                              const std::string& fallback) const;
+        int getInt(Key key, int fallback) const;
+        float getFloat(Key key, float fallback) const;
+        bool getBool(Key key, bool fallback) const;
+        std::string getString(Key key, const std::string& fallback) const;
+
+        const std::string& getPath() const { return path; }
+
     private:
-        // 存储配置数据的字典
-        ConfigDict configData;
+        static constexpr std::uint64_t invalidKey = ~std::uint64_t(0);
+        static constexpr std::uint32_t noName = ~std::uint32_t(0);
+
+        // 推断一个值的类型
+        static ConfigValue parseValue(std::string_view text);
+        // 名字的id（没有出现过时返回noName）
+        std::uint32_t nameId(const std::string& name) const;
+        // 解析时驻留名字
+        std::uint32_t intern(std::string_view name);
+        static std::uint64_t combine(std::uint32_t section, std::uint32_t key)
+        {
+            return (static_cast<std::uint64_t>(section) << 32) | key;
+        }
+
+        // 节名与键名共用一张驻留表：名字 -> id，id -> 名字
+        std::unordered_map<std::string, std::uint32_t> names;
+        std::vector<std::string> nameList;
+        // （节id, 键id） -> 值
+        std::unordered_map<std::uint64_t, ConfigValue> values;
+        // 节id -> 该节的键id（按首次出现的顺序），用于枚举与比较
+        std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> sectionKeys;
+        // loadConfig选中的节
+        std::string currentSection;
+        // 已解析的文件
+        std::string path;
         std::string basedir = "";
 };
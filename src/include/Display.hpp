@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <limits>
 #include <memory>
 #include "ConfigLoader.hpp"
 
@@ -20,6 +21,8 @@ class Camera
         void setCenter(sf::Vector2f center);
         // 设置视图大小
         void setSize(sf::Vector2f size);
+        // 设置相机可移动的水平世界范围（通常为0到关卡宽度），视野不会超出该范围
+        void setHorizontalBounds(float left, float right);
         // 跟随目标点（通过引用传入Player类进行同步）
         void updateFollowPoint(sf::Vector2f point)
         {
@@ -31,7 +34,7 @@ class Camera
         std::weak_ptr<Player> targetObj; // 相机跟随的目标对象 （通常是玩家）
         // 摄像机跟随差值（半个屏幕）
         float minX = 960.f;
-        float maxX = 3500.f;
+        float maxX = std::numeric_limits<float>::max();
         float followoffsetX = 108.f;
         sf::Vector2f followPoint;
 };
@@ -49,7 +52,4 @@ class Display
         void clear();
         sf::RenderWindow window;
         Camera camera;
-
-    private:
-        ConfigLoader windowLoader;
 };
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <vector>
+
+// 实体句柄与组件下标的对应（稀疏集合）：句柄删除后可复用，下标始终连续。
+// 删除时由存储先把最后一个实体的组件搬到空位，再调用erase更新对应关系
+class EntityIndex
+{
+    public:
+        using Entity = std::uint32_t;
+        static constexpr Entity nullEntity = 0xFFFFFFFFu;
+
+        // 新实体的下标为创建前的size()
+        Entity create();
+        // 删除实体：最后一个实体改用被删除实体的下标
+        void erase(Entity entity);
+        bool valid(Entity entity) const { return entity < sparse.size() && sparse[entity] != nullEntity; }
+        std::size_t index(Entity entity) const { return sparse[entity]; }
+        Entity entityAt(std::size_t index) const { return entities[index]; }
+        std::size_t size() const { return entities.size(); }
+        void reserve(std::size_t count);
+        void clear();
+
+    private:
+        std::vector<Entity> entities;       // 下标 -> 实体
+        std::vector<std::uint32_t> sparse;  // 实体 -> 下标
+        std::vector<Entity> freeEntities;   // 可复用的实体句柄
+};
+
+// 实体组件存储（SoA）：每种组件一个紧凑数组，同一下标的元素属于同一个实体。
+// 实体删除时把最后一个实体搬到空位，数组始终连续，系统可以顺序遍历。
+// 对象（Enemy等）只保存实体句柄，作为访问这些数组的视图
+class EntityStore
+{
+    public:
+        using Entity = EntityIndex::Entity;
+        static constexpr Entity nullEntity = EntityIndex::nullEntity;
+
+        EntityStore();
+        ~EntityStore();
+
+        // 创建实体，所有组件取默认值
+        Entity create();
+        // 删除实体（不会销毁它的Box2D实体）
+        void destroy(Entity entity);
+        bool valid(Entity entity) const { return ids.valid(entity); }
+        // 实体当前在组件数组中的下标（实体删除后其它实体的下标可能改变）
+        std::size_t index(Entity entity) const { return ids.index(entity); }
+        // 下标处的实体
+        Entity entityAt(std::size_t index) const { return ids.entityAt(index); }
+        std::size_t size() const { return ids.size(); }
+        void reserve(std::size_t count);
+        void clear();
+        // 每帧物理步进之后、应用移动事件之前清除上一帧的dirty标记
+        void clearDirty();
+        // 实体随Box2D移动（移动事件）：记录新位置并标记dirty
+        void onBodyMoved(Entity entity, b2Vec2 position, bool fellAsleep);
+        // 每次物理步进之前把当前位置存为上一步位置（供绘制时插值）
+        void savePrevious();
+
+        // ===== 变换与速度（Box2D实体中心） =====
+        std::vector<float> posX, posY;
+        std::vector<float> prevX, prevY;        // 上一次物理步进前的位置
+        std::vector<float> velX, velY;
+        std::vector<b2BodyId> body;
+        std::vector<float> halfW, halfH;        // 碰撞箱半宽高（sprite左上角 = 中心 - 半宽高）
+        // ===== 巡逻 =====
+        std::vector<float> patrolMinX, patrolMaxX;
+        std::vector<float> patrolSpeed;         // 水平巡逻速度（绝对值）
+        // 标志位用32位整数存放（0/1），与float数组按相同步长做SIMD掩码运算
+        std::vector<std::int32_t> faceRight;
+        // ===== 生命与攻击 =====
+        std::vector<float> health, maxHealth;
+        std::vector<float> attackCooldown;
+        std::vector<std::int32_t> alive;
+        // Box2D实体是否醒着（由移动事件的fellAsleep维护，睡眠且无需速度的敌人不再写回Box2D）
+        std::vector<std::int32_t> awake;
+        // sprite需要重新同步（实体移动、调头、换帧），绘制时合批渲染器据此决定是否重建顶点
+        std::vector<std::int32_t> dirty;
+        // sprite当前显示的是两步之间的插值位置（实体停下后还需要再对齐一次）
+        std::vector<std::int32_t> blending;
+        // ===== 模拟LOD =====
+        std::vector<std::int32_t> lod;          // EnemySystem::Lod
+        std::vector<float> lodAccum;            // 降频更新时累积的时间
+        std::vector<float> stepDt;              // 本帧实际推进的时间（0表示本帧不更新）
+        std::uint32_t frameIndex = 0;           // 降频更新按帧号错开
+        // ===== 动画 =====
+        std::vector<float> animTimer, animFrameTime;
+        std::vector<std::int32_t> animFrame, animFrameCount;
+        // ===== 渲染（sprite和帧矩形由对象持有，这里只保存指针） =====
+        std::vector<sf::Sprite*> sprite;
+        std::vector<const sf::IntRect*> frames;
+
+    private:
+        // 所有组件数组统一改变长度
+        void resizeComponents(std::size_t count);
+        // 把from处的组件搬到to处
+        void moveComponents(std::size_t from, std::size_t to);
+
+        EntityIndex ids;
+};
+
+// 方块组件存储（SoA）：方块不移动、没有逐帧逻辑，组件只有判定用的包围盒、材质、生命值和Box2D实体。
+// 玩家与方块的接触判定由BlockSystem顺序扫描这些数组完成，不再逐个对象dynamic_cast；Block对象只保存句柄
+class BlockStore
+{
+    public:
+        using Entity = EntityIndex::Entity;
+        static constexpr Entity nullEntity = EntityIndex::nullEntity;
+
+        Entity create();
+        void destroy(Entity entity);
+        bool valid(Entity entity) const { return ids.valid(entity); }
+        std::size_t index(Entity entity) const { return ids.index(entity); }
+        std::size_t size() const { return ids.size(); }
+        void reserve(std::size_t count);
+        void clear();
+
+        // ===== 包围盒（sprite的全局包围盒，世界坐标） =====
+        std::vector<float> left, top, right, bottom;
+        // 碰撞矩形（与各类型的碰撞箱偏移一致，合并碰撞时登记到StaticBodyMerger）
+        std::vector<sf::FloatRect> collision;
+        // ===== 材质与生命 =====
+        std::vector<std::int32_t> type;         // Block::BlockType
+        std::vector<float> health;
+        std::vector<std::int32_t> destroyed;
+        // ===== 物理（合并碰撞时为空，由StaticBodyMerger持有实体） =====
+        std::vector<b2BodyId> body;
+
+    private:
+        void resizeComponents(std::size_t count);
+        void moveComponents(std::size_t from, std::size_t to);
+
+        EntityIndex ids;
+};
+
+// 方块系统：在BlockStore的数组上做玩家接触判定
+class BlockSystem
+{
+    public:
+        // 与bounds相交且未被破坏的方块的材质集合（第type位为1表示接触到该材质）
+        static std::uint32_t touchedTypes(const BlockStore& store, const sf::FloatRect& bounds);
+};
+
+// 敌人系统：在EntityStore的数组上批量执行巡逻、动画、冷却和sprite同步
+// 巡逻/冷却/动画这一段只读写紧凑数组，按SIMD宽度（AVX2为8、SSE2为4）成组处理，余数走标量
+class EnemySystem
+{
+    public:
+        enum class Path { Scalar, Simd };
+
+        // 模拟LOD：视野内逐帧更新，视野附近降频（累积dt），更远处冻结
+        enum Lod : std::int32_t { LodFull = 0, LodNear = 1, LodFrozen = 2 };
+        struct LodSettings
+        {
+            bool enabled         = true;
+            float nearDistance   = 1024.f;  // 距离视野小于该值为“附近”
+            int nearInterval     = 4;       // 附近的敌人每隔几次更新（固定步进时为物理步）推进一次
+            bool disableBodies   = true;    // 冻结时禁用Box2D实体（否则只把水平速度清零）
+        };
+        struct LodStats
+        {
+            std::size_t full   = 0;
+            std::size_t nearby = 0;
+            std::size_t frozen = 0;
+        };
+
+        // 按敌人中心到视野矩形的距离分级；进入冻结时禁用实体（或停下），离开冻结时重新启用
+        // 会修改Box2D实体，必须在物理步进之外调用
+        static LodStats updateLod(EntityStore& store, const sf::FloatRect& view, const LodSettings& settings);
+        // 根据LOD计算每个敌人本帧推进的时间（stepDt），并推进帧号
+        static void scheduleSteps(EntityStore& store, float deltaTime, int nearInterval, std::size_t begin, std::size_t end);
+
+        // 更新下标[begin, end)内的敌人，end为0时更新全部
+        // 位置由物理步进后的移动事件写入（EntityStore::onBodyMoved），这里不再逐个查询Box2D
+        // 依次为：按LOD分配stepDt -> 巡逻/冷却/动画（SIMD） -> 一次性写回速度（跳过本帧不更新、睡眠且静止的实体） -> 只同步dirty的sprite
+        static void update(EntityStore& store, float deltaTime, std::size_t begin = 0, std::size_t end = 0, int nearInterval = 1);
+        // 绘制前按插值系数alpha（0为上一步、1为当前步）混合位置并写入sprite，插值过的实体标记dirty
+        static void interpolate(EntityStore& store, float alpha);
+        // 只执行巡逻/冷却/动画这一段（使用store.stepDt，不访问Box2D与sprite），供基准测试对比两种实现
+        static void stepPatrol(EntityStore& store, std::size_t begin, std::size_t end, Path path);
+        // 当前编译启用的SIMD宽度（1表示只有标量实现）
+        static int simdWidth();
+        // 敌人sprite的缩放（x的正负表示朝向）
+        static constexpr float spriteScale = 0.25f;
+
+    private:
+        static void stepPatrolScalar(EntityStore& store, std::size_t begin, std::size_t end);
+        // 返回已处理到的下标（剩余部分交给标量实现）
+        static std::size_t stepPatrolSimd(EntityStore& store, std::size_t begin, std::size_t end);
+};
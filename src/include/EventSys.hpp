@@ -2,6 +2,7 @@
 #include <SFML/System.hpp>
 #include <functional>
 #include <queue>
+#include <vector>
 #include <iostream>
 // #include <vector>5
 // #include <memory>
@@ -31,11 +32,16 @@ class EventSys
             ImmEventPriority priority;
             EventFunc func;
             // unsigned short id;
+            // 注册序号：同一优先级的事件按注册顺序执行（保证同层绘制顺序稳定）
+            unsigned long long seq = 0;
             // 重载小于运算符以便按优先级排序
             bool operator<(const ImmEvent& other) const
             {
                 // return static_cast<int>(priority) > static_cast<int>(other.priority);
-                return priority > other.priority;
+                if (priority != other.priority) {
+                    return priority > other.priority;
+                }
+                return seq > other.seq;
             }
         };
         struct TimedEvent
@@ -56,10 +62,15 @@ class EventSys
         void regImmEvent(const ImmEventPriority eventType, const EventFunc& func);
         // 注册定时事件 参数：延迟时间，事件函数
         void regTimedEvent(const sf::Time delay, const EventFunc& func);
+        // 注册帧边界事件：在下一帧开始、本帧的即时事件注册之前按注册顺序执行，
+        // 用于热重载等会替换对象的修改（不会与已注册、引用旧对象的即时事件交错）
+        void regFrameEvent(const EventFunc& func);
         // 执行即时事件
         void executeImmEvents();
         // 执行定时事件
         void executeTimedEvents();
+        // 执行帧边界事件（主循环在每帧开始时调用）
+        void executeFrameEvents();
         // 获取事件系统运行时间 （游戏基准时钟）
         sf::Time getElapsedTime() const;
 
@@ -67,6 +78,10 @@ class EventSys
         // 存储即时事件和定时事件的优先队列
         std::priority_queue<ImmEvent> immEventQueue;
         std::priority_queue<TimedEvent> timedEventQueue;
+        // 帧边界事件
+        std::vector<EventFunc> frameEvents;
+        // 即时事件注册计数
+        unsigned long long immEventSeq = 0;
         // 事件系统计时器
         sf::Clock eventSysClock;
 };
\ No newline at end of file
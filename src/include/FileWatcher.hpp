@@ -0,0 +1,59 @@
+#pragma once
+#include "EventSys.hpp"
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 文件监视：监视的文件写入完成（或被编辑器以改名方式替换）后，把它的回调注册为事件系统的帧边界事件，
+// 在下一帧开始时执行。Linux上用inotify监视文件所在的目录（编辑器保存时常常先写临时文件再改名，
+// 直接监视文件会丢失），其它平台每隔一段时间比较修改时间。
+// 同一个文件在两次poll之间的多次写入合并为一次回调。只监视磁盘上的散文件；资源包中是打包时的旧内容，
+// 回调中重新读取时要让散文件优先（AssetVfs::readText的preferDisk）
+class FileWatcher
+{
+    public:
+        using Callback = std::function<void(const std::string& path)>;
+
+        FileWatcher();
+        ~FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        // 回调通过事件系统在帧边界执行；未设置时poll中直接调用
+        void setEventSys(const std::weak_ptr<EventSys>& eventSys) { eventSysPtr = eventSys; }
+        // 监视文件（可以暂时不存在，创建后也会通知），同一路径重复调用时替换回调
+        bool watch(const std::string& path, Callback callback);
+        // 收集自上次调用以来改变的文件并派发回调（主循环每帧结束时调用），返回改变的文件数
+        std::size_t poll();
+        // 是否使用系统通知（否则为比较修改时间）
+        bool isNative() const { return notifyFd >= 0; }
+
+    private:
+        struct Watch
+        {
+            std::string path;                   // 调用方给出的路径，回调时原样传回
+            std::filesystem::path directory;
+            std::string name;                   // 目录中的文件名
+            int directoryWatch = -1;            // inotify监视描述符
+            std::filesystem::file_time_type mtime{};
+            bool changed = false;
+            Callback callback;
+        };
+
+        // 读取inotify事件，标记改变的文件
+        void readNotifications();
+        // 没有inotify时比较修改时间
+        void scanModifiedTimes();
+        static std::filesystem::file_time_type modifiedTime(const std::filesystem::path& path);
+
+        std::vector<Watch> watches;
+        // 目录 -> inotify监视描述符（同一目录下的文件共用一个）
+        std::unordered_map<std::string, int> directoryWatches;
+        int notifyFd = -1;
+        std::chrono::steady_clock::time_point lastScan{};
+        std::weak_ptr<EventSys> eventSysPtr;
+};
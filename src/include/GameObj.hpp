@@ -1,8 +1,13 @@
 
 #pragma once
 #include "EventSys.hpp"
-#include "ResourceLoader.hpp"
+#include "LevelDesc.hpp"
 #include "GameInput.hpp"
+#include "TextureAtlas.hpp"
+#include "SpriteBatch.hpp"
+#include "TextureCache.hpp"
+#include "RawImageCache.hpp"
+#include "EntityStore.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <box2d/box2d.h>
@@ -10,6 +15,26 @@
 #include <unordered_map>
 #include <memory>
 #include <optional>
+#include <cstdint>
+
+// 对象的运行时状态：定长的平坦结构，Scene可以整块memcpy进快照缓冲
+// 各字段的具体含义由对象自己的saveState/loadState约定
+struct ObjectState
+{
+    float x  = 0.0f;            // 位置（有Box2D实体时为实体中心，否则为sprite位置）
+    float y  = 0.0f;
+    float vx = 0.0f;            // 线速度
+    float vy = 0.0f;
+    float health    = 0.0f;
+    float timer     = 0.0f;     // 对象自定义计时（攻击冷却、子弹存活时间等）
+    float animTimer = 0.0f;
+    std::int32_t animFrame = 0;
+    std::int32_t kind      = 0; // 对象自定义类型（子弹类型等）
+    std::uint8_t valid = 0;     // 是否记录过运行时状态，0表示按关卡配置创建
+    std::uint8_t alive = 1;     // 0表示已被破坏/击败，不需要再创建
+    std::uint8_t awake = 1;     // Box2D实体是否唤醒
+    std::uint8_t flags = 0;     // 对象自定义标志位（朝向、激活等）
+};
 
 // 基础游戏抽象类（不能直接实例化）
 class BaseObj{
@@ -29,9 +54,50 @@ public:
 
     void setWindowPtr(const std::weak_ptr<sf::RenderWindow>& win) { windowPtr.emplace(win); }
     void setEventSysPtr(const std::weak_ptr<EventSys>& eventSys) { eventSysPtr = eventSys; }
+    // 设置纹理图集指针，需在initialize之前调用，未设置时对象自行加载纹理
+    void setAtlasPtr(const std::weak_ptr<TextureAtlas>& atlas) { atlasPtr = atlas; }
+    // 设置合批渲染器指针，未设置时每个对象单独注册绘制事件
+    void setBatchPtr(const std::weak_ptr<SpriteBatch>& batch) { batchPtr = batch; }
+    // 设置纹理缓存指针，图集中没有的纹理通过缓存共享，未设置时对象自行加载纹理
+    void setTextureCachePtr(const std::weak_ptr<TextureCache>& cache) { textureCachePtr = cache; }
+    // 查询对象特征（"drawable"、"box2d"、"cullable"、"static" 等）
+    bool hasFeature(const std::string& name) const
+    {
+        auto it = features.find(name);
+        return it != features.end() && it->second;
+    }
+    // 设置对象特征（例如Scene烘焙静态几何后设置 "baked"）
+    void setFeature(const std::string& name, bool value) { features[name] = value; }
+    // 渲染包围盒（世界坐标），用于视锥剔除，默认为sprite的全局包围盒
+    virtual sf::FloatRect getRenderBounds() const;
+    // 对象绘制所在的图层
+    virtual EventSys::ImmEventPriority getDrawLayer() const { return EventSys::ImmEventPriority::DRAW; }
+    // 对象的sprite，没有时返回nullptr
+    const sf::Sprite* getSprite() const { return sprite.has_value() ? &sprite.value() : nullptr; }
+    // 记录运行时状态（流式卸载、回滚快照），state.alive为0表示对象已不存在（被破坏/击败）
+    virtual void saveState(ObjectState& state) const { state.valid = 1; }
+    // 从saveState记录的状态恢复（对象必须是用同一份配置创建的，且仍然存活）
+    virtual void loadState(const ObjectState& state) {}
+    // 流式卸载时销毁对象的Box2D实体（物理世界本身保留）
+    virtual void releasePhysics() {}
+    // 物理步进后Box2D报告该对象的实体移动了（实体的userData为该对象），只有移动过的对象会收到
+    virtual void onBodyMoved(const b2Transform& transform, bool fellAsleep) {}
+    // 每次物理步进之前记录当前变换，绘制时在上一步与当前步之间插值（只有动态实体需要）
+    virtual void savePreviousTransform() {}
+    // 绘制前按插值系数alpha（0为上一步、1为当前步）把sprite放到两步之间
+    virtual void interpolateTransform(float alpha) {}
+    // sprite自上一帧以来是否可能改变（合批渲染器据此决定是否重建顶点），默认总是重建
+    virtual bool spriteDirty() const { return true; }
 
 protected:
-    // 类的特征 "box2d" : 是否拥有Box2D物理属性 "sound" : 是否拥有声音属性 ... 需要在initialize中设定
+    // 加载纹理并创建sprite：图集中有该路径时直接引用图集子区域，否则单独加载纹理
+    bool loadSpriteTexture(const std::string& path);
+    // 在指定图层绘制sprite：有合批渲染器时交给批次，否则单独注册绘制事件
+    void submitDraw(const EventSys::ImmEventPriority priority);
+
+    // 类的特征 "box2d" : 是否拥有Box2D物理属性 "sound" : 是否拥有声音属性
+    // "cullable" : 可以按相机视野剔除 "static" : 初始化后不再移动
+    // "bakeable" : 可以烘焙进静态区块 "baked" : 已由静态区块绘制 ... 需要在initialize中设定
     std::unordered_map<std::string, bool> features;
     // sprite纹理 在initialize中设定 Sprite类保存Texture的引用，确保Texture在Sprite生命周期内有效
     std::optional<sf::Sprite> sprite;
@@ -45,6 +111,16 @@ protected:
     std::optional<std::weak_ptr<GameInputRead>> inputPtr;
     // 任务系统指针 在initialize中设定
     std::weak_ptr<EventSys> eventSysPtr;
+    // 纹理图集指针 由Scene在initialize之前设定
+    std::weak_ptr<TextureAtlas> atlasPtr;
+    // 合批渲染器指针 由Scene在initialize之前设定
+    std::weak_ptr<SpriteBatch> batchPtr;
+    // 纹理缓存指针 由Scene在initialize之前设定
+    std::weak_ptr<TextureCache> textureCachePtr;
+    // 从纹理缓存取得的共享纹理（sprite引用它时必须保持有效）
+    std::shared_ptr<const sf::Texture> sharedTexture;
+    // sprite所用图片在其纹理中的区域（使用图集时为图集子矩形，否则为整张纹理）
+    sf::IntRect textureRect;
 };
 
 // 图形类（包括背景，按钮图形等）
@@ -58,12 +134,13 @@ public:
     GraphicObj();
     ~GraphicObj() override;
     // 重写基类方法，通过Scene的addObject调用
-    void initialize(const ResourceLoader::ResourceDict& objConfig);
+    void initialize(const GraphicDesc& desc);
     void setPtrs(const std::weak_ptr<EventSys>& eventSys,
                  const std::weak_ptr<sf::RenderWindow>& window,
                  const std::weak_ptr<GameInputRead>& input);
     void update(float deltaTime) override;
     void draw() override;
+    EventSys::ImmEventPriority getDrawLayer() const override { return EventSys::ImmEventPriority::DRAWBACKGROUND; }
 
 private:
     GraphicType graphicType;
@@ -80,31 +157,45 @@ public:
         LAVA
     };
 
-    BlockType getBlockType() const { return blockType; }
-    bool isLava() const { return blockType == LAVA; }
-    bool isIce()  const { return blockType == ICE;  }
+    BlockType getBlockType() const;
+    bool isLava() const { return getBlockType() == LAVA; }
+    bool isIce()  const { return getBlockType() == ICE;  }
     sf::FloatRect getHitBox() const;
     
     Block();
     ~Block() override;
     // 重写基类方法，通过Scene的addObject调用
-    void initialize(const ResourceLoader::ResourceDict& objConfig);
+    void initialize(const BlockDesc& desc);
     // 设置核心指针（方块类不需要输入）
     void setPtrs(const std::weak_ptr<EventSys>& eventSys,
                  const std::weak_ptr<sf::RenderWindow>& window,
                  const std::weak_ptr<b2WorldId>& world);
     void update(float deltaTime) override;
-    // void draw() override;
+    void draw() override;
     void onhit(float damage);
     void onkill();
+    bool isDestroyed() const;
+    void saveState(ObjectState& state) const override;
+    void loadState(const ObjectState& state) override;
+    void releasePhysics() override;
+    // 方块被破坏时的回调（Scene用来重建静态区块）
+    void setKillCallback(const std::function<void(Block&)>& callback) { killCallback = callback; }
+    // 碰撞交给Scene合并（须在initialize之前调用）：不再创建自己的Box2D实体，
+    // 由Scene把相邻同材质方块的碰撞矩形合并进StaticBodyMerger
+    void setMergedCollision(bool merged) { mergedCollision = merged; }
+    bool hasMergedCollision() const { return mergedCollision; }
+    // 碰撞矩形（世界坐标，与各类型的碰撞箱偏移一致）
+    const sf::FloatRect& getCollisionRect() const;
+    // 设置方块数据所在的存储（须在initialize之前调用，未设置时使用独立的存储）
+    // Scene让所有方块共享一个存储，玩家接触判定由BlockSystem扫描
+    void setBlockStore(const std::shared_ptr<BlockStore>& blockStore) { store = blockStore; }
 
 private:
-    // 方块的生命值 可以设置极高表示不可破坏
-    float health;
-    // 方块类型
-    BlockType blockType;
-    // box2d
-    b2BodyId groundId;
+    std::function<void(Block&)> killCallback;
+    bool mergedCollision = false;
+    // 生命值（可以设置极高表示不可破坏）、类型、包围盒和Box2D实体都在方块存储中，这里只保存句柄
+    std::shared_ptr<BlockStore> store;
+    BlockStore::Entity entity = BlockStore::nullEntity;
 };
 
 class Enemy : public BaseObj{
@@ -112,7 +203,7 @@ public:
     Enemy();
     ~Enemy() override;
     // 通过Scene的addObject调用initialize方法
-    void initialize(const ResourceLoader::ResourceDict& objConfig);
+    void initialize(const EnemyDesc& desc);
     // 设置核心指针（敌人类可能需要输入,比如如果你不会做玩家攻击，那么就直接绑定一个键收到攻击，玩家按下那个键敌人就受伤）
     void setPtrs(const std::weak_ptr<EventSys>& eventSys,
                  const std::weak_ptr<sf::RenderWindow>& window,
@@ -127,31 +218,32 @@ public:
     // 攻击玩家
     void attackPlayer();
     // 查询状态 / 碰撞箱
-    bool isAliveFlag() const {return isAlive;};
+    bool isAliveFlag() const { return store && store->alive[store->index(entity)] != 0; }
     sf::FloatRect getHitBox() const;
     float getAttackDamage() const { return attackDamage; }
+    void saveState(ObjectState& state) const override;
+    void loadState(const ObjectState& state) override;
+    void releasePhysics() override;
+    // 位置写入实体存储并标记dirty，sprite由EnemySystem统一同步
+    void onBodyMoved(const b2Transform& transform, bool fellAsleep) override;
+    bool spriteDirty() const override { return !store || store->dirty[store->index(entity)] != 0; }
+    // 设置敌人数据所在的实体存储（须在initialize之前调用，未设置时使用独立的存储）
+    // Scene让所有敌人共享一个存储，并每帧用EnemySystem批量更新
+    void setEntityStore(const std::shared_ptr<EntityStore>& entityStore) { store = entityStore; }
+    EntityStore::Entity getEntity() const { return entity; }
 
 
 
 private:
-    // 敌人的生命值,最大生命值，攻击力，攻击冷却等属性
-    float health;
-    float maxHealth;
+    // 攻击力（只读配置，不参与逐帧更新）
     float attackDamage;
-    float attackCooldown;
-    // 敌人是否存活，面向方向
-    bool isAlive, faceRight;
-    // box2d属性
-    b2BodyId bodyId;
-    b2Vec2 velocity;
-    b2Vec2 patrolPointA;
-    b2Vec2 patrolPointB;
+    // 生命值、巡逻、速度、动画等逐帧数据都在实体存储中，这里只保存句柄
+    std::shared_ptr<EntityStore> store;
+    EntityStore::Entity entity = EntityStore::nullEntity;
+    b2BodyId bodyId = b2_nullBodyId;
     sf::Vector2f boxparams; // 用于存储方块的宽度和高度
-    // 动画相关（敌人专用）
+    // 动画帧矩形（实体存储保存指向它的指针）
     std::vector<sf::IntRect> animFrames;  // 每一帧的矩形
-    int   currentAnimFrame = 0;           // 当前帧索引
-    float animTimer        = 0.0f;        // 计时器
-    float animFrameTime    = 0.15f;       // 每帧持续时间（秒）
 
 };
 
@@ -181,6 +273,11 @@ public:
 
     void draw() override;
     static ProjectileType fromString(const std::string& typeStr);
+    // 子弹类型对应的贴图路径（Scene打包图集时使用）
+    static std::string texturePathFor(ProjectileType type);
+    // kind为子弹类型，flags为朝向，timer为已存在时间
+    void saveState(ObjectState& state) const override;
+    void loadState(const ObjectState& state) override;
 
 private:
     ProjectileType projectileType;
@@ -212,7 +309,7 @@ public:
     Trap();
     ~Trap() override;
 
-    void initialize(const ResourceLoader::ResourceDict& objConfig);
+    void initialize(const TrapDesc& desc);
     void setPtrs(const std::weak_ptr<EventSys>& eventSys,
                  const std::weak_ptr<sf::RenderWindow>& window,
                  const std::weak_ptr<b2WorldId>& world);
@@ -237,6 +334,9 @@ public:
     void setHasDamagedPlayer(bool v) { hasDamagedPlayer = v; }
 
     bool isGoal() const { return isGoal_; }
+    void saveState(ObjectState& state) const override;
+    void loadState(const ObjectState& state) override;
+    void releasePhysics() override;
     
 private:
     TrapType trapType = SPIKE;
@@ -262,16 +362,22 @@ public:
     ParallaxLayer();
     ~ParallaxLayer() override;
 
-    void initialize(const ResourceLoader::ResourceDict& objConfig);
+    void initialize(const ParallaxDesc& desc);
     void setPtrs(const std::weak_ptr<EventSys>& eventSys,
                  const std::weak_ptr<sf::RenderWindow>& window);
     void update(float deltaTime) override;
     void updateWithCamera(float deltaTime, sf::Vector2f cameraPos);
     void draw() override;
+    // 设置图层覆盖的关卡宽度，需在initialize之前调用
+    void setLevelWidth(float width) { levelWidth = width; }
+    // 设置已解码的图层图片，initialize时直接上传而不读文件（需在initialize之前调用，只使用一次）
+    void setSourceImage(const sf::Image* image) { sourceImage = image; }
+    // 设置解码缓存中映射的图层像素，initialize时直接从映射内存上传（优先于setSourceImage）
+    void setSourceRaw(std::shared_ptr<const RawImageCache::Entry> raw) { sourceRaw = std::move(raw); }
 
 private:
     std::optional<sf::Sprite> sprite1;        // 精灵（使用纹理重复模式）
-    std::optional<sf::Texture> texture;       // 图层纹理
+    std::optional<sf::Texture> texture;       // 图层纹理（没有纹理缓存时使用，否则为sharedTexture）
     float scrollSpeed;         // 滚动速度（视差系数，0.0-1.0）
     float textureWidth;        // 纹理宽度
     float textureHeight;       // 纹理高度
@@ -280,4 +386,6 @@ private:
     int layerIndex;            // 图层索引（用于确定绘制优先级）
     float baseOffset;          // 基础偏移量（用于时间动画）
     float levelWidth;          // 关卡宽度（用于纹理矩形大小）
+    const sf::Image* sourceImage = nullptr;   // 场景异步加载时预先解码的图片
+    std::shared_ptr<const RawImageCache::Entry> sourceRaw;   // 解码缓存命中时的映射像素
 };
\ No newline at end of file
@@ -0,0 +1,190 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct LevelDesc;
+
+// 编译后的二进制关卡（.lvlb）：由levelcook把关卡JSON转换而来，运行时整个文件内存映射，
+// 每种对象一段定长记录数组，字符串（纹理路径、类型名）统一放在字符串表里用偏移引用。
+// 读取时只校验文件头和段表，记录直接按类型指针访问，不做任何解析
+//
+// 文件布局（小端，所有段按16字节对齐）：
+//   Header | Section[sectionCount] | 记录数组... | 字符串表（以'\0'结尾的字符串依次排列）
+class LevelBinary
+{
+    public:
+        static constexpr std::uint32_t version   = 2;   // 2：对象记录带可选的id
+        static constexpr std::uint32_t endianTag = 0x01020304u;
+        static constexpr std::uint32_t alignment = 16;
+        // 字符串表中不存在的字符串（可选字段缺省）
+        static constexpr std::uint32_t noString  = 0xFFFFFFFFu;
+
+        // 对象类型，与关卡JSON中objKeys的名字对应
+        enum class ObjectType : std::uint32_t
+        {
+            Unknown = 0,
+            Graphic,    // GraphicObj
+            Parallax,   // ParallaxLayer
+            Block,
+            Enemy,
+            Trap
+        };
+
+        struct Header
+        {
+            char magic[4];                  // "LVLB"
+            std::uint32_t version;
+            std::uint32_t endianTag;
+            std::uint32_t flags;            // HasLevelWidth等
+            std::uint32_t sectionCount;
+            std::uint32_t sectionTableOffset;
+            std::uint32_t stringTableOffset;
+            std::uint32_t stringTableSize;
+            std::uint32_t name;             // 字符串表偏移
+            std::uint32_t background;
+            std::uint32_t music;
+            float gravityX;
+            float gravityY;
+            float levelWidth;               // flags & HasLevelWidth 时有效
+            std::uint32_t reserved[2];
+        };
+        enum HeaderFlags : std::uint32_t { HasLevelWidth = 1u << 0 };
+
+        // 段：一个objKey下的全部对象，段的顺序与objKeys相同
+        struct Section
+        {
+            ObjectType type;
+            std::uint32_t key;              // objKey名字（字符串表偏移）
+            std::uint32_t count;            // 记录数
+            std::uint32_t offset;           // 记录数组在文件中的偏移
+            std::uint32_t recordSize;       // 单条记录字节数（读取时与当前版本的结构体比对）
+            std::uint32_t reserved;
+        };
+
+        // ===== 定长记录（字段全部4字节，字符串为字符串表偏移） =====
+        struct GraphicRecord
+        {
+            static constexpr ObjectType kind = ObjectType::Graphic;
+            std::uint32_t type;             // "BACKGROUND" / "BUTTON"
+            std::uint32_t texture;
+            float x, y, width, height;
+        };
+        struct ParallaxRecord
+        {
+            static constexpr ObjectType kind = ObjectType::Parallax;
+            std::int32_t layer;
+            std::uint32_t texture;
+            float speed;
+            float y;
+            std::uint32_t id;               // 可选，缺省为noString
+        };
+        struct BlockRecord
+        {
+            static constexpr ObjectType kind = ObjectType::Block;
+            std::uint32_t type;             // "GRASS" / "ICE" / "WATER" / "LAVA"
+            std::uint32_t texture;
+            float health;
+            float x, y, width, height;
+            std::uint32_t id;               // 可选，缺省为noString
+        };
+        struct EnemyRecord
+        {
+            static constexpr ObjectType kind = ObjectType::Enemy;
+            std::uint32_t texture;
+            float health, attackDamage, attackCooldown;
+            float x, y, width, height;
+            float density, friction;
+            float velocityX, velocityY;
+            float patrolAx, patrolAy, patrolBx, patrolBy;
+            std::uint32_t id;               // 可选，缺省为noString
+        };
+        struct TrapRecord
+        {
+            static constexpr ObjectType kind = ObjectType::Trap;
+            std::uint32_t type;             // "SPIKE" / "GOAL"
+            std::uint32_t element;          // 可选，缺省为noString
+            std::uint32_t texture;
+            std::uint32_t flags;            // HasHealth
+            float health, damage;
+            float x, y, width, height;
+            float triggerX, triggerY, triggerWidth, triggerHeight;
+            std::uint32_t id;               // 可选，缺省为noString
+        };
+        enum TrapFlags : std::uint32_t { HasHealth = 1u << 0 };
+
+        // 只读的连续记录视图
+        template <typename T>
+        struct Span
+        {
+            const T* ptr = nullptr;
+            std::size_t count = 0;
+
+            const T* begin() const { return ptr; }
+            const T* end() const { return ptr + count; }
+            std::size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            const T& operator[](std::size_t i) const { return ptr[i]; }
+        };
+
+        LevelBinary() = default;
+        ~LevelBinary();
+        LevelBinary(const LevelBinary&) = delete;
+        LevelBinary& operator=(const LevelBinary&) = delete;
+
+        // 映射并校验文件（魔数、版本、字节序、段与字符串表越界、记录大小），失败时返回false并打印原因
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return base != nullptr; }
+
+        const Header& header() const { return *reinterpret_cast<const Header*>(base); }
+        std::size_t sectionCount() const { return isOpen() ? header().sectionCount : 0; }
+        const Section& section(std::size_t index) const { return sections()[index]; }
+        // 字符串表中的字符串（noString或越界返回空）
+        std::string_view string(std::uint32_t id) const;
+        // 段的记录（类型不符时返回空视图）
+        template <typename T>
+        Span<T> records(const Section& sec) const
+        {
+            if (sec.type != T::kind) {
+                return {};
+            }
+            return { reinterpret_cast<const T*>(base + sec.offset), sec.count };
+        }
+        // 第一个该类型段的记录
+        template <typename T>
+        Span<T> records() const
+        {
+            for (std::size_t i = 0; i < sectionCount(); ++i) {
+                if (section(i).type == T::kind) {
+                    return records<T>(section(i));
+                }
+            }
+            return {};
+        }
+
+        // objKey名字 -> 对象类型（未知类型返回Unknown）
+        static ObjectType typeFromKey(std::string_view key);
+        // 把关卡JSON编译成二进制文件，出错时打印原因（含对象下标与字段名）并返回false
+        static bool cook(const std::string& jsonPath, const std::string& outPath);
+        // 把映射的记录展开成LevelDesc（替换level原有内容），与LevelReader读取同一个JSON的结果相同
+        void toDesc(LevelDesc& level) const;
+        // 关卡JSON旁边的编译结果（config/level1.json -> config/level1.lvlb）
+        static std::string cookedPathFor(const std::string& jsonPath);
+        // 有比JSON新的编译结果时从它读取关卡并返回true；没有、已过期或校验失败时返回false，由调用方改读JSON
+        static bool readCooked(const std::string& jsonPath, LevelDesc& level);
+
+    private:
+        const Section* sections() const
+        {
+            return reinterpret_cast<const Section*>(base + header().sectionTableOffset);
+        }
+        // 校验映射内容，失败时打印原因
+        bool validate(const std::string& path) const;
+
+        MappedFile file;
+        const std::uint8_t* base = nullptr;
+        std::size_t length = 0;
+};
@@ -0,0 +1,233 @@
+#pragma once
+#include "ObjectSchema.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 关卡对象的类型化描述：字段与关卡JSON中的键同名，每种结构体后面是它的字段表（ObjectSchema），
+// 必填字段、缺省值和可选取值都以字段表为准。由LevelReader（流式JSON）按字段表解码填充，
+// 对象的initialize直接读取这些结构体，不再经过字符串键的ResourceDict
+
+struct GraphicDesc
+{
+    std::string type;               // "BACKGROUND" / "BUTTON"
+    std::string texture;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+};
+
+inline constexpr const char* graphicTypeNames[] = { "BACKGROUND", "BUTTON", nullptr };
+
+template <>
+struct ObjectSchema<GraphicDesc>
+{
+    static constexpr SchemaField<GraphicDesc> fields[] = {
+        SCHEMA_STRING(GraphicDesc, type,    Required, graphicTypeNames),
+        SCHEMA_STRING(GraphicDesc, texture, Required, nullptr),
+        SCHEMA_FLOAT (GraphicDesc, x,       Required, 0.0f),
+        SCHEMA_FLOAT (GraphicDesc, y,       Required, 0.0f),
+        SCHEMA_FLOAT (GraphicDesc, width,   Optional, 0.0f),
+        SCHEMA_FLOAT (GraphicDesc, height,  Optional, 0.0f),
+    };
+};
+static_assert(schemaIsValid<GraphicDesc>(), "GraphicDesc schema is inconsistent");
+
+struct ParallaxDesc
+{
+    int layer = 0;
+    std::string texture;
+    float speed = 0.0f;
+    float y = 0.0f;
+    std::string id;                 // 可选：稳定ID，热重载时按它配对新旧对象（没有时按图层号配对）
+};
+
+template <>
+struct ObjectSchema<ParallaxDesc>
+{
+    static constexpr SchemaField<ParallaxDesc> fields[] = {
+        SCHEMA_INT   (ParallaxDesc, layer,   Required, 0),
+        SCHEMA_STRING(ParallaxDesc, texture, Required, nullptr),
+        SCHEMA_FLOAT (ParallaxDesc, speed,   Required, 0.0f),
+        SCHEMA_FLOAT (ParallaxDesc, y,       Required, 0.0f),
+        SCHEMA_STRING(ParallaxDesc, id,      Optional, nullptr),
+    };
+};
+static_assert(schemaIsValid<ParallaxDesc>(), "ParallaxDesc schema is inconsistent");
+
+struct BlockDesc
+{
+    std::string type;               // "GRASS" / "ICE" / "WATER" / "LAVA"
+    std::string texture;
+    float health = 0.0f;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    std::string id;                 // 可选：稳定ID，热重载时按它配对新旧对象（没有时按坐标配对）
+};
+
+inline constexpr const char* blockTypeNames[] = { "GRASS", "ICE", "WATER", "LAVA", nullptr };
+
+template <>
+struct ObjectSchema<BlockDesc>
+{
+    static constexpr SchemaField<BlockDesc> fields[] = {
+        SCHEMA_STRING(BlockDesc, type,    Required, blockTypeNames),
+        SCHEMA_STRING(BlockDesc, texture, Required, nullptr),
+        SCHEMA_FLOAT (BlockDesc, health,  Required, 0.0f),
+        SCHEMA_FLOAT (BlockDesc, x,       Required, 0.0f),
+        SCHEMA_FLOAT (BlockDesc, y,       Required, 0.0f),
+        SCHEMA_FLOAT (BlockDesc, width,   Required, 0.0f),
+        SCHEMA_FLOAT (BlockDesc, height,  Required, 0.0f),
+        SCHEMA_STRING(BlockDesc, id,      Optional, nullptr),
+    };
+};
+static_assert(schemaIsValid<BlockDesc>(), "BlockDesc schema is inconsistent");
+
+struct EnemyDesc
+{
+    std::string texture;
+    float health = 0.0f;
+    float attackDamage = 0.0f;
+    float attackCooldown = 0.0f;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    float density = 0.0f, friction = 0.0f;
+    float velocityX = 0.0f, velocityY = 0.0f;
+    float patrolAx = 0.0f, patrolAy = 0.0f;
+    float patrolBx = 0.0f, patrolBy = 0.0f;
+    std::string id;                 // 可选：稳定ID（同BlockDesc）
+};
+
+template <>
+struct ObjectSchema<EnemyDesc>
+{
+    static constexpr SchemaField<EnemyDesc> fields[] = {
+        SCHEMA_STRING(EnemyDesc, texture,        Required, nullptr),
+        SCHEMA_FLOAT (EnemyDesc, health,         Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, attackDamage,   Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, attackCooldown, Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, x,              Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, y,              Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, width,          Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, height,         Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, density,        Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, friction,       Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, velocityX,      Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, velocityY,      Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, patrolAx,       Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, patrolAy,       Optional, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, patrolBx,       Required, 0.0f),
+        SCHEMA_FLOAT (EnemyDesc, patrolBy,       Optional, 0.0f),
+        SCHEMA_STRING(EnemyDesc, id,             Optional, nullptr),
+    };
+};
+static_assert(schemaIsValid<EnemyDesc>(), "EnemyDesc schema is inconsistent");
+
+struct TrapDesc
+{
+    std::string type;               // "SPIKE" / "GOAL"
+    std::string element;            // 可选："FIRE" / "ICE" / "NEUTRAL"，空表示无元素
+    std::string texture;
+    float health = 0.0f;
+    float damage = 0.0f;
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    float triggerX = 0.0f, triggerY = 0.0f;
+    float triggerWidth = 0.0f, triggerHeight = 0.0f;
+    std::string id;                 // 可选：稳定ID（同BlockDesc）
+};
+
+inline constexpr const char* trapTypeNames[]    = { "SPIKE", "GOAL", nullptr };
+inline constexpr const char* trapElementNames[] = { "FIRE", "ICE", "NEUTRAL", nullptr };
+
+template <>
+struct ObjectSchema<TrapDesc>
+{
+    static constexpr SchemaField<TrapDesc> fields[] = {
+        SCHEMA_STRING(TrapDesc, type,          Required, trapTypeNames),
+        SCHEMA_STRING(TrapDesc, element,       Optional, trapElementNames),
+        SCHEMA_STRING(TrapDesc, texture,       Required, nullptr),
+        SCHEMA_FLOAT (TrapDesc, health,        Optional, 2.0f),     // 缺省打两下碎
+        SCHEMA_FLOAT (TrapDesc, damage,        Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, x,             Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, y,             Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, width,         Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, height,        Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, triggerX,      Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, triggerY,      Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, triggerWidth,  Required, 0.0f),
+        SCHEMA_FLOAT (TrapDesc, triggerHeight, Required, 0.0f),
+        SCHEMA_STRING(TrapDesc, id,            Optional, nullptr),
+    };
+};
+static_assert(schemaIsValid<TrapDesc>(), "TrapDesc schema is inconsistent");
+
+// 整个关卡：全局参数 + 每种对象一个数组（objKeys决定创建顺序）
+struct LevelDesc
+{
+    std::string name;
+    std::string background;
+    std::string music;
+    float gravityX = 0.0f, gravityY = 0.0f;
+    bool hasLevelWidth = false;
+    float levelWidth = 0.0f;
+    std::vector<std::string> objKeys;
+
+    std::vector<GraphicDesc> graphics;
+    std::vector<ParallaxDesc> parallaxLayers;
+    std::vector<BlockDesc> blocks;
+    std::vector<EnemyDesc> enemies;
+    std::vector<TrapDesc> traps;
+
+    // 清空内容但保留数组容量（同一个LevelDesc反复读取时不再重新分配）
+    void clear()
+    {
+        name.clear();
+        background.clear();
+        music.clear();
+        gravityX = gravityY = 0.0f;
+        hasLevelWidth = false;
+        levelWidth = 0.0f;
+        objKeys.clear();
+        graphics.clear();
+        parallaxLayers.clear();
+        blocks.clear();
+        enemies.clear();
+        traps.clear();
+    }
+
+    // objKey对应的对象数（未知类型为0）
+    std::size_t count(const std::string& key) const
+    {
+        if (key == "GraphicObj")    return graphics.size();
+        if (key == "ParallaxLayer") return parallaxLayers.size();
+        if (key == "Block")         return blocks.size();
+        if (key == "Enemy")         return enemies.size();
+        if (key == "Trap")          return traps.size();
+        return 0;
+    }
+    // 对象的纹理路径（未知类型返回nullptr）
+    const std::string* texture(const std::string& key, std::size_t index) const
+    {
+        if (key == "GraphicObj")    return &graphics[index].texture;
+        if (key == "ParallaxLayer") return &parallaxLayers[index].texture;
+        if (key == "Block")         return &blocks[index].texture;
+        if (key == "Enemy")         return &enemies[index].texture;
+        if (key == "Trap")          return &traps[index].texture;
+        return nullptr;
+    }
+};
+
+// 关卡全局参数（对象数组由LevelReader按各自的字段表解码）
+template <>
+struct ObjectSchema<LevelDesc>
+{
+    static constexpr SchemaField<LevelDesc> fields[] = {
+        SCHEMA_STRING(LevelDesc, name,       Optional, nullptr),
+        SCHEMA_STRING(LevelDesc, background, Optional, nullptr),
+        SCHEMA_STRING(LevelDesc, music,      Optional, nullptr),
+        SCHEMA_FLOAT (LevelDesc, gravityX,   Required, 0.0f),
+        SCHEMA_FLOAT (LevelDesc, gravityY,   Required, 0.0f),
+        SCHEMA_FLOAT (LevelDesc, levelWidth, Optional, 0.0f),   // 出现时hasLevelWidth为true
+    };
+};
+static_assert(schemaIsValid<LevelDesc>(), "LevelDesc schema is inconsistent");
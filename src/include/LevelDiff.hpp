@@ -0,0 +1,178 @@
+#pragma once
+#include "LevelDesc.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 关卡对象差异：热重载时把重新读取的对象数组与当前数组逐个配对，只有新增、删除和字段改变的对象需要重建。
+// 对象有id字段时按id配对；没有时方块/敌人/陷阱按坐标、视差层按图层号配对（同一个键出现多次时按出现顺序区分），
+// 配对后按字段表逐字段比较。每种类型各建一次哈希表（键不复制字符串），耗时与对象数成线性关系
+struct LevelDiff
+{
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    std::vector<std::size_t> previous;      // 新下标 -> 配对的旧下标，新增的对象为npos
+    std::vector<std::uint8_t> changed;      // 按新下标：配对成功但字段改变
+    std::vector<std::uint8_t> kept;         // 按旧下标：是否配对成功（没有配对的被删除）
+    std::size_t added = 0;
+    std::size_t removed = 0;
+    std::size_t modified = 0;
+
+    bool empty() const { return added == 0 && removed == 0 && modified == 0; }
+    // 新对象是否可以保留原来的实例（配对成功且没有改变）
+    bool unchanged(std::size_t index) const { return previous[index] != npos && !changed[index]; }
+};
+
+namespace leveldiff {
+
+// 配对键：有id时为id（指向desc中的字符串，配对期间desc不变），否则为按位打包的坐标或图层号
+struct Key
+{
+    std::string_view id;
+    std::uint64_t position = 0;
+
+    bool operator==(const Key& other) const { return id == other.id && position == other.position; }
+};
+
+struct KeyHash
+{
+    std::size_t operator()(const Key& key) const
+    {
+        if (!key.id.empty()) {
+            return std::hash<std::string_view>()(key.id);
+        }
+        // splitmix64的混合步骤，相邻坐标的键分散到不同的桶
+        std::uint64_t h = key.position + 0x9e3779b97f4a7c15ull;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return static_cast<std::size_t>(h ^ (h >> 31));
+    }
+};
+
+// 浮点的位（-0与0视为同一个位置）
+inline std::uint32_t floatBits(float value)
+{
+    value += 0.0f;
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline Key keyOf(const ParallaxDesc& desc)
+{
+    return desc.id.empty() ? Key{ {}, static_cast<std::uint32_t>(desc.layer) } : Key{ desc.id, 0 };
+}
+
+inline Key keyOf(const GraphicDesc& desc)
+{
+    return Key{ {}, (std::uint64_t(floatBits(desc.x)) << 32) | floatBits(desc.y) };
+}
+
+// 方块、敌人、陷阱
+template <typename T>
+Key keyOf(const T& desc)
+{
+    if (!desc.id.empty()) {
+        return Key{ desc.id, 0 };
+    }
+    return Key{ {}, (std::uint64_t(floatBits(desc.x)) << 32) | floatBits(desc.y) };
+}
+
+} // namespace leveldiff
+
+template <typename T>
+LevelDiff diffLevelObjects(const std::vector<T>& before, const std::vector<T>& after)
+{
+    LevelDiff diff;
+    diff.previous.assign(after.size(), LevelDiff::npos);
+    diff.changed.assign(after.size(), 0);
+    diff.kept.assign(before.size(), 0);
+
+    // 键 -> 第一个未配对的旧下标；同键的旧对象按出现顺序用next串起来，使两边第n个同键对象互相配对
+    std::unordered_map<leveldiff::Key, std::size_t, leveldiff::KeyHash> heads;
+    std::vector<std::size_t> next(before.size(), LevelDiff::npos);
+    heads.reserve(before.size());
+    for (std::size_t i = before.size(); i-- > 0;) {
+        auto [it, inserted] = heads.emplace(leveldiff::keyOf(before[i]), i);
+        if (!inserted) {
+            next[i] = it->second;
+            it->second = i;
+        }
+    }
+
+    for (std::size_t j = 0; j < after.size(); ++j) {
+        auto it = heads.find(leveldiff::keyOf(after[j]));
+        if (it == heads.end() || it->second == LevelDiff::npos) {
+            ++diff.added;
+            continue;
+        }
+        std::size_t i = it->second;
+        it->second = next[i];
+        diff.previous[j] = i;
+        diff.kept[i] = 1;
+        if (!schemaEqual(before[i], after[j])) {
+            diff.changed[j] = 1;
+            ++diff.modified;
+        }
+    }
+    for (std::uint8_t kept : diff.kept) {
+        diff.removed += kept ? 0 : 1;
+    }
+    return diff;
+}
+
+// 修补后恢复常驻对象的绘制顺序：同一绘制优先级内按登记顺序绘制，重建的对象被追加到drawIds末尾，
+// 会画到本应盖住它的对象上面。把drawIds中属于ordered的id按ordered的顺序放回它们占据的位置
+// （其它id不动），结果与按新描述完整加载时的相对顺序一致。ordered中的npos（创建失败）跳过
+template <typename Id>
+void restoreDrawOrder(std::vector<Id>& drawIds, const std::vector<std::size_t>& ordered)
+{
+    std::vector<std::size_t> positions;
+    for (std::size_t i = 0; i < drawIds.size(); ++i) {
+        for (std::size_t slot : ordered) {
+            if (slot != LevelDiff::npos && static_cast<std::size_t>(drawIds[i]) == slot) {
+                positions.push_back(i);
+                break;
+            }
+        }
+    }
+    std::size_t next = 0;
+    for (std::size_t slot : ordered) {
+        if (slot != LevelDiff::npos && next < positions.size()) {
+            drawIds[positions[next++]] = static_cast<Id>(slot);
+        }
+    }
+}
+
+// 修补按描述顺序常驻绘制的对象（视差层）。slots为旧描述下标 -> 场景槽位（npos表示创建失败）：
+// 配对成功且未改变的保留槽位，其余旧槽位调用remove(槽位)移除，新增和改变的调用create(新下标)重建
+// （返回槽位，失败为npos）。remove/create负责维护drawIds（移除时删去槽位、创建时追加到末尾），
+// 最后按新描述的顺序调用restoreDrawOrder。返回新描述下标 -> 槽位
+template <typename Id, typename Remove, typename Create>
+std::vector<std::size_t> patchOrderedSlots(const LevelDiff& diff, const std::vector<std::size_t>& slots,
+                                           std::vector<Id>& drawIds, Remove&& remove, Create&& create)
+{
+    std::vector<std::size_t> next(diff.previous.size(), LevelDiff::npos);
+    for (std::size_t j = 0; j < next.size(); ++j) {
+        if (diff.unchanged(j)) {
+            next[j] = slots[diff.previous[j]];
+        }
+    }
+    for (std::size_t slot : slots) {
+        if (slot != LevelDiff::npos && std::find(next.begin(), next.end(), slot) == next.end()) {
+            remove(slot);
+        }
+    }
+    for (std::size_t j = 0; j < next.size(); ++j) {
+        if (!diff.unchanged(j)) {
+            next[j] = create(j);
+        }
+    }
+    restoreDrawOrder(drawIds, next);
+    return next;
+}
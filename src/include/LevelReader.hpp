@@ -0,0 +1,28 @@
+#pragma once
+#include "LevelDesc.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// 流式关卡读取器：基于nlohmann的SAX接口，边解析边按各类型的字段表（ObjectSchema）把对象写进
+// LevelDesc的类型化数组，不构建JSON DOM，也不生成中间的ResourceDict。解析前先快速扫描一遍统计每个对象数组的长度，
+// 各数组一次性预留好容量；读取器和LevelDesc都可以复用，重复读取时文件缓冲与数组容量不再重新分配
+class LevelReader
+{
+    public:
+        // 读取关卡文件并打印全部错误。缺字段、类型不符、取值无效都记录在getErrors()中并继续读取，
+        // 出错的对象不放进out；文件不存在、JSON语法错误或有任何字段错误时返回false。
+        // preferDisk为true时磁盘上的散文件优先于已挂载资源包中的同名文件（热重载）
+        bool read(const std::string& path, LevelDesc& out, bool preferDisk = false);
+        // 解析内存中的JSON文本
+        bool parse(const char* data, std::size_t size, LevelDesc& out);
+        // 最近一次读取的错误（含对象数组名、下标与字段名，如 "Block[3].x: missing required field"）
+        const std::vector<std::string>& getErrors() const { return errors; }
+
+        // 只跟踪字符串与括号，统计每个顶层对象数组中的对象数，并为out的对应数组预留容量
+        static void reserveObjects(const char* data, std::size_t size, LevelDesc& out);
+
+    private:
+        std::string buffer;                 // 文件内容（跨次读取复用）
+        std::vector<std::string> errors;
+};
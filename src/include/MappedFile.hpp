@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 只读内存映射文件（POSIX mmap / Windows CreateFileMapping）：映射期间文件内容直接按指针访问，
+// 页面在第一次访问时才由系统读入，不经过额外的缓冲区拷贝
+class MappedFile
+{
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // 映射整个文件；文件不存在、为空或映射失败时返回false（不打印，由调用方决定如何报告）
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return base != nullptr; }
+
+        const std::uint8_t* data() const { return base; }
+        std::size_t size() const { return length; }
+
+    private:
+        const std::uint8_t* base = nullptr;
+        std::size_t length = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+};
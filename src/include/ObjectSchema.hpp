@@ -0,0 +1,247 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 编译期对象结构描述：每种desc用一张constexpr字段表声明字段名、类型、是否必填、缺省值和可选取值，
+// 解码、缺省值填充和校验都由这张表生成。读取时按键名在表中找到成员指针直接写进结构体，
+// 不经过字符串键的map；缺字段、int/float不符、取值不在可选范围内都在加载时报告，
+// 不会再到对象initialize里才抛出bad_variant_access
+//
+// 声明方式（见LevelDesc.hpp）：
+//   template <> struct ObjectSchema<BlockDesc> {
+//       static constexpr SchemaField<BlockDesc> fields[] = {
+//           SCHEMA_STRING(BlockDesc, type,   Required, blockTypeNames),
+//           SCHEMA_FLOAT (BlockDesc, health, Required, 0.0f),
+//           ...
+//       };
+//   };
+//   static_assert(schemaIsValid<BlockDesc>(), "...");
+
+enum class FieldKind : std::uint8_t { Float, Int, String };
+enum class FieldRule : bool { Optional, Required };
+
+template <typename T>
+struct SchemaField
+{
+    const char* name;
+    FieldKind kind;
+    bool required;
+    float T::* floatMember;
+    int T::* intMember;
+    std::string T::* stringMember;
+    float floatDefault;
+    int intDefault;
+    const char* const* choices;     // 字符串字段的可选值（nullptr结尾），nullptr表示不限
+};
+
+// 每种desc特化一次，提供 static constexpr SchemaField<T> fields[]
+template <typename T>
+struct ObjectSchema;
+
+template <typename T>
+constexpr SchemaField<T> schemaFloat(const char* name, float T::* member, FieldRule rule, float fallback)
+{
+    return { name, FieldKind::Float, rule == FieldRule::Required, member, nullptr, nullptr, fallback, 0, nullptr };
+}
+template <typename T>
+constexpr SchemaField<T> schemaInt(const char* name, int T::* member, FieldRule rule, int fallback)
+{
+    return { name, FieldKind::Int, rule == FieldRule::Required, nullptr, member, nullptr, 0.0f, fallback, nullptr };
+}
+template <typename T>
+constexpr SchemaField<T> schemaString(const char* name, std::string T::* member, FieldRule rule,
+                                      const char* const* choices)
+{
+    return { name, FieldKind::String, rule == FieldRule::Required, nullptr, nullptr, member, 0.0f, 0, choices };
+}
+
+// 字段名与成员名相同，由宏展开成名字字符串和成员指针
+#define SCHEMA_FLOAT(T, member, rule, fallback)  schemaFloat<T>(#member, &T::member, FieldRule::rule, fallback)
+#define SCHEMA_INT(T, member, rule, fallback)    schemaInt<T>(#member, &T::member, FieldRule::rule, fallback)
+#define SCHEMA_STRING(T, member, rule, choices)  schemaString<T>(#member, &T::member, FieldRule::rule, choices)
+
+template <typename T>
+constexpr std::size_t schemaFieldCount()
+{
+    return std::size(ObjectSchema<T>::fields);
+}
+
+// 按名字查找字段下标，未知字段返回-1
+template <typename T>
+constexpr int schemaFieldIndex(std::string_view name)
+{
+    for (std::size_t i = 0; i < schemaFieldCount<T>(); ++i) {
+        if (name == ObjectSchema<T>::fields[i].name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// 编译期检查字段表：字段数不超过出现标记的位数、名字不重复、成员指针与类型一致
+template <typename T>
+constexpr bool schemaIsValid()
+{
+    if (schemaFieldCount<T>() > 32) {
+        return false;
+    }
+    for (std::size_t i = 0; i < schemaFieldCount<T>(); ++i) {
+        const SchemaField<T>& field = ObjectSchema<T>::fields[i];
+        bool memberOk = (field.kind == FieldKind::Float  && field.floatMember  != nullptr) ||
+                        (field.kind == FieldKind::Int    && field.intMember    != nullptr) ||
+                        (field.kind == FieldKind::String && field.stringMember != nullptr);
+        if (!memberOk || schemaFieldIndex<T>(field.name) != static_cast<int>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 写入全部字段的缺省值
+template <typename T>
+void applySchemaDefaults(T& object)
+{
+    for (const SchemaField<T>& field : ObjectSchema<T>::fields) {
+        switch (field.kind) {
+            case FieldKind::Float:  object.*field.floatMember = field.floatDefault; break;
+            case FieldKind::Int:    object.*field.intMember   = field.intDefault;   break;
+            case FieldKind::String: (object.*field.stringMember).clear();           break;
+        }
+    }
+}
+
+// 按字段表逐字段比较（字段表之外的成员不参与比较）
+template <typename T>
+bool schemaEqual(const T& a, const T& b)
+{
+    for (const SchemaField<T>& field : ObjectSchema<T>::fields) {
+        switch (field.kind) {
+            case FieldKind::Float:
+                if (a.*field.floatMember != b.*field.floatMember) return false;
+                break;
+            case FieldKind::Int:
+                if (a.*field.intMember != b.*field.intMember) return false;
+                break;
+            case FieldKind::String:
+                if (a.*field.stringMember != b.*field.stringMember) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+// 解析器交给解码器的标量
+struct SchemaValue
+{
+    enum Kind { Null, Bool, Int, Float, String } kind = Null;
+    double number = 0.0;
+    std::string* text = nullptr;    // String时指向调用方的字符串，写入时直接move走
+};
+
+// 单个对象的解码：begin写入缺省值，set逐字段写入，finish检查必填字段与可选取值。
+// 错误带上对象位置（如 "Block[3].x: missing required field"），同一对象的所有问题都会报告
+template <typename T>
+class SchemaDecoder
+{
+    public:
+        void begin(T& object, std::string where, std::vector<std::string>& errors)
+        {
+            target = &object;
+            context = std::move(where);
+            errorList = &errors;
+            seen = 0;
+            failed = false;
+            applySchemaDefaults(object);
+        }
+
+        // 未知字段忽略（关卡文件可以带编辑器用的附加字段）
+        void set(std::string_view key, const SchemaValue& value)
+        {
+            int index = schemaFieldIndex<T>(key);
+            if (index < 0) {
+                return;
+            }
+            const SchemaField<T>& field = ObjectSchema<T>::fields[index];
+            seen |= 1u << index;
+            switch (field.kind) {
+                case FieldKind::Float:
+                    // 整数写法（如 "x": 0）也接受
+                    if (value.kind != SchemaValue::Int && value.kind != SchemaValue::Float) {
+                        report(field.name, "expected a number");
+                        return;
+                    }
+                    target->*field.floatMember = static_cast<float>(value.number);
+                    break;
+                case FieldKind::Int:
+                    // 1.0这样的整数值浮点写法也接受
+                    if ((value.kind != SchemaValue::Int && value.kind != SchemaValue::Float) ||
+                        std::floor(value.number) != value.number || std::fabs(value.number) > 2147483647.0) {
+                        report(field.name, "expected an integer");
+                        return;
+                    }
+                    target->*field.intMember = static_cast<int>(value.number);
+                    break;
+                case FieldKind::String:
+                    if (value.kind != SchemaValue::String) {
+                        report(field.name, "expected a string");
+                        return;
+                    }
+                    target->*field.stringMember = std::move(*value.text);
+                    break;
+            }
+        }
+
+        // 返回对象是否没有任何错误
+        bool finish()
+        {
+            for (std::size_t i = 0; i < schemaFieldCount<T>(); ++i) {
+                const SchemaField<T>& field = ObjectSchema<T>::fields[i];
+                if (!(seen & (1u << i))) {
+                    if (field.required) {
+                        report(field.name, "missing required field");
+                    }
+                    continue;
+                }
+                if (field.kind == FieldKind::String && field.choices &&
+                    !isChoice(field.choices, target->*field.stringMember)) {
+                    report(field.name, "invalid value \"" + target->*field.stringMember + "\"");
+                }
+            }
+            return !failed;
+        }
+
+        // 字段是否在当前对象中出现过
+        bool has(std::string_view key) const
+        {
+            int index = schemaFieldIndex<T>(key);
+            return index >= 0 && (seen & (1u << index));
+        }
+
+    private:
+        static bool isChoice(const char* const* choices, const std::string& value)
+        {
+            for (; *choices; ++choices) {
+                if (value == *choices) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void report(const char* field, const std::string& problem)
+        {
+            failed = true;
+            errorList->push_back((context.empty() ? std::string() : context + ".") + field + ": " + problem);
+        }
+
+        T* target = nullptr;
+        std::string context;
+        std::vector<std::string>* errorList = nullptr;
+        std::uint32_t seen = 0;
+        bool failed = false;
+};
@@ -7,6 +7,7 @@
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <cstdint>
 
 class Player : public BaseObj
 {
@@ -22,11 +23,49 @@ public:
     void update() override;
     void update(float deltaTime);
     void setSpawnPosition(float x, float y);
+    // 回到出生点并恢复初始状态（复用已有的Box2D实体和贴图，Scene::reload时调用）
+    void respawn();
     void draw() override;
+    // 物理步进后实体移动了：同步sprite位置
+    void onBodyMoved(const b2Transform& transform, bool fellAsleep) override;
+    void savePreviousTransform() override;
+    void interpolateTransform(float alpha) override;
+
+    // 玩家的运行时状态（平坦结构，Scene写入回滚快照）
+    struct State
+    {
+        float x = 0.0f, y = 0.0f;       // Box2D实体中心
+        float vx = 0.0f, vy = 0.0f;
+        float health = 0.0f;
+        float invincibleTime = 0.0f;
+        float spawnProtectionTime = 0.0f;
+        float envSpeedScale = 1.0f;
+        float moveDir = 0.0f;
+        float fireCooldown = 0.0f;
+        float animTimer = 0.0f;
+        std::int32_t jumpCount = 0;
+        std::int32_t runFrame = 0;
+        std::int32_t swimFrame = 0;
+        std::uint8_t alive = 1;
+        std::uint8_t awake = 1;
+        std::uint8_t grounded = 0;
+        std::uint8_t jumpingUp = 0;
+        std::uint8_t inWater = 0;
+        std::uint8_t facingRight = 1;
+    };
+    void captureState(State& state) const;
+    // 恢复状态并同步sprite（复用已有的Box2D实体）
+    void restoreState(const State& state);
     b2ShapeId getMainShapeId() const { return m_mainShapeId; }
 
     void setMoveSpeed(float speed) { m_moveSpeed = speed; }
     void setJumpSpeed(float speed) { m_jumpSpeed = speed; }
+    void setBuoyancyAcc(float acc) { m_buoyancyAcc = acc; }
+    void setWaterDrag(float drag) { m_waterDrag = drag; }
+    float getMoveSpeed() const { return m_moveSpeed; }
+    float getJumpSpeed() const { return m_jumpSpeed; }
+    float getBuoyancyAcc() const { return m_buoyancyAcc; }
+    float getWaterDrag() const { return m_waterDrag; }
 
     //血量受伤相关接口
     void  setMaxHealth(float h);
@@ -63,6 +102,8 @@ public:
 
     bool isInWater() const { return m_inWater; }
     sf::Vector2f getPosition() const;
+    // 绘制位置（物理插值后的sprite位置），相机跟随用它才不会与画面抖动
+    sf::Vector2f getRenderPosition() const;
 
     struct ProjectileSpawnRequest {
         std::string type;      // "ICE" 或 "FIRE"
@@ -91,6 +132,10 @@ private:
     // ===== 物理相关 =====
     b2WorldId    m_world;
     b2BodyId     m_body{};
+    // 上一次与本次物理步进后的实体位置（绘制插值用）
+    sf::Vector2f m_prevBodyPos{0.0f, 0.0f};
+    sf::Vector2f m_currBodyPos{0.0f, 0.0f};
+    bool         m_blending = false;
     sf::Vector2f m_spawnPos{0.0f, 0.0f};
     b2ShapeId    m_mainShapeId = b2_nullShapeId;
 
@@ -0,0 +1,85 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 轻量性能记录器：按名字累计耗时（次数、总计、最大、最近一次），并保留最近的单次事件
+// （如每个文件的解码耗时）供逐条查看；另有按名字记录最新值的计数器（如常驻纹理的显存字节数）。
+// 可在任意线程记录，内部用互斥锁保护，
+// 只用于加载、资源管理等低频路径，不要在逐对象的热循环里调用
+class Profiler
+{
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Stat
+        {
+            std::uint64_t count = 0;
+            double totalMs = 0.0;
+            double maxMs = 0.0;
+            double lastMs = 0.0;
+        };
+        struct Event
+        {
+            std::string category;           // 如 "decode"、"upload"
+            std::string name;               // 如文件路径
+            double ms = 0.0;
+        };
+
+        // 计时作用域：析构时把经过的时间累计到name（profiler为nullptr时不记录）
+        class Scope
+        {
+            public:
+                Scope(Profiler* profiler, std::string name)
+                    : profiler(profiler), name(std::move(name)), start(Clock::now()) {}
+                ~Scope()
+                {
+                    if (profiler) {
+                        profiler->record(name, elapsedMs(start));
+                    }
+                }
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                Profiler* profiler;
+                std::string name;
+                Clock::time_point start;
+        };
+
+        // maxEvents：保留的单次事件条数，超出后丢弃最旧的
+        explicit Profiler(std::size_t maxEvents = 1024);
+
+        // 累计一次耗时
+        void record(const std::string& name, double ms);
+        // 记录一条单次事件，同时累计到category
+        void event(const std::string& category, const std::string& name, double ms);
+        // 设置计数器的当前值（覆盖上一次的值）
+        void setCounter(const std::string& name, double value);
+
+        Stat getStat(const std::string& name) const;
+        // 计数器的当前值，没有设置过时返回0
+        double getCounter(const std::string& name) const;
+        // 某类事件（category为空时返回全部），按记录顺序
+        std::vector<Event> getEvents(const std::string& category = std::string()) const;
+        // 打印全部累计统计（按总耗时降序）与计数器（按名字排序）
+        void report() const;
+        void clear();
+
+        static double elapsedMs(Clock::time_point since)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+        }
+
+    private:
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Stat> stats;
+        std::unordered_map<std::string, double> counters;
+        std::deque<Event> events;
+        std::size_t maxEvents;
+};
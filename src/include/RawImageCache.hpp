@@ -0,0 +1,85 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 解码后图片的磁盘缓存：每张源图片一个缓存文件，保存解码好的RGBA像素，
+// 下次启动时内存映射后直接交给sf::Texture::update，跳过PNG解码。
+// 缓存以源路径为键（文件名取路径哈希），头部记录源文件的大小、修改时间与内容哈希：
+// 大小和修改时间一致即命中；修改时间变了但内容哈希相同（如重新检出）仍然命中并刷新时间；
+// 否则视为过期，重新解码后覆盖。资源包中的源文件没有修改时间，按大小与内容哈希判断。
+// find与decode可在多个解码线程中同时调用（各自处理不同的源路径）
+//
+// 文件布局（小端）：Header | 源路径（pathLength字节） | 填充到16字节 | 像素（width*height*4）
+class RawImageCache
+{
+    public:
+        static constexpr std::uint32_t version   = 1;
+        static constexpr std::uint32_t alignment = 16;
+
+        struct Header
+        {
+            char magic[4];                  // "RGBA"
+            std::uint32_t version;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint64_t sourceSize;
+            std::int64_t sourceMtime;       // 资源包中的源文件为0
+            std::uint64_t sourceHash;       // 源文件内容的FNV-1a
+            std::uint32_t pathLength;
+            std::uint32_t pixelOffset;
+        };
+
+        // 一张已映射的缓存图片，像素指向映射内存，持有期间映射保持有效
+        class Entry
+        {
+            public:
+                sf::Vector2u getSize() const { return size; }
+                const std::uint8_t* getPixels() const { return pixels; }
+                // 按图片尺寸分配纹理并直接从映射内存上传
+                bool upload(sf::Texture& texture) const;
+                // 需要sf::Image时（如打包图集）复制一份像素
+                sf::Image toImage() const { return sf::Image(size, pixels); }
+
+            private:
+                friend class RawImageCache;
+                MappedFile file;
+                sf::Vector2u size;
+                const std::uint8_t* pixels = nullptr;
+        };
+
+        // directory：缓存目录，不存在时创建
+        explicit RawImageCache(std::string directory);
+
+        // 查找有效的缓存，未命中（没有缓存、源文件已修改或不存在）时返回nullptr
+        std::shared_ptr<const Entry> find(const std::string& sourcePath);
+        // 解码源文件到image并写入缓存（失败只打印，不影响image），源文件解码失败时返回false
+        bool decode(const std::string& sourcePath, sf::Image& image);
+
+        const std::string& getDirectory() const { return directory; }
+        std::uint64_t getHits() const { return hits.load(); }
+        std::uint64_t getMisses() const { return misses.load(); }
+
+    private:
+        struct SourceInfo
+        {
+            bool packed = false;            // 在已挂载的资源包中
+            std::uint64_t size = 0;
+            std::int64_t mtime = 0;
+        };
+        static bool statSource(const std::string& sourcePath, SourceInfo& info);
+        static std::uint64_t hashBytes(const void* data, std::size_t size);
+        // 读取源文件的内容哈希（资源包中直接读映射内存）
+        static bool hashSource(const std::string& sourcePath, std::uint64_t& hash);
+        std::string cachePathFor(const std::string& sourcePath) const;
+        bool store(const std::string& sourcePath, const SourceInfo& info, std::uint64_t hash,
+                   const sf::Image& image) const;
+
+        std::string directory;
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+};
@@ -1,29 +1,120 @@
 #pragma once
 #include "GameObj.hpp"
 #include "EventSys.hpp"
-#include "ResourceLoader.hpp"
+#include "LevelDesc.hpp"
 #include "GameInput.hpp"
 #include <box2d/box2d.h>
 #include <memory>
 #include <vector>
 #include <list>
 #include <variant>
+#include <atomic>
+#include <future>
+#include <unordered_map>
 #include <SFML/Graphics.hpp>
 #include "AudioManager.hpp"
+#include "TextureAtlas.hpp"
+#include "SpriteBatch.hpp"
+#include "SpatialGrid.hpp"
+#include "StaticChunkCache.hpp"
+#include "TextureCache.hpp"
+#include "RawImageCache.hpp"
+#include "TaskScheduler.hpp"
+#include "Profiler.hpp"
+#include "StaticBodyMerger.hpp"
+#include "StateBuffer.hpp"
 
 class Scene
 {   
     public:
+        // 渲染相关配置（由main从engine.ini的[Render]节读取，需在init之前设置）
+        struct RenderSettings
+        {
+            unsigned atlasPageSize = 4096;  // 纹理图集单页边长
+            unsigned atlasPadding  = 2;     // 图集子图之间的留边
+            float cullMargin       = 128.f; // 视锥剔除时视野矩形向外扩展的边距
+            float cullCellSize     = 512.f; // 剔除用空间网格的格子边长
+            unsigned bakeChunkSize = 1024;  // 静态几何烘焙区块边长，0表示不烘焙
+        };
+
+        // 关卡流式加载配置（由main从engine.ini的[Stream]节读取，需在init之前设置）
+        struct StreamSettings
+        {
+            float chunkWidth     = 2048.f;  // 关卡按x方向切分的区块宽度
+            float loadDistance   = 1024.f;  // 区块距离视野小于该值时加载
+            float unloadDistance = 2048.f;  // 区块距离视野大于该值时卸载（大于loadDistance，避免来回抖动）
+        };
+
+        // 物理步长配置（由main从engine.ini的[Engine]节读取）
+        struct TimestepSettings
+        {
+            float physicsRate = 0.f;        // 物理固定步进频率（Hz），0表示每帧用传入的deltaTime步进一次
+            int maxSteps      = 4;          // 每帧最多步进几次（卡顿时丢弃多余的累积时间，避免越追越慢）
+            bool interpolate  = true;       // 绘制时在上一步与当前步的位置之间插值
+        };
+
+        // 流式加载统计
+        struct StreamStats
+        {
+            std::size_t totalChunks  = 0;   // 关卡区块总数
+            std::size_t loadedChunks = 0;   // 当前已加载的区块数
+            std::size_t residentObjects = 0; // 当前驻留的流式对象数
+        };
+
+        // 物理统计
+        struct PhysicsStats
+        {
+            std::size_t staticTiles  = 0;   // 参与合并的静态方块数
+            std::size_t staticShapes = 0;   // 合并后的静态形状数（宽相代理数）
+            float stepMs = 0.0f;            // 本帧所有b2World_Step的总耗时
+            int steps = 0;                  // 本帧步进次数（固定频率时可能为0或多次）
+            float alpha = 1.0f;             // 本帧绘制插值系数（累积的剩余时间 / 步长）
+        };
+
+        // 回滚统计
+        struct RollbackStats
+        {
+            std::size_t frames    = 0;      // 环形缓冲中保存的帧数
+            std::size_t lastBytes = 0;      // 最近一次快照的字节数
+            float captureMs = 0.0f;         // 最近一次记录耗时
+            float restoreMs = 0.0f;         // 最近一次恢复耗时
+        };
+
+        // 视锥剔除统计（最近一次render）
+        struct CullStats
+        {
+            std::size_t visible = 0;        // 视野内提交绘制的对象数
+            std::size_t culled  = 0;        // 视野外被跳过的对象数
+            std::size_t chunks  = 0;        // 绘制的静态区块数
+        };
+
         Scene() = default;
         ~Scene() = default;
 
-        // 初始化场景
+        // 初始化场景（同步完成，阻塞到加载结束）
         virtual void init(std::string sceneConfigPath, 
                           std::weak_ptr<EventSys> eventSys, 
                           std::weak_ptr<sf::RenderWindow> window,
                           std::weak_ptr<GameInputRead> input);
-        // 重载场景
+        // 异步初始化：读文件、解析JSON、解码图片在工作线程进行，
+        // 纹理上传和对象（Box2D实体）创建由pollAsyncInit在主线程分片完成
+        void beginAsyncInit(std::string sceneConfigPath,
+                            std::weak_ptr<EventSys> eventSys,
+                            std::weak_ptr<sf::RenderWindow> window,
+                            std::weak_ptr<GameInputRead> input);
+        // 主线程每帧调用，最多占用budgetMs毫秒（0表示不限时），加载完成后返回true
+        bool pollAsyncInit(float budgetMs);
+        // 加载进度（0~1），完成后为1
+        float getLoadProgress() const;
+        bool isLoaded() const { return loadStage == LoadStage::Ready; }
+        // 重载场景：从init后记录的快照恢复关卡对象并让玩家重生，不读文件、不重建物理世界
         virtual void reload();
+        // 关卡文件在磁盘上改变后调用（热重载，须在帧边界调用）：重新读取关卡文件，只应用改变的关卡参数
+        // （重力、关卡宽度），方块/敌人/陷阱/视差层与当前对象逐个配对，只重建新增和改变的对象、移除删除的对象，
+        // 不重建物理世界、不影响玩家，未改变的对象保留运行时状态；
+        // 文件有错误（如编辑到一半）时保留当前关卡并返回false
+        bool reloadLevelFile();
+        const std::string& getConfigPath() const { return configPath; }
         // 更新场景状态
         virtual void update(const float deltaTime,const int subStepCount = 4);
         // 渲染场景内容
@@ -32,8 +123,9 @@ class Scene
         virtual void regImmEvent(const EventSys::ImmEventPriority priority, const EventSys::EventFunc& func);
         // 注册定时事件
         virtual void regTimedEvent(const sf::Time delay, const EventSys::EventFunc& func);
-        // 添加对象到场景
-        void addObject(const std::string type, const ResourceLoader::ResourceDict& objConfig);
+        // 按当前关卡levelDesc中该类型的第index个描述创建对象并添加到场景，
+        // 返回对象在sceneAssets中的下标（未知类型返回npos）
+        std::size_t addObject(const std::string& type, std::size_t index);
         // 设置玩家指针
         void setPlayerPtr(const std::shared_ptr<BaseObj>& player);
         // 获取Box2D世界ID
@@ -43,6 +135,54 @@ class Scene
         void setCameraPosition(sf::Vector2f cameraPos) { cameraPosition = cameraPos; }
         // 设置是否使用相机视差（true=关卡, false=菜单）
         void setUseParallaxWithCamera(bool use) { useParallaxWithCamera = use; }
+        // 设置渲染配置
+        void setRenderSettings(const RenderSettings& settings) { renderSettings = settings; }
+        // 获取纹理图集（init之后有效）
+        std::shared_ptr<TextureAtlas> getTextureAtlas() const { return atlas; }
+        // 获取最近一帧的剔除统计
+        const CullStats& getCullStats() const { return cullStats; }
+        // 设置流式加载配置
+        void setStreamSettings(const StreamSettings& settings) { streamSettings = settings; }
+        // 敌人模拟LOD配置（由main从engine.ini的[SimLOD]节读取）
+        void setSimLodSettings(const EnemySystem::LodSettings& settings) { lodSettings = settings; }
+        const EnemySystem::LodStats& getSimLodStats() const { return lodStats; }
+        // 是否合并相邻静态方块的碰撞（须在init之前调用）
+        void setMergeStaticBlocks(bool merge) { mergeStaticBlocks = merge; }
+        const PhysicsStats& getPhysicsStats() const { return physicsStats; }
+        // 物理步长与绘制插值配置
+        void setTimestepSettings(const TimestepSettings& settings) { timestepSettings = settings; }
+        // 设置物理世界并行求解用的任务调度器（须在init之前调用，未设置时单线程步进）
+        void setTaskScheduler(const std::shared_ptr<TaskScheduler>& scheduler) { taskScheduler = scheduler; }
+        // 设置加载时并行解码图片用的线程池（须在init之前调用，未设置时在读取线程逐个解码）
+        void setDecodeScheduler(const std::shared_ptr<TaskScheduler>& scheduler) { decodeScheduler = scheduler; }
+        // 设置性能记录器：加载时记录每个文件的解码（"decode"）与上传（"upload"）耗时
+        void setProfiler(const std::shared_ptr<Profiler>& profilerPtr) { profiler = profilerPtr; }
+        // 设置解码后图片的磁盘缓存（须在init之前调用，未设置时每次都解码PNG）
+        void setRawImageCache(const std::shared_ptr<RawImageCache>& cache) { rawImageCache = cache; }
+        // 设置纹理缓存（须在init之前调用，未设置时每个场景各用一个）：多个场景共用时由同一个预算管理常驻
+        void setTextureCache(const std::shared_ptr<TextureCache>& cache) { textureCache = cache; }
+        // 提示关卡用到的图集之外的纹理即将使用（切换回已加载的场景时调用），被驱逐的在之后的帧里分片重新加载
+        void prefetchTextures();
+        // 关卡宽度（关卡文件的levelWidth，没有时取对象的最右端），init之后有效
+        float getLevelWidth() const { return levelWidth; }
+        // 获取流式加载统计
+        const StreamStats& getStreamStats() const { return streamStats; }
+        // 最近一次reload耗时（毫秒）
+        float getLastReloadTime() const { return lastReloadMs; }
+
+        // 把完整的模拟状态（流式对象、玩家、子弹、关卡标志）写入平坦缓冲，容量不足时返回false
+        bool captureState(StateWriter& out);
+        // 从captureState写入的缓冲恢复模拟状态，格式不符时返回false且不修改场景
+        // 会增删场景对象，只能在update注册事件之前调用（例如在两帧之间）
+        bool restoreState(StateReader& in);
+        // 开启逐帧回滚：预分配frames个快照槽位，slotBytes为0时按当前关卡自动估算（init之后调用）
+        void enableRollback(std::size_t frames, std::size_t slotBytes = 0);
+        // 回放中每次update后退一帧（恢复上一帧的快照）而不是步进模拟
+        void setRewinding(bool rewinding) { rewinding_ = rewinding; }
+        bool isRewinding() const { return rewinding_; }
+        const RollbackStats& getRollbackStats() const { return rollbackStats; }
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
         // 触发玩家事件（受伤、死亡等）
         void triggerPlayerEvent(const std::string& eventType) {
@@ -64,10 +204,119 @@ class Scene
         }
 
     protected:
+        // 加载阶段：工作线程读取 -> 主线程依次创建世界、图集、独立纹理、常驻对象、视野附近的区块、收尾
+        enum class LoadStage
+        {
+            Idle,
+            Reading,
+            Setup,
+            Atlas,
+            Textures,
+            Objects,
+            Chunks,
+            Finish,
+            Ready
+        };
+        // 工作线程的读取结果：按字段表解码好的关卡描述和解码好的图片
+        struct LevelData
+        {
+            LevelDesc desc;
+            std::unordered_map<std::string, sf::Image> images;   // 按纹理路径
+            // 解码缓存命中的视差层纹理：像素留在映射内存里，上传时直接交给纹理
+            std::unordered_map<std::string, std::shared_ptr<const RawImageCache::Entry>> rawImages;
+            std::vector<std::string> atlasPaths;                 // 视差层以外的纹理（先尝试放进图集）
+        };
+        // 读取关卡文件并在decoder上并行解码其中引用的图片（可在工作线程调用，不访问场景成员）
+        static std::unique_ptr<LevelData> readLevelData(const std::string& path, std::atomic<float>* progress,
+                                                        std::shared_ptr<TaskScheduler> decoder,
+                                                        std::shared_ptr<Profiler> profiler,
+                                                        std::shared_ptr<RawImageCache> rawCache);
+        // 两种初始化共用的开始部分：设置指针、创建音频和渲染辅助对象
+        void beginInit(const std::string& sceneConfigPath,
+                       const std::weak_ptr<EventSys>& eventSys,
+                       const std::weak_ptr<sf::RenderWindow>& window,
+                       const std::weak_ptr<GameInputRead>& input);
+        // 推进主线程的加载阶段，budgetMs为0时一直执行到完成
+        bool advanceLoading(float budgetMs);
+        // 创建Box2D世界、加载字体
+        void setupWorld(const LevelDesc& level);
+        // 加载完成：烘焙、记录快照、触发场景音频、设置子弹回调
+        void finishInit();
+        // 异步加载时已解码的图片，没有时返回nullptr
+        const sf::Image* findDecodedImage(const std::string& texture) const;
+        // 异步加载时解码缓存中映射的图片，没有时返回nullptr
+        std::shared_ptr<const RawImageCache::Entry> findRawImage(const std::string& texture) const;
+        // 区块与视野矩形在x方向上的距离
+        float streamChunkDistance(std::size_t index, const sf::FloatRect& focus) const;
+        // 把工作线程解码好的小纹理打包成图集（视差层使用重复纹理，不参与打包）
+        void buildTextureAtlas(const LevelData& level);
+        // 把sceneAssets中的对象登记到剔除网格（不可剔除的对象每帧都绘制）
+        void indexObjectForCulling(std::size_t index);
+        // 清空剔除相关的索引
+        void clearCullingIndex();
+        // 当前相机视野矩形（含边距）
+        sf::FloatRect getCullingRect() const;
+        // 重建待重建的烘焙区块，RenderTexture不可用时退回逐个绘制
+        void bakeStaticGeometry();
+        // 给对象设置图集、合批渲染器和纹理缓存指针
+        void attachRenderPtrs(BaseObj& obj);
+        // 把对象放进sceneAssets（优先复用空位），返回下标
+        std::size_t storeObject(std::shared_ptr<BaseObj> obj);
+        // 下一个storeObject会使用的下标
+        std::size_t nextObjectSlot() const;
+        // 从场景移除对象：销毁物理实体，从剔除/烘焙索引中移除，空出下标
+        void removeObject(std::size_t slot);
+
+        // 流式加载的对象类型（方块、敌人、陷阱），其它对象常驻
+        static bool isStreamedType(const std::string& type);
+        // 按x坐标把流式对象分配到区块，并确定关卡宽度
+        void buildStreamChunks(const LevelDesc& level);
+        // 物理步进后读取Box2D的移动事件，只通知实体移动过的对象同步sprite
+        void syncTransforms();
+        // 每次物理步进之前记录动态实体（玩家、敌人）的当前位置
+        void savePreviousTransforms();
+        // 绘制前按插值系数把动态实体的sprite放到上一步与当前步之间
+        void interpolateTransforms(float alpha);
+        // 清空固定步进的累积时间与插值系数（reload、回滚恢复后从当前状态重新计时，不补步进）
+        void resetFixedStep();
+        // 剔除并提交本帧的绘制（render注册到POST_UPDATE执行，此时本帧的步进与更新都已完成）
+        void submitDraws();
+        // 根据视野加载/卸载区块
+        void updateStreaming(const sf::FloatRect& focus);
+        void loadStreamChunk(std::size_t index);
+        void unloadStreamChunk(std::size_t index);
+        std::size_t streamChunkIndexFor(float x) const;
+        // 记录关卡初始状态快照（init完成后调用一次）
+        void captureSnapshot();
+        // 按配置创建流式对象，有运行时状态时再恢复，返回下标
+        std::size_t instantiateStreamObject(std::uint32_t uid);
+        // 热重载：把next中的流式对象和视差层与levelDesc配对，只重建改变的对象，然后用next的数组替换levelDesc的
+        void patchLevelObjects(LevelDesc& next);
+        // 流式对象当前应归属的区块（有运行时状态时按记录的位置）
+        std::size_t streamChunkFor(std::uint32_t uid) const;
+        // 把当前状态写入回滚环形缓冲（每帧对象更新之后）
+        void recordRollbackFrame();
+        // 回放一帧：恢复环形缓冲中最新的快照（最旧的一帧保留）
+        void rewindFrame();
+
         // 场景中的游戏对象列表
         std::vector<std::shared_ptr<BaseObj>> sceneAssets;
         // Box2D物理世界生成器
         b2WorldDef worldDef;
+        // Box2D求解任务的调度器（多个场景共享同一组工作线程）
+        std::shared_ptr<TaskScheduler> taskScheduler;
+        // 加载时解码图片的线程池（与物理求解分开，后台加载时不和主线程的步进争用）
+        std::shared_ptr<TaskScheduler> decodeScheduler;
+        std::shared_ptr<Profiler> profiler;
+        // 解码后图片的磁盘缓存（多个场景共享）
+        std::shared_ptr<RawImageCache> rawImageCache;
+        // 静态方块碰撞合并（按流式区块分组，每组一个静态实体）
+        bool mergeStaticBlocks = true;
+        std::shared_ptr<StaticBodyMerger> staticMerger;
+        PhysicsStats physicsStats;
+        // 固定频率步进：尚未模拟的累积时间
+        TimestepSettings timestepSettings;
+        float physicsAccumulator = 0.0f;
         // Box2D物理世界
         std::shared_ptr<b2WorldId> world;
         // EventSys指针
@@ -97,4 +346,91 @@ class Scene
         sf::Vector2f cameraPosition = {0.0f, 0.0f};
         // 是否使用相机视差（true=关卡模式, false=菜单模式）
         bool useParallaxWithCamera = false;
+        // 渲染配置
+        RenderSettings renderSettings;
+        // 纹理图集（加载时构建一次，reload时复用）
+        std::shared_ptr<TextureAtlas> atlas;
+        // 合批渲染器
+        std::shared_ptr<SpriteBatch> spriteBatch;
+        // 视锥剔除：可剔除对象按sceneAssets下标登记到网格
+        SpatialGrid cullGrid;
+        std::vector<std::uint32_t> dynamicCullIds;   // 会移动的对象，每帧刷新包围盒
+        std::vector<std::uint32_t> alwaysDrawIds;    // 不参与剔除的对象（视差层等）
+        std::vector<std::uint32_t> visibleIds;       // 本帧可见对象（复用内存）
+        CullStats cullStats;
+        // 静态几何烘焙区块（方块、背景图形）
+        std::shared_ptr<StaticChunkCache> staticChunks;
+        bool bakeFailed = false;
+        // 图集之外的纹理缓存（流式对象反复加载时共享纹理）
+        std::shared_ptr<TextureCache> textureCache;
+        // 敌人的组件数据（SoA），每帧由EnemySystem整体更新一次
+        std::shared_ptr<EntityStore> entities;
+        // 方块的组件数据（SoA），玩家接触判定由BlockSystem扫描
+        std::shared_ptr<BlockStore> blockStore;
+        // 敌人模拟LOD：按与视野的距离决定逐帧/降频/冻结
+        EnemySystem::LodSettings lodSettings;
+        EnemySystem::LodStats lodStats;
+        // sceneAssets中被卸载对象留下的空位
+        std::vector<std::size_t> freeSlots;
+        // 视差层在sceneAssets中的下标（按levelDesc.parallaxLayers的下标）
+        std::vector<std::size_t> parallaxSlots;
+
+        // 关卡流式加载：每个流式对象有固定的uid，配置只读（levelDesc中的描述），运行时状态放在objectStates中
+        // 未加载区块记录对象uid，已加载区块记录对象下标及其uid
+        struct StreamObject
+        {
+            std::string type;
+            std::uint32_t index = 0;            // 在levelDesc对应类型数组中的下标
+            std::size_t homeChunk = 0;          // 按配置坐标归属的区块
+        };
+        struct LiveObject
+        {
+            std::size_t slot;
+            std::uint32_t uid;
+        };
+        struct StreamChunk
+        {
+            std::vector<std::uint32_t> objects; // 未加载的对象
+            std::vector<LiveObject> live;       // 已加载的对象
+            bool loaded = false;
+        };
+        StreamSettings streamSettings;
+        LevelDesc levelDesc;                        // 当前关卡的对象描述，创建对象和reload都从这里读取
+        std::vector<StreamObject> streamObjects;    // 按uid索引
+        std::vector<ObjectState> objectStates;      // 按uid索引，valid为0表示仍是配置中的初始状态
+        std::vector<StreamChunk> streamChunks;
+        StreamStats streamStats;
+        float levelWidth = 0.0f;
+
+        // 关卡初始状态快照：每个区块的对象uid，以及图集外的纹理句柄
+        struct LevelSnapshot
+        {
+            std::vector<std::vector<std::uint32_t>> chunkObjects;       // 每个区块的对象
+            std::vector<std::shared_ptr<const sf::Texture>> textures;   // 持有图集外的纹理，reload时不再读文件
+            bool valid = false;
+        };
+        LevelSnapshot snapshot;
+        float lastReloadMs = 0.0f;
+
+        // 逐帧回滚：预分配的快照环形缓冲，以及恢复时复用的临时数组
+        SnapshotRing rollbackRing;
+        bool rollbackEnabled = false;
+        bool rewinding_ = false;
+        RollbackStats rollbackStats;
+        std::vector<ObjectState> restoreStates;
+        std::vector<ObjectState> projectileStates;
+        std::vector<std::uint8_t> liveMarks;
+
+        // 加载状态（readProgress由工作线程写入，必须在loadFuture之前声明）
+        LoadStage loadStage = LoadStage::Idle;
+        std::atomic<float> readProgress{0.0f};
+        std::future<std::unique_ptr<LevelData>> loadFuture;
+        std::unique_ptr<LevelData> levelData;
+        std::size_t loadKeyCursor = 0;      // 正在创建的常驻对象类型
+        std::size_t loadObjectCursor = 0;   // 该类型中下一个对象
+        std::size_t loadTextureCursor = 0;  // 下一张要上传的独立纹理
+        std::size_t loadChunkCursor = 0;    // 下一个要检查的区块
+        sf::FloatRect loadFocus;            // 初始加载区块所用的视野
+        // 加载期间持有的独立纹理（对象和快照取得引用后释放）
+        std::vector<std::shared_ptr<const sf::Texture>> preloadedTextures;
 };
\ No newline at end of file
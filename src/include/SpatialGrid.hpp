@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 均匀网格空间索引：按固定边长的格子登记对象包围盒，用于按矩形区域快速查询对象
+// （视锥剔除等）。对象用调用方给定的整数id标识
+class SpatialGrid
+{
+    public:
+        explicit SpatialGrid(float cellSize = 512.0f);
+        ~SpatialGrid();
+
+        // 清空所有对象
+        void clear();
+        // 设置格子边长（会清空已有对象）
+        void setCellSize(float size);
+        // 登记对象，id已存在时等同于update
+        void insert(std::uint32_t id, const sf::FloatRect& bounds);
+        // 更新对象包围盒，所在格子不变时只更新矩形
+        void update(std::uint32_t id, const sf::FloatRect& bounds);
+        // 移除对象
+        void remove(std::uint32_t id);
+        // 查询与area相交的对象，结果按id升序追加到out
+        void query(const sf::FloatRect& area, std::vector<std::uint32_t>& out) const;
+        // 是否登记了该id
+        bool contains(std::uint32_t id) const;
+        // 当前登记的对象数
+        std::size_t size() const { return count; }
+
+    private:
+        struct Entry
+        {
+            sf::FloatRect bounds;
+            int minX = 0, minY = 0, maxX = -1, maxY = -1;  // 覆盖的格子范围
+            bool active = false;
+        };
+
+        // 负的格子坐标按补码的位拼接（移位在无符号数上进行）
+        static std::uint64_t cellKey(int x, int y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+                   static_cast<std::uint32_t>(y);
+        }
+        int toCell(float v) const;
+        void link(std::uint32_t id, const Entry& entry);
+        void unlink(std::uint32_t id, const Entry& entry);
+
+        float cellSize;
+        std::size_t count = 0;
+        std::vector<Entry> entries;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells;
+        // 查询去重用的时间戳（一个对象可能跨多个格子）
+        mutable std::vector<std::uint32_t> stamps;
+        mutable std::uint32_t queryStamp = 0;
+};
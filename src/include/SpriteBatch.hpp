@@ -0,0 +1,62 @@
+#pragma once
+#include "EventSys.hpp"
+#include "TextureCache.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 精灵合批渲染器：绘制阶段按（图层优先级, 纹理）收集精灵，
+// 每个批次在对应优先级的即时事件中用一个顶点数组一次性绘制
+class SpriteBatch : public std::enable_shared_from_this<SpriteBatch>
+{
+    public:
+        SpriteBatch();
+        ~SpriteBatch();
+
+        void setPtrs(const std::weak_ptr<EventSys>& eventSys,
+                     const std::weak_ptr<sf::RenderWindow>& window);
+        // 设置纹理缓存：每个批次绘制前通知缓存纹理被使用（被驱逐的纹理在这里重新加载）
+        void setTextureCache(const std::weak_ptr<TextureCache>& cache) { textureCachePtr = cache; }
+        // 提交精灵到指定图层，顶点在该图层的绘制事件执行时才根据精灵的当前状态生成，
+        // 因此精灵必须在本帧的即时事件执行完之前保持有效
+        // dirty为false表示精灵自上一帧起没有变化：若上一帧同一位置也是它，直接沿用已有顶点
+        void submit(EventSys::ImmEventPriority layer, const sf::Sprite& sprite, bool dirty = true);
+        // 累计重新生成顶点的精灵数 / 沿用上一帧顶点的精灵数
+        std::size_t getRebuiltQuads() const { return rebuiltQuads; }
+        std::size_t getReusedQuads() const { return reusedQuads; }
+
+    private:
+        // 同一图层内使用同一纹理的精灵
+        struct Batch
+        {
+            const sf::Texture* texture = nullptr;
+            std::vector<const sf::Sprite*> sprites;
+            std::vector<std::uint8_t> dirty;
+            // 上一帧各位置的精灵，与本帧相同且未变化时跳过顶点生成
+            std::vector<const sf::Sprite*> lastSprites;
+            // 跨帧复用的顶点数组，避免每帧重新分配内存
+            sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+        };
+        struct Layer
+        {
+            std::vector<Batch> batches;
+            bool flushRegistered = false;
+        };
+
+        // 生成顶点并绘制该图层的所有批次
+        void flush(std::size_t layerIndex);
+        // 把精灵的四个角（已应用翻转/缩放/旋转变换）写入两个三角形
+        static void appendQuad(sf::Vertex* out, const sf::Sprite& sprite);
+
+        static constexpr std::size_t LayerCount =
+            static_cast<std::size_t>(EventSys::ImmEventPriority::DRAWPLAYER) + 1;
+        std::array<Layer, LayerCount> layers;
+        std::size_t rebuiltQuads = 0;
+        std::size_t reusedQuads = 0;
+
+        std::weak_ptr<EventSys> eventSysPtr;
+        std::weak_ptr<sf::RenderWindow> windowPtr;
+        std::weak_ptr<TextureCache> textureCachePtr;
+};
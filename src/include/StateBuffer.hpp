@@ -0,0 +1,107 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// 状态序列化用的平坦内存读写器：只支持可平凡拷贝的类型，直接按字节拷贝，
+// 不做任何堆分配。容量不足/数据不足时置失败标志，之后的读写全部忽略
+class StateWriter
+{
+    public:
+        StateWriter(std::uint8_t* data, std::size_t capacity)
+            : data(data), capacity(capacity) {}
+
+        void writeBytes(const void* src, std::size_t size)
+        {
+            if (failed || length + size > capacity) {
+                failed = true;
+                return;
+            }
+            std::memcpy(data + length, src, size);
+            length += size;
+        }
+        template <typename T>
+        void write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "StateWriter only writes trivially copyable types");
+            writeBytes(&value, sizeof(T));
+        }
+
+        bool ok() const { return !failed; }
+        std::size_t size() const { return length; }
+
+    private:
+        std::uint8_t* data;
+        std::size_t capacity;
+        std::size_t length = 0;
+        bool failed = false;
+};
+
+class StateReader
+{
+    public:
+        StateReader() = default;
+        StateReader(const std::uint8_t* data, std::size_t size)
+            : data(data), length(size) {}
+
+        void readBytes(void* dst, std::size_t size)
+        {
+            if (failed || offset + size > length) {
+                failed = true;
+                return;
+            }
+            std::memcpy(dst, data + offset, size);
+            offset += size;
+        }
+        template <typename T>
+        void read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "StateReader only reads trivially copyable types");
+            readBytes(&value, sizeof(T));
+        }
+
+        bool ok() const { return !failed; }
+        std::size_t remaining() const { return length - offset; }
+
+    private:
+        const std::uint8_t* data = nullptr;
+        std::size_t length = 0;
+        std::size_t offset = 0;
+        bool failed = false;
+};
+
+// 快照环形缓冲：预先分配 slotCount 个固定容量的槽位，新快照覆盖最旧的一个
+class SnapshotRing
+{
+    public:
+        SnapshotRing() = default;
+        SnapshotRing(std::size_t slotCount, std::size_t slotCapacity);
+
+        // 重新分配槽位（清空已有快照）
+        void reset(std::size_t slotCount, std::size_t slotCapacity);
+        // 清空快照（保留内存）
+        void clear();
+        // 取得下一个槽位的写入器，写完后调用commit
+        StateWriter beginWrite();
+        // 提交最近一次beginWrite写入的数据，写入失败（容量不足）时丢弃
+        bool commit(const StateWriter& writer);
+        // 读取倒数第back个快照（0为最新）
+        bool peek(std::size_t back, StateReader& out) const;
+        // 取出并移除最新的快照（回放时逐帧后退）
+        bool pop(StateReader& out);
+
+        std::size_t size() const { return count; }
+        std::size_t slotCount() const { return lengths.size(); }
+        std::size_t slotCapacity() const { return capacity; }
+
+    private:
+        std::size_t slotIndex(std::size_t back) const;
+
+        std::vector<std::uint8_t> storage;
+        std::vector<std::size_t> lengths;
+        std::size_t capacity = 0;
+        std::size_t head = 0;   // 下一个写入的槽位
+        std::size_t count = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <box2d/box2d.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 静态碰撞合并：关卡中的静态方块（瓦片）不再各自创建Box2D实体，
+// 而是按分组（流式区块）收集碰撞矩形，把同材质且相邻的矩形合并成长条/大块，
+// 每个分组只创建一个静态实体，减少宽相代理数量并消除相邻方块之间的接缝
+class StaticBodyMerger
+{
+    public:
+        // 瓦片碰撞矩形（世界坐标）与材质（写入形状的userMaterialId）
+        struct Tile
+        {
+            float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+            int material = 0;
+        };
+        struct Stats
+        {
+            std::size_t tiles  = 0;     // 登记的瓦片数
+            std::size_t shapes = 0;     // 合并后的形状数（宽相代理数）
+            std::size_t bodies = 0;     // 静态实体数
+        };
+
+        StaticBodyMerger();
+        ~StaticBodyMerger();
+
+        // 设置物理世界（切换世界前应先clear）
+        void setWorld(b2WorldId worldId) { world = worldId; }
+        // 登记/移除瓦片，所在分组标记为需要重建
+        void addTile(std::uint32_t tileId, std::uint32_t group, const Tile& tile);
+        void removeTile(std::uint32_t tileId);
+        // 重建所有被标记的分组（会创建/销毁Box2D实体，必须在物理步进之外调用）
+        void rebuildDirty();
+        // 销毁全部合并实体并清空登记
+        void clear();
+        const Stats& getStats() const { return stats; }
+
+        // 合并矩形：先把同材质、同上下边且首尾相接的矩形合并成横条，再把同材质、同左右边且上下相接的横条合并
+        static std::vector<Tile> mergeTiles(std::vector<Tile> tiles);
+
+    private:
+        struct Group
+        {
+            std::unordered_map<std::uint32_t, Tile> tiles;
+            b2BodyId body = b2_nullBodyId;
+            std::size_t shapes = 0;
+            bool dirty = false;
+        };
+
+        void rebuildGroup(Group& group);
+
+        b2WorldId world = b2_nullWorldId;
+        std::unordered_map<std::uint32_t, Group> groups;
+        std::unordered_map<std::uint32_t, std::uint32_t> tileGroups;   // 瓦片 -> 分组
+        std::vector<std::uint32_t> dirtyGroups;
+        Stats stats;
+};
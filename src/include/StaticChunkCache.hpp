@@ -0,0 +1,79 @@
+#pragma once
+#include "EventSys.hpp"
+#include "TextureCache.hpp"
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// 静态几何烘焙缓存：把初始化后不再移动的精灵（方块、背景图形）按固定尺寸的区块
+// 预先绘制到RenderTexture中，之后每帧只绘制与视野相交的区块。
+// 对象被破坏、加入或移除时只重建它覆盖到的区块
+class StaticChunkCache : public std::enable_shared_from_this<StaticChunkCache>
+{
+    public:
+        explicit StaticChunkCache(unsigned chunkSize = 1024);
+        ~StaticChunkCache();
+
+        void setPtrs(const std::weak_ptr<EventSys>& eventSys,
+                     const std::weak_ptr<sf::RenderWindow>& window);
+        // 设置纹理缓存：重建区块时先确保精灵的纹理在显存中（烘焙后源纹理不再每帧绘制，可以被驱逐）
+        void setTextureCache(const std::weak_ptr<TextureCache>& cache) { textureCachePtr = cache; }
+        // 设置区块边长（会清空缓存）
+        void setChunkSize(unsigned size);
+        // 清空所有登记的精灵和区块
+        void clear();
+        // 登记静态精灵，sprite在invalidate/remove之前必须保持有效；覆盖的区块标记为待重建
+        void add(std::uint32_t id, EventSys::ImmEventPriority layer, const sf::Sprite* sprite);
+        // 立即重建所有待重建的区块，RenderTexture创建失败时返回false
+        bool bake();
+        // 对象被破坏：不再绘制该精灵，它覆盖的区块在下次绘制前重建
+        void invalidate(std::uint32_t id);
+        // 对象被卸载：从缓存中移除，它覆盖的区块在下次绘制前重建（没有精灵的区块释放RenderTexture）
+        void remove(std::uint32_t id);
+        // 重建脏区块，并为与视野相交的区块注册绘制事件
+        void draw(const sf::FloatRect& viewRect);
+        // 是否登记了该id
+        bool contains(std::uint32_t id) const { return members.count(id) > 0; }
+
+        std::size_t getChunkCount() const { return chunks.size(); }
+        std::size_t getDrawnChunkCount() const { return drawnChunks; }
+
+    private:
+        struct Member
+        {
+            EventSys::ImmEventPriority layer;
+            const sf::Sprite* sprite = nullptr;
+            sf::FloatRect bounds;
+            bool alive = true;
+            std::vector<std::size_t> chunks;    // 覆盖到的区块下标
+        };
+        struct Chunk
+        {
+            EventSys::ImmEventPriority layer;
+            sf::Vector2i coord;                 // 区块坐标（以chunkSize为单位）
+            std::vector<std::uint32_t> members; // 按登记顺序绘制
+            std::size_t aliveCount = 0;
+            std::unique_ptr<sf::RenderTexture> target;
+            bool dirty = true;
+        };
+        using ChunkKey = std::tuple<int, int, int>;
+
+        // 重新绘制一个区块，需要时创建RenderTexture
+        bool rebakeChunk(Chunk& chunk);
+        sf::FloatRect chunkRect(const Chunk& chunk) const;
+
+        unsigned chunkSize;
+        std::size_t drawnChunks = 0;
+        std::unordered_map<std::uint32_t, Member> members;
+        std::vector<Chunk> chunks;
+        std::map<ChunkKey, std::size_t> chunkIndex;
+        // 本帧各图层需要绘制的区块（复用内存）
+        std::map<int, std::vector<std::size_t>> visibleByLayer;
+
+        std::weak_ptr<EventSys> eventSysPtr;
+        std::weak_ptr<sf::RenderWindow> windowPtr;
+        std::weak_ptr<TextureCache> textureCachePtr;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取任务调度器：一个任务是下标区间[0, itemCount)，提交时切成若干区段分散到各线程的队列，
+// 线程优先从自己队列尾部取区段，空闲时从其它线程队列头部窃取；等待任务的线程（下标0）也参与执行。
+// 接口与Box2D的enqueueTask/finishTask回调一致，可直接挂到b2WorldDef上并行求解
+class TaskScheduler
+{
+    public:
+        // 区段回调：处理[begin, end)，worker为执行线程下标（0为提交任务的线程）
+        using RangeFunc = void (*)(int begin, int end, std::uint32_t worker, void* context);
+        struct Task;
+
+        // workerCount包含调用线程本身，0表示使用全部硬件线程
+        explicit TaskScheduler(int workerCount = 0);
+        ~TaskScheduler();
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+        int getWorkerCount() const { return workerCount; }
+        // 提交任务，区段长度不小于minRange；工作量太小或只有一个线程时直接在调用线程执行并返回nullptr
+        // submit与wait只能在同一个线程（0号）调用
+        Task* submit(RangeFunc func, int itemCount, int minRange, void* context);
+        // 等待任务完成，调用线程在等待期间执行队列中的区段
+        void wait(Task* task);
+
+        // Box2D回调（userContext为TaskScheduler指针）
+        static void* enqueueBox2DTask(RangeFunc task, int itemCount, int minRange, void* taskContext, void* userContext);
+        static void finishBox2DTask(void* userTask, void* userContext);
+
+        struct Task
+        {
+            RangeFunc func = nullptr;
+            void* context = nullptr;
+            std::atomic<int> remaining{0};   // 尚未执行完的区段数
+        };
+
+    private:
+        struct WorkItem
+        {
+            Task* task;
+            int begin;
+            int end;
+        };
+        // 每个线程一个队列（互斥锁保护的双端队列）
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<WorkItem> items;
+        };
+
+        // 取一个区段执行（先自己的队列，再窃取），没有可执行的区段时返回false
+        bool runOne(std::uint32_t worker);
+        void workerLoop(std::uint32_t worker);
+        Task* acquireTask();
+        void releaseTask(Task* task);
+
+        int workerCount = 1;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> threads;
+        // 任务对象池（指针在调度器生命周期内保持有效）
+        std::vector<std::unique_ptr<Task>> taskPool;
+        std::vector<Task*> freeTasks;
+        std::mutex taskMutex;
+        // 队列中尚未被取走的区段数，工作线程据此决定是否休眠
+        std::atomic<int> pendingItems{0};
+        std::atomic<bool> stopping{false};
+        std::mutex sleepMutex;
+        std::condition_variable wakeUp;
+        std::uint32_t nextQueue = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+// 运行期纹理图集：在场景加载时把关卡引用的小纹理打包进一张或几张大纹理（页）
+// 打包完成后对象的Sprite直接引用图集页 + 子矩形，同一页上的精灵可以合批绘制
+class TextureAtlas
+{
+    public:
+        // 图集中的一个子区域
+        struct Region
+        {
+            int page = -1;          // 所在页索引
+            sf::IntRect rect;       // 页内像素矩形（不含留边）
+        };
+
+        // pageSize: 单页边长（会被限制在显卡支持的最大尺寸内） padding: 子图之间的留边像素
+        explicit TextureAtlas(unsigned pageSize = 4096, unsigned padding = 2);
+        ~TextureAtlas();
+
+        // 登记一个需要打包的纹理文件（重复登记同一路径会被忽略）
+        bool addFile(const std::string& path);
+        // 登记一张已经解码好的图片
+        void addImage(const std::string& path, const sf::Image& image);
+        // 执行打包并上传到GPU，之后不能再登记新图片
+        void build();
+        // 查询路径对应的子区域，不在图集中（过大或加载失败）返回nullptr
+        const Region* find(const std::string& path) const;
+        // 获取图集页纹理
+        const sf::Texture& getPage(int page) const;
+        std::size_t getPageCount() const { return pages.size(); }
+        bool isBuilt() const { return built; }
+        // 判断一张图片是否适合放进图集（太大的图片单独作为纹理更划算）
+        bool accepts(sf::Vector2u size) const;
+
+    private:
+        // 天际线节点：从x开始宽度为width的一段，当前高度为y
+        struct SkylineNode
+        {
+            int x;
+            int y;
+            int width;
+        };
+        // 单页的天际线打包器
+        struct PageBuilder
+        {
+            std::vector<SkylineNode> skyline;
+            int usedHeight = 0;
+            std::vector<std::size_t> members;   // 放进这一页的待打包图片下标
+        };
+        struct PendingImage
+        {
+            std::string path;
+            sf::Image image;
+            Region region;
+        };
+
+        // 在某一页中为 w*h 的矩形寻找位置（bottom-left 启发式），找不到返回false
+        bool findPosition(const PageBuilder& page, int w, int h, int& outX, int& outY, std::size_t& outNode) const;
+        // 放置矩形后更新天际线
+        void placeRect(PageBuilder& page, std::size_t node, int x, int y, int w, int h);
+        // 把子图连同一像素的边缘外扩拷贝到页图片中，避免采样时串色
+        void blitWithExtrude(sf::Image& pageImage, const sf::Image& src, sf::Vector2u dest) const;
+
+        unsigned pageSize;
+        unsigned padding;
+        bool built = false;
+        std::vector<PendingImage> pending;
+        std::unordered_map<std::string, std::size_t> pathIndex;
+        // 图集页纹理（用unique_ptr保证地址稳定，Sprite保存的是纹理引用）
+        std::vector<std::unique_ptr<sf::Texture>> pages;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include "Profiler.hpp"
+#include "RawImageCache.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// 纹理缓存与常驻管理：按路径共享纹理，并记录每张纹理占用的显存（GPU）与保留的像素内存（CPU）。
+// 超出预算时，按最近一次绘制的帧号驱逐最久没有绘制、且最近若干帧内没有用到的纹理：
+// 驱逐只释放显存，纹理对象本身（以及引用它的精灵）保持有效，下次绘制（touch）或取得时按需重新加载，
+// 也可以用prefetch提前提示，在每帧的update中分片加载。
+// 菜单与关卡共用同一个实例时，切换到关卡后菜单的大纹理会在预算紧张时被驱逐。
+// 图集页与烘焙区块不能按路径重新生成，不由这里管理
+class TextureCache
+{
+    public:
+        // 预算（字节，0表示不限制）
+        struct Budget
+        {
+            std::size_t gpuBytes = 0;
+            std::size_t cpuBytes = 0;
+            // 最近这么多帧内绘制过的纹理视为正在使用，不会被驱逐
+            std::uint32_t idleFrames = 2;
+        };
+        struct Stats
+        {
+            std::size_t textures = 0;           // 条目数（含已驱逐的）
+            std::size_t resident = 0;           // 当前在显存中的纹理数
+            std::size_t gpuBytes = 0;
+            std::size_t cpuBytes = 0;
+            std::uint64_t evictions = 0;
+            std::uint64_t reloads = 0;          // 驱逐后重新加载的次数（按需与预取）
+            std::uint64_t prefetches = 0;
+        };
+
+        TextureCache();
+        ~TextureCache();
+
+        void setBudget(const Budget& value) { budget = value; }
+        // 设置解码缓存：重新加载时先映射缓存中的像素，未命中时解码并写入缓存
+        void setRawImageCache(const std::shared_ptr<RawImageCache>& cache) { rawCache = cache; }
+        // 设置性能记录器：重新加载的耗时记为"reload"事件，常驻统计写入"Residency.*"计数器
+        void setProfiler(const std::shared_ptr<Profiler>& profilerPtr) { profiler = profilerPtr; }
+
+        // 获取路径对应的纹理，未加载或已被驱逐时从文件加载，失败返回nullptr
+        // repeated：纹理重复平铺（视差层），重新加载时保持
+        std::shared_ptr<const sf::Texture> acquire(const std::string& path, bool repeated = false);
+        // 用已经解码好的图片创建纹理（只上传，不读文件），已存在时直接返回（被驱逐的用它重新上传）
+        std::shared_ptr<const sf::Texture> insert(const std::string& path, const sf::Image& image,
+                                                  bool repeated = false);
+        // 用解码缓存中映射的像素创建纹理；映射保留为CPU副本，驱逐后重新加载时直接上传
+        std::shared_ptr<const sf::Texture> insert(const std::string& path,
+                                                  std::shared_ptr<const RawImageCache::Entry> raw,
+                                                  bool repeated = false);
+
+        // 记录纹理在本帧被绘制（合批渲染器、静态区块、视差层在绘制前调用），已被驱逐时立即重新加载；
+        // 不是由缓存管理的纹理（如图集页）忽略
+        void touch(const sf::Texture* texture);
+        // 提示路径对应的纹理即将使用：已被驱逐时排队，在之后的update中重新加载
+        void prefetch(const std::string& path);
+        // 每帧结束时调用一次：推进帧号，在budgetMs内处理预取队列（0表示全部处理），超出预算时驱逐
+        void update(float budgetMs);
+
+        const Stats& getStats() const { return stats; }
+        // 清理只被缓存自己引用、且已被驱逐的条目
+        void purge();
+        // 当前仍被外部引用的纹理数
+        std::size_t size() const;
+
+    private:
+        struct Entry
+        {
+            std::string path;
+            // 纹理对象的地址在驱逐与重新加载之间保持不变，精灵一直引用它
+            std::shared_ptr<sf::Texture> texture;
+            // 保留的CPU像素（解码缓存的映射），没有时重新加载需要读文件
+            std::shared_ptr<const RawImageCache::Entry> raw;
+            bool repeated = false;
+            bool resident = false;
+            bool evicted = false;               // 被驱逐过，下次加载计为重新加载
+            bool queued = false;                // 在预取队列中
+            std::uint64_t lastUsed = 0;         // 最近一次绘制或取得时的帧号
+        };
+
+        Entry* findEntry(const std::string& path);
+        Entry& createEntry(const std::string& path, bool repeated);
+        void removeEntry(const std::string& path);
+        // 替换条目的CPU副本并更新CPU字节数
+        void setRaw(Entry& entry, std::shared_ptr<const RawImageCache::Entry> raw);
+        // 把像素上传到条目的纹理（优先使用CPU副本），更新常驻统计
+        bool load(Entry& entry, const sf::Image* image);
+        void evict(Entry& entry);
+        // 超出预算时按最近使用的帧号从旧到新驱逐
+        void enforceBudget();
+        void publishStats() const;
+        static std::size_t textureBytes(const sf::Texture& texture);
+        static std::size_t rawBytes(const Entry& entry);
+
+        std::unordered_map<std::string, Entry> entries;
+        // 纹理对象地址 -> 条目，touch时查找（unordered_map的节点地址在插入其它元素后保持不变）
+        std::unordered_map<const sf::Texture*, Entry*> byTexture;
+        std::deque<std::string> prefetchQueue;
+        Budget budget;
+        Stats stats;
+        std::uint64_t frame = 1;
+        std::shared_ptr<RawImageCache> rawCache;
+        std::shared_ptr<Profiler> profiler;
+};
@@ -0,0 +1,294 @@
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
+
+// 文件头与索引按字节写入、按指针直接读取，布局必须固定
+static_assert(sizeof(AssetPack::Header) == 48, "AssetPack::Header layout changed");
+static_assert(sizeof(AssetPack::Entry) == 32, "AssetPack::Entry layout changed");
+static_assert(std::is_trivially_copyable<AssetPack::Entry>::value, "entries must be trivially copyable");
+
+namespace {
+
+void writePadding(std::ofstream& out, std::uint64_t& offset, std::uint32_t alignment)
+{
+    static const char zeros[AssetPack::alignment] = {};
+    std::uint64_t padding = (alignment - offset % alignment) % alignment;
+    out.write(zeros, static_cast<std::streamsize>(padding));
+    offset += padding;
+}
+
+} // namespace
+
+// ===== AssetPack =====
+
+std::string AssetPack::normalize(std::string_view path)
+{
+    std::string result;
+    result.reserve(path.size());
+    for (char c : path) {
+        char ch = c == '\\' ? '/' : c;
+        if (ch == '/' && !result.empty() && result.back() == '/') {
+            continue;
+        }
+        result.push_back(ch);
+    }
+    while (result.compare(0, 2, "./") == 0) {
+        result.erase(0, 2);
+    }
+    return result;
+}
+
+std::uint64_t AssetPack::hashPath(std::string_view normalized)
+{
+    std::uint64_t hash = 1469598103934665603ull;
+    for (char c : normalized) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::uint32_t AssetPack::checksum(const void* data, std::size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool AssetPack::open(const std::string& path)
+{
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    if (!validate(path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close()
+{
+    file.close();
+}
+
+bool AssetPack::validate(const std::string& path) const
+{
+    auto fail = [&path](const char* reason) {
+        printf("[AssetPack] %s: %s\n", path.c_str(), reason);
+        return false;
+    };
+    const std::size_t length = file.size();
+    if (length < sizeof(Header)) {
+        return fail("file too small");
+    }
+    const Header& h = header();
+    if (std::memcmp(h.magic, "APAK", 4) != 0) {
+        return fail("not an asset pack");
+    }
+    if (h.version != version) {
+        return fail("version mismatch, re-run assetpack");
+    }
+    if (h.endianTag != endianTag) {
+        return fail("byte order mismatch");
+    }
+    if (h.indexOffset % alignof(Entry) != 0 || h.indexOffset > length ||
+        static_cast<std::uint64_t>(h.entryCount) * sizeof(Entry) > length - h.indexOffset) {
+        return fail("index out of range");
+    }
+    if (h.stringTableOffset > length || h.stringTableSize > length - h.stringTableOffset ||
+        (h.stringTableSize > 0 && file.data()[h.stringTableOffset + h.stringTableSize - 1] != '\0')) {
+        return fail("string table out of range");
+    }
+    const Entry* list = entries();
+    for (std::size_t i = 0; i < h.entryCount; ++i) {
+        const Entry& e = list[i];
+        if (e.offset > length || e.size > length - e.offset || e.path >= h.stringTableSize) {
+            return fail("entry out of range");
+        }
+        if (i > 0 && list[i - 1].pathHash > e.pathHash) {
+            return fail("index not sorted");
+        }
+    }
+    return true;
+}
+
+AssetPack::View AssetPack::find(std::string_view path) const
+{
+    if (!isOpen()) {
+        return {};
+    }
+    std::string normalized = normalize(path);
+    std::uint64_t hash = hashPath(normalized);
+    const Entry* first = entries();
+    const Entry* last = first + header().entryCount;
+    const Entry* it = std::lower_bound(first, last, hash, [](const Entry& e, std::uint64_t h) {
+        return e.pathHash < h;
+    });
+    // 哈希相同的条目再比对路径本身
+    for (; it != last && it->pathHash == hash; ++it) {
+        if (entryPath(static_cast<std::size_t>(it - first)) == normalized) {
+            return { file.data() + it->offset, static_cast<std::size_t>(it->size) };
+        }
+    }
+    return {};
+}
+
+std::string_view AssetPack::entryPath(std::size_t index) const
+{
+    if (index >= entryCount()) {
+        return {};
+    }
+    // 字符串表以'\0'结尾（open时已校验），不会越界
+    return std::string_view(reinterpret_cast<const char*>(
+        file.data() + header().stringTableOffset + entries()[index].path));
+}
+
+bool AssetPack::verify() const
+{
+    if (!isOpen()) {
+        return false;
+    }
+    bool ok = true;
+    for (std::size_t i = 0; i < entryCount(); ++i) {
+        const Entry& e = entries()[i];
+        if (checksum(file.data() + e.offset, static_cast<std::size_t>(e.size)) != e.checksum) {
+            printf("[AssetPack] Checksum mismatch: %.*s\n",
+                   static_cast<int>(entryPath(i).size()), entryPath(i).data());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool AssetPack::build(const std::vector<std::string>& files, const std::string& outPath)
+{
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        printf("[AssetPack] Cannot write %s\n", outPath.c_str());
+        return false;
+    }
+
+    Header h{};
+    std::memcpy(h.magic, "APAK", 4);
+    h.version   = version;
+    h.endianTag = endianTag;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    std::uint64_t offset = sizeof(h);
+
+    std::vector<Entry> index;
+    std::string strings;
+    std::unordered_set<std::string> seen;
+    std::vector<char> buffer;
+    index.reserve(files.size());
+    for (const std::string& source : files) {
+        std::string path = normalize(source);
+        if (!seen.insert(path).second) {
+            continue;
+        }
+        std::ifstream in(source, std::ios::binary);
+        if (!in.is_open()) {
+            printf("[AssetPack] Cannot read %s\n", source.c_str());
+            return false;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        writePadding(out, offset, alignment);
+        Entry e{};
+        e.pathHash = hashPath(path);
+        e.offset   = offset;
+        e.size     = buffer.size();
+        e.path     = static_cast<std::uint32_t>(strings.size());
+        e.checksum = checksum(buffer.data(), buffer.size());
+        index.push_back(e);
+        strings.append(path);
+        strings.push_back('\0');
+
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        offset += buffer.size();
+    }
+
+    // 索引按哈希排序供二分查找，数据区保持打包顺序
+    std::stable_sort(index.begin(), index.end(), [](const Entry& a, const Entry& b) {
+        return a.pathHash < b.pathHash;
+    });
+    writePadding(out, offset, alignment);
+    h.entryCount  = static_cast<std::uint32_t>(index.size());
+    h.indexOffset = offset;
+    out.write(reinterpret_cast<const char*>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(Entry)));
+    offset += index.size() * sizeof(Entry);
+    h.stringTableOffset = offset;
+    h.stringTableSize   = strings.size();
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    if (!out.good()) {
+        printf("[AssetPack] Failed to write %s\n", outPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ===== AssetVfs =====
+
+AssetPack& AssetVfs::pack()
+{
+    static AssetPack instance;
+    return instance;
+}
+
+bool AssetVfs::mount(const std::string& packPath)
+{
+    if (!pack().open(packPath)) {
+        return false;
+    }
+    printf("[AssetVfs] Mounted %s (%zu files)\n", packPath.c_str(), pack().entryCount());
+    return true;
+}
+
+void AssetVfs::unmount()
+{
+    pack().close();
+}
+
+bool AssetVfs::isMounted()
+{
+    return pack().isOpen();
+}
+
+AssetPack::View AssetVfs::find(std::string_view path)
+{
+    return pack().find(path);
+}
+
+bool AssetVfs::readText(const std::string& path, std::string& storage, std::string_view& text, bool preferDisk)
+{
+    AssetPack::View view;
+    if (!preferDisk && (view = find(path))) {
+        text = view.text();
+        return true;
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        if (preferDisk && (view = find(path))) {
+            text = view.text();
+            return true;
+        }
+        return false;
+    }
+    storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    text = storage;
+    return true;
+}
@@ -1,9 +1,19 @@
 #include "ConfigLoader.hpp"
+#include "AssetPack.hpp"
+#include <mutex>
+
+namespace {
+
+// 共享实例，按规范化的路径索引
+std::mutex sharedMutex;
+std::unordered_map<std::string, std::shared_ptr<const ConfigLoader>> sharedInstances;
+
+} // namespace
 
 ConfigLoader::ConfigLoader()
 {
     // ConfigLoader类构造函数实现
-    
+
 }
 
 ConfigLoader::~ConfigLoader()
@@ -19,121 +29,202 @@ void ConfigLoader::setBaseDir(const std::string& dir)
     return;
 }
 
-void ConfigLoader::loadConfig(const std::string& filepath, const std::string& section)
+bool ConfigLoader::load(const std::string& filepath, bool preferDisk)
 {
-    configData.clear();
-    // ConfigLoader类加载配置文件实现
-    // 读取配置文件并解析指定节的内容
-    std::ifstream file(filepath);
-    if (!file.is_open())
+    names.clear();
+    nameList.clear();
+    values.clear();
+    sectionKeys.clear();
+    // 与原来一样直接使用调用方给出的路径（基础目录不参与）
+    path = filepath;
+    // 通常优先从已挂载的资源包读取，没有时读磁盘上的散文件
+    std::string storage;
+    std::string_view text;
+    if (!AssetVfs::readText(path, storage, text, preferDisk))
     {
-        // 处理文件打开失败的情况
-        // 向Error类发出报错请求（待实现）
-        return;
+        printf("[ConfigLoader] Cannot open %s\n", path.c_str());
+        return false;
     }
 
-    std::string line;
-    bool inSection = false;
-    while (std::getline(file, line))
+    // 去掉头尾的空白字符
+    auto trim = [](std::string_view s) {
+        const char* ws = " \t\r\n";
+        auto start = s.find_first_not_of(ws);
+        if (start == std::string_view::npos) { return std::string_view(); }
+        auto end = s.find_last_not_of(ws);
+        return s.substr(start, end - start + 1);
+    };
+
+    // 节之前的键值放在名为空的节中
+    std::uint32_t section = intern(std::string_view());
+    sectionKeys[section];
+    std::size_t lineStart = 0;
+    while (lineStart < text.size())
     {
-        // 检查当前行是否是目标节
-        if (line.find("[") == 0)
+        std::size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
         {
-            if (inSection)
-            {
-                // 已经读取完目标节，退出循环
-                break;
-            }
-            if (line == "[" + section + "]")
-            {
-                // 找到目标节
-                inSection = true;
-                continue;
-            }
+            lineEnd = text.size();
+        }
+        std::string_view line = trim(text.substr(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
+
+        // 空行与注释
+        if (line.empty() || line.front() == ';' || line.front() == '#')
+        {
+            continue;
         }
-        
-        // 如果不在目标节，则跳过当前行
-        if (!inSection)
+        // 节头：同名的节重复出现时合并，后出现的键覆盖先出现的
+        if (line.front() == '[')
         {
+            auto close = line.find(']');
+            if (close != std::string_view::npos)
+            {
+                section = intern(trim(line.substr(1, close - 1)));
+                sectionKeys[section];
+            }
             continue;
         }
 
         // 解析键值对
         auto pos = line.find('=');
-        if (pos != std::string::npos)
+        if (pos != std::string_view::npos)
         {
-            std::string key = line.substr(0, pos);
-            std::string valueStr = line.substr(pos + 1);
-            
-            // 去掉 key 与 valueStr 头尾的空白字符
-            auto trim = [](std::string &s) {
-                const char* ws = " \t\r\n";
-                auto start = s.find_first_not_of(ws);
-                if (start == std::string::npos) { s.clear(); return; }
-                auto end = s.find_last_not_of(ws);
-                s = s.substr(start, end - start + 1);
-            };
-
-            trim(key);
-            trim(valueStr);
-            
-            ConfigValue value;
-
-            // 简单类型推断
-            if (valueStr == "true" || valueStr == "false")
+            std::uint32_t key = intern(trim(line.substr(0, pos)));
+            auto [it, inserted] = values.insert_or_assign(combine(section, key), parseValue(trim(line.substr(pos + 1))));
+            if (inserted)
             {
-                // 布尔值处理
-                // // debug
-                // printf("Accept boolean value!!!");
-                value = (valueStr == "true");
+                sectionKeys[section].push_back(key);
             }
-            else if (valueStr == "")
-            {   
-                // 空值处理
-                value = std::monostate{};
+        }
+    }
+    return true;
+}
+
+std::uint32_t ConfigLoader::intern(std::string_view name)
+{
+    auto [it, inserted] = names.emplace(std::string(name), static_cast<std::uint32_t>(nameList.size()));
+    if (inserted)
+    {
+        nameList.push_back(it->first);
+    }
+    return it->second;
+}
+
+std::uint32_t ConfigLoader::nameId(const std::string& name) const
+{
+    auto it = names.find(name);
+    return it != names.end() ? it->second : noName;
+}
+
+ConfigLoader::ConfigValue ConfigLoader::parseValue(std::string_view text)
+{
+    // 简单类型推断
+    std::string valueStr(text);
+    if (valueStr == "true" || valueStr == "false")
+    {
+        // 布尔值处理
+        return valueStr == "true";
+    }
+    if (valueStr == "")
+    {
+        // 空值处理
+        return std::monostate{};
+    }
+    try
+    {
+        size_t idx;
+        int intValue = std::stoi(valueStr, &idx);
+        if (idx == valueStr.size())
+        {
+            return intValue;
+        }
+        float floatValue = std::stof(valueStr, &idx);
+        if (idx == valueStr.size())
+        {
+            return floatValue;
+        }
+    }
+    catch (...)
+    {
+    }
+    return valueStr; // 默认作为字符串处理
+}
+
+std::shared_ptr<const ConfigLoader> ConfigLoader::shared(const std::string& filepath)
+{
+    std::string key = AssetPack::normalize(filepath);
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (auto it = sharedInstances.find(key); it != sharedInstances.end())
+    {
+        return it->second;
+    }
+    auto loader = std::make_shared<ConfigLoader>();
+    if (!loader->load(filepath))
+    {
+        // 打不开的文件不缓存，之后再次调用时重试；返回空实例，查找都得到缺省值
+        return loader;
+    }
+    sharedInstances.emplace(std::move(key), loader);
+    return loader;
+}
+
+std::shared_ptr<const ConfigLoader> ConfigLoader::reload(const std::string& filepath)
+{
+    // 在锁外解析，不阻塞其它线程取得旧实例；被监视的是磁盘上的文件，资源包中是打包时的旧内容
+    auto loader = std::make_shared<ConfigLoader>();
+    if (!loader->load(filepath, true))
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedInstances[AssetPack::normalize(filepath)] = loader;
+    return loader;
+}
+
+std::vector<std::pair<std::string, std::string>> ConfigLoader::diff(const ConfigLoader& other) const
+{
+    std::vector<std::pair<std::string, std::string>> changes;
+    for (const auto& [section, keys] : sectionKeys)
+    {
+        for (std::uint32_t key : keys)
+        {
+            const ConfigValue* otherValue = other.find(nameList[section], nameList[key]);
+            if (!otherValue || *otherValue != values.at(combine(section, key)))
+            {
+                changes.emplace_back(nameList[section], nameList[key]);
             }
-            else
+        }
+    }
+    for (const auto& [section, keys] : other.sectionKeys)
+    {
+        for (std::uint32_t key : keys)
+        {
+            if (!find(other.nameList[section], other.nameList[key]))
             {
-                try
-                {
-                    size_t idx;
-                    int intValue = std::stoi(valueStr, &idx);
-                    if (idx == valueStr.size())
-                    {
-                        value = intValue;
-                    }
-                    else
-                    {
-                        float floatValue = std::stof(valueStr, &idx);
-                        if (idx == valueStr.size())
-                        {
-                            value = floatValue;
-                        }
-                        else
-                        {
-                            value = valueStr; // 默认作为字符串处理
-                        }
-                    }
-                }
-                catch (...)
-                {
-                    value = valueStr; // 默认作为字符串处理
-                }
+                changes.emplace_back(other.nameList[section], other.nameList[key]);
             }
-
-            // 将解析得到的键值对存储到configData中
-            configData[key] = value;
         }
     }
-    file.close();
+    return changes;
+}
+
+void ConfigLoader::loadConfig(const std::string& filepath, const std::string& section)
+{
+    // 同一个文件只解析一次，之后只切换当前节
+    if (path != filepath)
+    {
+        load(filepath);
+    }
+    currentSection = section;
     return;
 }
 
 ConfigLoader::ConfigValue ConfigLoader::getValue(const std::string& key) const
 {
     // ConfigLoader类根据键获取配置值的实现
-    if (auto it = configData.find(key); it != configData.end()) {
-        return it->second;
+    if (const ConfigValue* value = find(currentSection, key)) {
+        return *value;
     }
     return std::monostate{}; // 返回空值表示未找到
 }
@@ -141,6 +232,125 @@ ConfigLoader::ConfigValue ConfigLoader::getValue(const std::string& key) const
 ConfigLoader::ConfigDict ConfigLoader::getAllValues(const std::string& section) const
 {
     // ConfigLoader类获取指定节的所有键值对的实现
-    // 由于当前实现中configData只存储了一个节的数据，因此直接返回configData
-    return configData;
-}
\ No newline at end of file
+    ConfigDict dict;
+    std::uint32_t id = nameId(section);
+    auto it = id == noName ? sectionKeys.end() : sectionKeys.find(id);
+    if (it == sectionKeys.end())
+    {
+        return dict;
+    }
+    for (std::uint32_t key : it->second)
+    {
+        dict.emplace(nameList[key], values.at(combine(id, key)));
+    }
+    return dict;
+}
+
+ConfigLoader::Key ConfigLoader::key(const std::string& section, const std::string& key) const
+{
+    std::uint32_t sectionId = nameId(section);
+    std::uint32_t keyId = nameId(key);
+    if (sectionId == noName || keyId == noName)
+    {
+        return Key{};
+    }
+    return Key{ combine(sectionId, keyId) };
+}
+
+const ConfigLoader::ConfigValue* ConfigLoader::find(Key key) const
+{
+    if (!key.valid())
+    {
+        return nullptr;
+    }
+    auto it = values.find(key.id);
+    return it != values.end() ? &it->second : nullptr;
+}
+
+const ConfigLoader::ConfigValue* ConfigLoader::find(const std::string& section, const std::string& key) const
+{
+    return find(this->key(section, key));
+}
+
+bool ConfigLoader::hasSection(const std::string& section) const
+{
+    std::uint32_t id = nameId(section);
+    return id != noName && sectionKeys.find(id) != sectionKeys.end();
+}
+
+int ConfigLoader::getInt(Key key, int fallback) const
+{
+    const ConfigValue* value = find(key);
+    if (!value)
+    {
+        return fallback;
+    }
+    if (const int* v = std::get_if<int>(value))
+    {
+        return *v;
+    }
+    if (const float* v = std::get_if<float>(value))
+    {
+        return static_cast<int>(*v);
+    }
+    return fallback;
+}
+
+float ConfigLoader::getFloat(Key key, float fallback) const
+{
+    const ConfigValue* value = find(key);
+    if (!value)
+    {
+        return fallback;
+    }
+    if (const float* v = std::get_if<float>(value))
+    {
+        return *v;
+    }
+    if (const int* v = std::get_if<int>(value))
+    {
+        return static_cast<float>(*v);
+    }
+    return fallback;
+}
+
+bool ConfigLoader::getBool(Key key, bool fallback) const
+{
+    const ConfigValue* value = find(key);
+    if (const bool* v = value ? std::get_if<bool>(value) : nullptr)
+    {
+        return *v;
+    }
+    return fallback;
+}
+
+std::string ConfigLoader::getString(Key key, const std::string& fallback) const
+{
+    const ConfigValue* value = find(key);
+    if (const std::string* v = value ? std::get_if<std::string>(value) : nullptr)
+    {
+        return *v;
+    }
+    return fallback;
+}
+
+int ConfigLoader::getInt(const std::string& section, const std::string& key, int fallback) const
+{
+    return getInt(this->key(section, key), fallback);
+}
+
+float ConfigLoader::getFloat(const std::string& section, const std::string& key, float fallback) const
+{
+    return getFloat(this->key(section, key), fallback);
+}
+
+bool ConfigLoader::getBool(const std::string& section, const std::string& key, bool fallback) const
+{
+    return getBool(this->key(section, key), fallback);
+}
+
+std::string ConfigLoader::getString(const std::string& section, const std::string& key,
+                                    const std::string& fallback) const
+{
+    return getString(this->key(section, key), fallback);
+}
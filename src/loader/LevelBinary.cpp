@@ -0,0 +1,491 @@
+#include "LevelBinary.hpp"
+#include "LevelReader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// 记录按字节写入文件、按指针直接读取，布局必须固定
+static_assert(sizeof(LevelBinary::Header) == 64, "LevelBinary::Header layout changed");
+static_assert(sizeof(LevelBinary::Section) == 24, "LevelBinary::Section layout changed");
+static_assert(std::is_trivially_copyable<LevelBinary::GraphicRecord>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<LevelBinary::ParallaxRecord>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<LevelBinary::BlockRecord>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<LevelBinary::EnemyRecord>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<LevelBinary::TrapRecord>::value, "records must be trivially copyable");
+
+namespace {
+
+std::size_t recordSizeOf(LevelBinary::ObjectType type)
+{
+    switch (type) {
+        case LevelBinary::ObjectType::Graphic:  return sizeof(LevelBinary::GraphicRecord);
+        case LevelBinary::ObjectType::Parallax: return sizeof(LevelBinary::ParallaxRecord);
+        case LevelBinary::ObjectType::Block:    return sizeof(LevelBinary::BlockRecord);
+        case LevelBinary::ObjectType::Enemy:    return sizeof(LevelBinary::EnemyRecord);
+        case LevelBinary::ObjectType::Trap:     return sizeof(LevelBinary::TrapRecord);
+        default:                                return 0;
+    }
+}
+
+std::size_t alignUp(std::size_t value)
+{
+    return (value + LevelBinary::alignment - 1) & ~static_cast<std::size_t>(LevelBinary::alignment - 1);
+}
+
+// 编译时使用的字符串表：相同字符串只存一份
+class StringTable
+{
+    public:
+        std::uint32_t add(const std::string& str)
+        {
+            auto it = offsets.find(str);
+            if (it != offsets.end()) {
+                return it->second;
+            }
+            std::uint32_t offset = static_cast<std::uint32_t>(data.size());
+            data.insert(data.end(), str.begin(), str.end());
+            data.push_back('\0');
+            offsets.emplace(str, offset);
+            return offset;
+        }
+        const std::vector<char>& bytes() const { return data; }
+
+    private:
+        std::vector<char> data;
+        std::unordered_map<std::string, std::uint32_t> offsets;
+};
+
+template <typename T>
+void appendRecord(std::vector<std::uint8_t>& out, const T& record)
+{
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&record);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// 可选字符串为空时写noString
+std::uint32_t optionalString(StringTable& strings, const std::string& str)
+{
+    return str.empty() ? LevelBinary::noString : strings.add(str);
+}
+
+// 每种desc编译成定长记录（字段已由LevelReader按字段表校验并填好缺省值）
+void cookRecord(const GraphicDesc& d, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    LevelBinary::GraphicRecord r{};
+    r.type    = strings.add(d.type);
+    r.texture = strings.add(d.texture);
+    r.x       = d.x;
+    r.y       = d.y;
+    r.width   = d.width;
+    r.height  = d.height;
+    appendRecord(out, r);
+}
+void cookRecord(const ParallaxDesc& d, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    LevelBinary::ParallaxRecord r{};
+    r.layer   = d.layer;
+    r.texture = strings.add(d.texture);
+    r.speed   = d.speed;
+    r.y       = d.y;
+    r.id      = optionalString(strings, d.id);
+    appendRecord(out, r);
+}
+void cookRecord(const BlockDesc& d, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    LevelBinary::BlockRecord r{};
+    r.type    = strings.add(d.type);
+    r.texture = strings.add(d.texture);
+    r.health  = d.health;
+    r.x       = d.x;
+    r.y       = d.y;
+    r.width   = d.width;
+    r.height  = d.height;
+    r.id      = optionalString(strings, d.id);
+    appendRecord(out, r);
+}
+void cookRecord(const EnemyDesc& d, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    LevelBinary::EnemyRecord r{};
+    r.texture        = strings.add(d.texture);
+    r.health         = d.health;
+    r.attackDamage   = d.attackDamage;
+    r.attackCooldown = d.attackCooldown;
+    r.x              = d.x;
+    r.y              = d.y;
+    r.width          = d.width;
+    r.height         = d.height;
+    r.density        = d.density;
+    r.friction       = d.friction;
+    r.velocityX      = d.velocityX;
+    r.velocityY      = d.velocityY;
+    r.patrolAx       = d.patrolAx;
+    r.patrolAy       = d.patrolAy;
+    r.patrolBx       = d.patrolBx;
+    r.patrolBy       = d.patrolBy;
+    r.id             = optionalString(strings, d.id);
+    appendRecord(out, r);
+}
+void cookRecord(const TrapDesc& d, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    LevelBinary::TrapRecord r{};
+    r.type          = strings.add(d.type);
+    r.element       = optionalString(strings, d.element);
+    r.texture       = strings.add(d.texture);
+    r.flags         = LevelBinary::HasHealth;   // 缺省血量已由字段表填入
+    r.health        = d.health;
+    r.damage        = d.damage;
+    r.x             = d.x;
+    r.y             = d.y;
+    r.width         = d.width;
+    r.height        = d.height;
+    r.triggerX      = d.triggerX;
+    r.triggerY      = d.triggerY;
+    r.triggerWidth  = d.triggerWidth;
+    r.triggerHeight = d.triggerHeight;
+    r.id            = optionalString(strings, d.id);
+    appendRecord(out, r);
+}
+
+template <typename T>
+void cookRecords(const std::vector<T>& descs, StringTable& strings, std::vector<std::uint8_t>& out)
+{
+    for (const T& d : descs) {
+        cookRecord(d, strings, out);
+    }
+}
+
+} // namespace
+
+LevelBinary::~LevelBinary()
+{
+    close();
+}
+
+bool LevelBinary::open(const std::string& path)
+{
+    close();
+    if (!file.open(path)) {
+        printf("[LevelBinary] Cannot open or map %s\n", path.c_str());
+        return false;
+    }
+    base   = file.data();
+    length = file.size();
+    if (!validate(path)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void LevelBinary::close()
+{
+    file.close();
+    base   = nullptr;
+    length = 0;
+}
+
+bool LevelBinary::validate(const std::string& path) const
+{
+    auto fail = [&path](const char* reason) {
+        printf("[LevelBinary] %s: %s\n", path.c_str(), reason);
+        return false;
+    };
+    if (length < sizeof(Header)) {
+        return fail("file too small");
+    }
+    const Header& h = header();
+    if (std::memcmp(h.magic, "LVLB", 4) != 0) {
+        return fail("not a cooked level");
+    }
+    if (h.version != version) {
+        return fail("version mismatch, re-run levelcook");
+    }
+    if (h.endianTag != endianTag) {
+        return fail("byte order mismatch");
+    }
+    std::uint64_t tableEnd = static_cast<std::uint64_t>(h.sectionTableOffset) +
+                             static_cast<std::uint64_t>(h.sectionCount) * sizeof(Section);
+    if (h.sectionTableOffset % alignof(Section) != 0 || tableEnd > length) {
+        return fail("section table out of range");
+    }
+    std::uint64_t stringEnd = static_cast<std::uint64_t>(h.stringTableOffset) + h.stringTableSize;
+    if (stringEnd > length || (h.stringTableSize > 0 && base[stringEnd - 1] != '\0')) {
+        return fail("string table out of range");
+    }
+    for (std::size_t i = 0; i < h.sectionCount; ++i) {
+        const Section& sec = section(i);
+        std::size_t expected = recordSizeOf(sec.type);
+        if (expected == 0 || sec.recordSize != expected) {
+            return fail("unknown section type or record layout");
+        }
+        std::uint64_t end = static_cast<std::uint64_t>(sec.offset) +
+                            static_cast<std::uint64_t>(sec.count) * sec.recordSize;
+        if (sec.offset % 4 != 0 || end > length) {
+            return fail("section out of range");
+        }
+    }
+    return true;
+}
+
+std::string_view LevelBinary::string(std::uint32_t id) const
+{
+    if (!isOpen() || id == noString || id >= header().stringTableSize) {
+        return {};
+    }
+    // 字符串表以'\0'结尾（open时已校验），不会越界
+    return std::string_view(reinterpret_cast<const char*>(base + header().stringTableOffset + id));
+}
+
+LevelBinary::ObjectType LevelBinary::typeFromKey(std::string_view key)
+{
+    if (key == "GraphicObj")    return ObjectType::Graphic;
+    if (key == "ParallaxLayer") return ObjectType::Parallax;
+    if (key == "Block")         return ObjectType::Block;
+    if (key == "Enemy")         return ObjectType::Enemy;
+    if (key == "Trap")          return ObjectType::Trap;
+    return ObjectType::Unknown;
+}
+
+bool LevelBinary::cook(const std::string& jsonPath, const std::string& outPath)
+{
+    // 字段校验交给LevelReader（按对象字段表），任何错误都不输出文件
+    LevelReader reader;
+    LevelDesc level;
+    if (!reader.read(jsonPath, level)) {
+        printf("[LevelBinary] %s: %zu error(s), nothing written\n", jsonPath.c_str(), reader.getErrors().size());
+        return false;
+    }
+    if (level.objKeys.empty()) {
+        printf("[LevelBinary] %s has no objKeys (not a level file)\n", jsonPath.c_str());
+        return false;
+    }
+
+    StringTable strings;
+    Header h{};
+    std::memcpy(h.magic, "LVLB", 4);
+    h.version    = version;
+    h.endianTag  = endianTag;
+    h.name       = optionalString(strings, level.name);
+    h.background = optionalString(strings, level.background);
+    h.music      = optionalString(strings, level.music);
+    h.gravityX   = level.gravityX;
+    h.gravityY   = level.gravityY;
+    h.levelWidth = level.levelWidth;
+    h.flags      = level.hasLevelWidth ? HasLevelWidth : 0u;
+
+    // 每个objKey编译成一段记录
+    std::vector<Section> sections;
+    std::vector<std::vector<std::uint8_t>> payloads;
+    for (const std::string& key : level.objKeys) {
+        ObjectType type = typeFromKey(key);
+        if (type == ObjectType::Unknown) {
+            printf("[LevelBinary] Unknown object key %s skipped\n", key.c_str());
+            continue;
+        }
+        Section sec{};
+        sec.type       = type;
+        sec.key        = strings.add(key);
+        sec.count      = static_cast<std::uint32_t>(level.count(key));
+        sec.recordSize = static_cast<std::uint32_t>(recordSizeOf(type));
+        std::vector<std::uint8_t> payload;
+        switch (type) {
+            case ObjectType::Graphic:  cookRecords(level.graphics, strings, payload);       break;
+            case ObjectType::Parallax: cookRecords(level.parallaxLayers, strings, payload); break;
+            case ObjectType::Block:    cookRecords(level.blocks, strings, payload);         break;
+            case ObjectType::Enemy:    cookRecords(level.enemies, strings, payload);        break;
+            case ObjectType::Trap:     cookRecords(level.traps, strings, payload);          break;
+            default: break;
+        }
+        sections.push_back(sec);
+        payloads.push_back(std::move(payload));
+    }
+
+    // 排布：文件头 | 段表 | 各段记录 | 字符串表，每部分16字节对齐
+    std::size_t offset = sizeof(Header);
+    h.sectionCount       = static_cast<std::uint32_t>(sections.size());
+    h.sectionTableOffset = static_cast<std::uint32_t>(offset);
+    offset = alignUp(offset + sections.size() * sizeof(Section));
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        sections[i].offset = static_cast<std::uint32_t>(offset);
+        offset = alignUp(offset + payloads[i].size());
+    }
+    h.stringTableOffset = static_cast<std::uint32_t>(offset);
+    h.stringTableSize   = static_cast<std::uint32_t>(strings.bytes().size());
+    offset += strings.bytes().size();
+
+    std::vector<std::uint8_t> image(offset, 0);
+    std::memcpy(image.data(), &h, sizeof(Header));
+    if (!sections.empty()) {
+        std::memcpy(image.data() + h.sectionTableOffset, sections.data(), sections.size() * sizeof(Section));
+    }
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        if (!payloads[i].empty()) {
+            std::memcpy(image.data() + sections[i].offset, payloads[i].data(), payloads[i].size());
+        }
+    }
+    if (!strings.bytes().empty()) {
+        std::memcpy(image.data() + h.stringTableOffset, strings.bytes().data(), strings.bytes().size());
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        printf("[LevelBinary] Cannot write %s\n", outPath.c_str());
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        printf("[LevelBinary] Failed writing %s\n", outPath.c_str());
+        return false;
+    }
+    printf("[LevelBinary] Cooked %s -> %s (%zu section(s), %zu bytes)\n",
+           jsonPath.c_str(), outPath.c_str(), sections.size(), image.size());
+    return true;
+}
+
+void LevelBinary::toDesc(LevelDesc& level) const
+{
+    level.clear();
+    if (!isOpen()) {
+        return;
+    }
+    const Header& h = header();
+    level.name          = std::string(string(h.name));
+    level.background    = std::string(string(h.background));
+    level.music         = std::string(string(h.music));
+    level.gravityX      = h.gravityX;
+    level.gravityY      = h.gravityY;
+    level.hasLevelWidth = (h.flags & HasLevelWidth) != 0;
+    level.levelWidth    = level.hasLevelWidth ? h.levelWidth : 0.0f;
+
+    for (std::size_t i = 0; i < sectionCount(); ++i) {
+        const Section& sec = section(i);
+        level.objKeys.emplace_back(string(sec.key));
+        switch (sec.type) {
+            case ObjectType::Graphic:
+                level.graphics.reserve(level.graphics.size() + sec.count);
+                for (const GraphicRecord& r : records<GraphicRecord>(sec)) {
+                    GraphicDesc& d = level.graphics.emplace_back();
+                    d.type    = std::string(string(r.type));
+                    d.texture = std::string(string(r.texture));
+                    d.x       = r.x;
+                    d.y       = r.y;
+                    d.width   = r.width;
+                    d.height  = r.height;
+                }
+                break;
+            case ObjectType::Parallax:
+                level.parallaxLayers.reserve(level.parallaxLayers.size() + sec.count);
+                for (const ParallaxRecord& r : records<ParallaxRecord>(sec)) {
+                    ParallaxDesc& d = level.parallaxLayers.emplace_back();
+                    d.layer   = r.layer;
+                    d.texture = std::string(string(r.texture));
+                    d.speed   = r.speed;
+                    d.y       = r.y;
+                    d.id      = std::string(string(r.id));
+                }
+                break;
+            case ObjectType::Block:
+                level.blocks.reserve(level.blocks.size() + sec.count);
+                for (const BlockRecord& r : records<BlockRecord>(sec)) {
+                    BlockDesc& d = level.blocks.emplace_back();
+                    d.type    = std::string(string(r.type));
+                    d.texture = std::string(string(r.texture));
+                    d.health  = r.health;
+                    d.x       = r.x;
+                    d.y       = r.y;
+                    d.width   = r.width;
+                    d.height  = r.height;
+                    d.id      = std::string(string(r.id));
+                }
+                break;
+            case ObjectType::Enemy:
+                level.enemies.reserve(level.enemies.size() + sec.count);
+                for (const EnemyRecord& r : records<EnemyRecord>(sec)) {
+                    EnemyDesc& d = level.enemies.emplace_back();
+                    d.texture        = std::string(string(r.texture));
+                    d.health         = r.health;
+                    d.attackDamage   = r.attackDamage;
+                    d.attackCooldown = r.attackCooldown;
+                    d.x              = r.x;
+                    d.y              = r.y;
+                    d.width          = r.width;
+                    d.height         = r.height;
+                    d.density        = r.density;
+                    d.friction       = r.friction;
+                    d.velocityX      = r.velocityX;
+                    d.velocityY      = r.velocityY;
+                    d.patrolAx       = r.patrolAx;
+                    d.patrolAy       = r.patrolAy;
+                    d.patrolBx       = r.patrolBx;
+                    d.patrolBy       = r.patrolBy;
+                    d.id             = std::string(string(r.id));
+                }
+                break;
+            case ObjectType::Trap:
+                level.traps.reserve(level.traps.size() + sec.count);
+                for (const TrapRecord& r : records<TrapRecord>(sec)) {
+                    TrapDesc& d = level.traps.emplace_back();
+                    applySchemaDefaults(d);
+                    d.type          = std::string(string(r.type));
+                    d.element       = std::string(string(r.element));
+                    d.texture       = std::string(string(r.texture));
+                    if (r.flags & HasHealth) {
+                        d.health = r.health;
+                    }
+                    d.damage        = r.damage;
+                    d.x             = r.x;
+                    d.y             = r.y;
+                    d.width         = r.width;
+                    d.height        = r.height;
+                    d.triggerX      = r.triggerX;
+                    d.triggerY      = r.triggerY;
+                    d.triggerWidth  = r.triggerWidth;
+                    d.triggerHeight = r.triggerHeight;
+                    d.id            = std::string(string(r.id));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+std::string LevelBinary::cookedPathFor(const std::string& jsonPath)
+{
+    return std::filesystem::path(jsonPath).replace_extension(".lvlb").string();
+}
+
+bool LevelBinary::readCooked(const std::string& jsonPath, LevelDesc& level)
+{
+    namespace fs = std::filesystem;
+    std::string cookedPath = cookedPathFor(jsonPath);
+    std::error_code ec;
+    if (!fs::exists(cookedPath, ec)) {
+        return false;
+    }
+    // 只比较磁盘上的散文件；JSON不在磁盘上（只在资源包中）时无法判断新旧，读JSON
+    fs::file_time_type cookedTime = fs::last_write_time(cookedPath, ec);
+    if (ec) {
+        return false;
+    }
+    fs::file_time_type jsonTime = fs::last_write_time(jsonPath, ec);
+    if (ec) {
+        return false;
+    }
+    // 修改时间相同（同一个时钟节拍内先编译后编辑）无法判断先后，按过期处理
+    if (cookedTime <= jsonTime) {
+        printf("[LevelBinary] %s is not newer than %s, re-run levelcook\n", cookedPath.c_str(), jsonPath.c_str());
+        return false;
+    }
+    LevelBinary binary;
+    if (!binary.open(cookedPath)) {
+        return false;
+    }
+    binary.toDesc(level);
+    return true;
+}
@@ -0,0 +1,301 @@
+#include "LevelReader.hpp"
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+using json = nlohmann::json;
+
+// 对象数组的类型（按顶层键名区分）
+enum class ArrayKind { None, Graphic, Parallax, Block, Enemy, Trap };
+
+ArrayKind kindFromKey(const std::string& key)
+{
+    if (key == "GraphicObj")    return ArrayKind::Graphic;
+    if (key == "ParallaxLayer") return ArrayKind::Parallax;
+    if (key == "Block")         return ArrayKind::Block;
+    if (key == "Enemy")         return ArrayKind::Enemy;
+    if (key == "Trap")          return ArrayKind::Trap;
+    return ArrayKind::None;
+}
+
+// SAX处理器：容器层级 1 = 根对象，2 = 顶层数组，3 = 数组中的对象；
+// 不认识的容器整段跳过（skip计数），字段交给对应类型的SchemaDecoder直接写进当前desc，
+// 对象结束时按字段表校验，有错误的对象报告后丢弃
+class LevelSax
+{
+    public:
+        LevelSax(LevelDesc& out, std::vector<std::string>& errors) : out(out), errors(errors) {}
+
+        bool null()                     { return scalar(SchemaValue{}); }
+        bool boolean(bool value)        { SchemaValue v; v.kind = SchemaValue::Bool; v.number = value ? 1.0 : 0.0; return scalar(v); }
+        bool number_integer(json::number_integer_t value)   { return integer(static_cast<double>(value)); }
+        bool number_unsigned(json::number_unsigned_t value) { return integer(static_cast<double>(value)); }
+        bool number_float(json::number_float_t value, const json::string_t&)
+        {
+            SchemaValue v;
+            v.kind = SchemaValue::Float;
+            v.number = value;
+            return scalar(v);
+        }
+        bool string(json::string_t& value)
+        {
+            SchemaValue v;
+            v.kind = SchemaValue::String;
+            v.text = &value;
+            return scalar(v);
+        }
+        bool binary(json::binary_t&)    { return true; }
+
+        bool key(json::string_t& value)
+        {
+            if (skip > 0) return true;
+            if (level == 1) {
+                topKey = std::move(value);
+            } else if (level == 3) {
+                fieldKey = std::move(value);
+            }
+            return true;
+        }
+
+        bool start_object(std::size_t)
+        {
+            // 只进入根对象和对象数组中的对象，其它对象整段跳过
+            if (skip == 0 && (level == 0 || (level == 2 && array != ArrayKind::None))) {
+                ++level;
+                if (level == 1) {
+                    root.begin(out, std::string(), errors);
+                } else {
+                    beginObject();
+                }
+                return true;
+            }
+            ++skip;
+            return true;
+        }
+        bool end_object()
+        {
+            if (skip > 0) {
+                --skip;
+                return true;
+            }
+            if (level == 3) {
+                endObject();
+            } else if (level == 1) {
+                root.finish();
+                out.hasLevelWidth = root.has("levelWidth");
+            }
+            --level;
+            return true;
+        }
+        bool start_array(std::size_t)
+        {
+            if (skip > 0 || level != 1) {
+                ++skip;
+                return true;
+            }
+            ++level;
+            arrayIndex = 0;
+            inObjKeys = topKey == "objKeys";
+            array = inObjKeys ? ArrayKind::None : kindFromKey(topKey);
+            if (!inObjKeys && array == ArrayKind::None) {
+                // 不认识的顶层数组
+                --level;
+                ++skip;
+            }
+            return true;
+        }
+        bool end_array()
+        {
+            if (skip > 0) {
+                --skip;
+                return true;
+            }
+            --level;
+            array = ArrayKind::None;
+            inObjKeys = false;
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex)
+        {
+            errors.push_back("JSON syntax error at byte " + std::to_string(position) + ": " + ex.what());
+            return false;
+        }
+
+    private:
+        bool integer(double value)
+        {
+            SchemaValue v;
+            v.kind = SchemaValue::Int;
+            v.number = value;
+            return scalar(v);
+        }
+
+        void beginObject()
+        {
+            std::string where = topKey + "[" + std::to_string(arrayIndex++) + "]";
+            switch (array) {
+                case ArrayKind::Graphic:  beginDesc(out.graphics, graphic, std::move(where));        break;
+                case ArrayKind::Parallax: beginDesc(out.parallaxLayers, parallax, std::move(where)); break;
+                case ArrayKind::Block:    beginDesc(out.blocks, block, std::move(where));            break;
+                case ArrayKind::Enemy:    beginDesc(out.enemies, enemy, std::move(where));           break;
+                case ArrayKind::Trap:     beginDesc(out.traps, trap, std::move(where));              break;
+                default: break;
+            }
+        }
+        void endObject()
+        {
+            switch (array) {
+                case ArrayKind::Graphic:  endDesc(out.graphics, graphic);        break;
+                case ArrayKind::Parallax: endDesc(out.parallaxLayers, parallax); break;
+                case ArrayKind::Block:    endDesc(out.blocks, block);            break;
+                case ArrayKind::Enemy:    endDesc(out.enemies, enemy);           break;
+                case ArrayKind::Trap:     endDesc(out.traps, trap);              break;
+                default: break;
+            }
+        }
+
+        template <typename T>
+        void beginDesc(std::vector<T>& list, SchemaDecoder<T>& decoder, std::string where)
+        {
+            list.emplace_back();
+            decoder.begin(list.back(), std::move(where), errors);
+        }
+        template <typename T>
+        void endDesc(std::vector<T>& list, SchemaDecoder<T>& decoder)
+        {
+            // 缺少必填字段或字段无效的对象不创建
+            if (!decoder.finish()) {
+                list.pop_back();
+            }
+        }
+
+        bool scalar(const SchemaValue& v)
+        {
+            if (skip > 0) return true;
+            if (level == 1) {
+                root.set(topKey, v);
+            } else if (level == 2 && inObjKeys) {
+                if (v.kind == SchemaValue::String) out.objKeys.push_back(std::move(*v.text));
+            } else if (level == 3) {
+                objectField(v);
+            }
+            return true;
+        }
+
+        void objectField(const SchemaValue& v)
+        {
+            switch (array) {
+                case ArrayKind::Graphic:  graphic.set(fieldKey, v);  break;
+                case ArrayKind::Parallax: parallax.set(fieldKey, v); break;
+                case ArrayKind::Block:    block.set(fieldKey, v);    break;
+                case ArrayKind::Enemy:    enemy.set(fieldKey, v);    break;
+                case ArrayKind::Trap:     trap.set(fieldKey, v);     break;
+                default: break;
+            }
+        }
+
+        LevelDesc& out;
+        std::vector<std::string>& errors;
+        int level = 0;
+        int skip = 0;
+        bool inObjKeys = false;
+        ArrayKind array = ArrayKind::None;
+        std::size_t arrayIndex = 0;         // 当前数组中的对象下标（含被丢弃的对象，与文件一致）
+        std::string topKey;
+        std::string fieldKey;
+        SchemaDecoder<LevelDesc> root;
+        SchemaDecoder<GraphicDesc> graphic;
+        SchemaDecoder<ParallaxDesc> parallax;
+        SchemaDecoder<BlockDesc> block;
+        SchemaDecoder<EnemyDesc> enemy;
+        SchemaDecoder<TrapDesc> trap;
+};
+
+} // namespace
+
+bool LevelReader::read(const std::string& path, LevelDesc& out, bool preferDisk)
+{
+    // 资源包中的关卡直接从映射内存解析，散文件才读入buffer
+    std::string_view text;
+    if (!AssetVfs::readText(path, buffer, text, preferDisk)) {
+        errors.assign(1, "Cannot open " + path);
+        printf("[LevelReader] Cannot open %s\n", path.c_str());
+        return false;
+    }
+    bool ok = parse(text.data(), text.size(), out);
+    for (const std::string& error : errors) {
+        printf("[LevelReader] %s: %s\n", path.c_str(), error.c_str());
+    }
+    return ok;
+}
+
+bool LevelReader::parse(const char* data, std::size_t size, LevelDesc& out)
+{
+    errors.clear();
+    out.clear();
+    reserveObjects(data, size, out);
+    LevelSax sax(out, errors);
+    bool parsed = json::sax_parse(data, data + size, &sax);
+    return parsed && errors.empty();
+}
+
+void LevelReader::reserveObjects(const char* data, std::size_t size, LevelDesc& out)
+{
+    // 深度1的最后一个字符串就是随后打开的顶层数组的键名；数组内深度2处打开的'{'即一个对象
+    int depth = 0;
+    bool inString = false;
+    const char* stringStart = nullptr;
+    std::string lastKey;
+    ArrayKind array = ArrayKind::None;
+    std::size_t counts[6] = {};
+    for (std::size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        if (inString) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 1) {
+                    lastKey.assign(stringStart, data + i);
+                }
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                inString = true;
+                stringStart = data + i + 1;
+                break;
+            case '[':
+                if (depth == 1) {
+                    array = kindFromKey(lastKey);
+                }
+                ++depth;
+                break;
+            case '{':
+                if (depth == 2) {
+                    ++counts[static_cast<int>(array)];
+                }
+                ++depth;
+                break;
+            case ']':
+            case '}':
+                --depth;
+                if (depth == 1) {
+                    array = ArrayKind::None;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    out.graphics.reserve(counts[static_cast<int>(ArrayKind::Graphic)]);
+    out.parallaxLayers.reserve(counts[static_cast<int>(ArrayKind::Parallax)]);
+    out.blocks.reserve(counts[static_cast<int>(ArrayKind::Block)]);
+    out.enemies.reserve(counts[static_cast<int>(ArrayKind::Enemy)]);
+    out.traps.reserve(counts[static_cast<int>(ArrayKind::Trap)]);
+}
@@ -1,22 +1,32 @@
+#include "AssetPack.hpp"
 #include "ConfigLoader.hpp"
 #include "Display.hpp"
 #include "EventSys.hpp"
+#include "FileWatcher.hpp"
 #include "GameInput.hpp"
 #include "GameObj.hpp"
 #include "ResourceLoader.hpp"
 #include "Scene.hpp"
 #include "Player.hpp"
+#include "TaskScheduler.hpp"
+#include "Profiler.hpp"
+#include "RawImageCache.hpp"
+#include "TextureCache.hpp"
 #include <SFML/Audio.hpp>
+#include <algorithm>
 
 
 int main()
 {
+    // 挂载资源包（assetpack生成）；不存在时所有资源直接读取散文件
+    AssetVfs::mount("assets.pak");
+
      // 最简单直接的音频测试
     sf::Music music;
-    if (!music.openFromFile("audio/menu.ogg")) {
+    if (!AssetVfs::open(music, "audio/menu.ogg")) {
         printf("ERROR: Cannot load audio/menu.ogg\n");
         printf("Trying audio/menu.wav...\n");
-        if (!music.openFromFile("audio/menu.ogg")) {
+        if (!AssetVfs::open(music, "audio/menu.ogg")) {
             printf("ERROR: Cannot load any audio file!\n");
             return 1;
         }
@@ -41,25 +51,98 @@ int main()
     // Debug
     printf("Display, EventSys, and GameInputRead created.\n");
 
-    // 加载引擎配置
-    float deltaTime    = 0.0f;
-    int   subStepCount = 4;
-
-    ConfigLoader engineLoader;
-    engineLoader.loadConfig("config/engine.ini", "Engine");
-    deltaTime    = std::get<float>(engineLoader.getValue("DeltaTime"));
-    subStepCount = std::get<int>(engineLoader.getValue("subStepCount"));
+    // 加载引擎配置：与Display共用同一个解析结果，engine.ini只读一次
+    std::shared_ptr<const ConfigLoader> engineConfig = ConfigLoader::shared("config/engine.ini");
+    float deltaTime    = engineConfig->getFloat("Engine", "DeltaTime", 1.0f / 60.0f);
+    int   subStepCount = engineConfig->getInt("Engine", "subStepCount", 4);
+    // Box2D并行求解的线程数（含主线程），0表示使用全部硬件线程
+    int workerCount = std::max(0, engineConfig->getInt("Engine", "WorkerCount", 1));
+    auto taskScheduler = std::make_shared<TaskScheduler>(workerCount);
+    // 相邻静态方块合并成少量碰撞形状
+    bool mergeStaticBlocks = engineConfig->getBool("Engine", "MergeStaticBlocks", true);
+    // 物理固定步进频率与绘制插值（PhysicsRate为0时每帧按DeltaTime步进一次）
+    // 下面几组可以热重载的配置写成函数，engine.ini改变后重新调用（engineConfig替换为新的解析结果）
+    Scene::TimestepSettings timestepSettings;
+    auto loadTimestepSettings = [&]() {
+        timestepSettings.physicsRate = std::max(0.0f, engineConfig->getFloat("Engine", "PhysicsRate", timestepSettings.physicsRate));
+        timestepSettings.maxSteps    = std::max(1, engineConfig->getInt("Engine", "MaxPhysicsSteps", timestepSettings.maxSteps));
+        timestepSettings.interpolate = engineConfig->getBool("Engine", "Interpolate", timestepSettings.interpolate);
+    };
+    loadTimestepSettings();
 
     // Debug
     printf("Engine loaded.\n");
 
     // 构建 scene 路径
-    engineLoader.loadConfig("config/engine.ini", "Path");
-    std::string menupth   = std::get<std::string>(engineLoader.getValue("MenuPath"));
-    std::string level1pth = std::get<std::string>(engineLoader.getValue("level1Path"));
+    std::string menupth   = engineConfig->getString("Path", "MenuPath", "config/menu.json");
+    std::string level1pth = engineConfig->getString("Path", "level1Path", "config/level1.json");
+
+    // 渲染配置
+    Scene::RenderSettings renderSettings;
+    renderSettings.atlasPageSize = static_cast<unsigned>(engineConfig->getInt("Render", "AtlasPageSize", static_cast<int>(renderSettings.atlasPageSize)));
+    renderSettings.atlasPadding  = static_cast<unsigned>(engineConfig->getInt("Render", "AtlasPadding", static_cast<int>(renderSettings.atlasPadding)));
+    renderSettings.cullMargin    = engineConfig->getFloat("Render", "CullMargin", renderSettings.cullMargin);
+    renderSettings.cullCellSize  = engineConfig->getFloat("Render", "CullCellSize", renderSettings.cullCellSize);
+    renderSettings.bakeChunkSize = static_cast<unsigned>(std::max(0, engineConfig->getInt("Render", "BakeChunkSize", static_cast<int>(renderSettings.bakeChunkSize))));
+
+    // 关卡流式加载配置
+    Scene::StreamSettings streamSettings;
+    streamSettings.chunkWidth     = engineConfig->getFloat("Stream", "ChunkWidth", streamSettings.chunkWidth);
+    streamSettings.loadDistance   = engineConfig->getFloat("Stream", "LoadDistance", streamSettings.loadDistance);
+    streamSettings.unloadDistance = engineConfig->getFloat("Stream", "UnloadDistance", streamSettings.unloadDistance);
+
+    // 敌人模拟LOD配置
+    EnemySystem::LodSettings lodSettings;
+    auto loadLodSettings = [&]() {
+        lodSettings.enabled       = engineConfig->getBool("SimLOD", "Enabled", lodSettings.enabled);
+        lodSettings.nearDistance  = engineConfig->getFloat("SimLOD", "NearDistance", lodSettings.nearDistance);
+        lodSettings.nearInterval  = std::max(1, engineConfig->getInt("SimLOD", "NearInterval", lodSettings.nearInterval));
+        lodSettings.disableBodies = engineConfig->getBool("SimLOD", "DisableBodies", lodSettings.disableBodies);
+    };
+    loadLodSettings();
+
+    // 逐帧回滚配置
+    std::size_t rollbackFrames    = static_cast<std::size_t>(std::max(0, engineConfig->getInt("Rollback", "Frames", 0)));
+    std::size_t rollbackSlotBytes = static_cast<std::size_t>(std::max(0, engineConfig->getInt("Rollback", "SlotBytes", 0)));
+
+    // 异步加载每帧占用的主线程时间（毫秒）
+    float loadSliceMs = engineConfig->getFloat("Loading", "SliceBudgetMs", 4.0f);
+    // 加载时并行解码图片的线程数（含调用线程），0表示使用全部硬件线程
+    int decodeThreads = std::max(0, engineConfig->getInt("Loading", "DecodeThreads", 0));
+    auto decodeScheduler = std::make_shared<TaskScheduler>(decodeThreads);
+    // 解码后图片的磁盘缓存目录（为空或缺省时不缓存，每次启动都解码PNG）
+    std::shared_ptr<RawImageCache> rawImageCache;
+    if (std::string dir = engineConfig->getString("Loading", "TextureCacheDir", ""); !dir.empty()) {
+        rawImageCache = std::make_shared<RawImageCache>(dir);
+    }
+    // 加载阶段的耗时（每个文件的解码与上传）记录到profiler
+    auto profiler = std::make_shared<Profiler>();
+
+    // 纹理常驻预算：菜单与关卡共用一个纹理缓存，超出预算时驱逐最久没有绘制的纹理
+    TextureCache::Budget residencyBudget;
+    float prefetchSliceMs = 2.0f;
+    auto loadResidencySettings = [&]() {
+        residencyBudget.gpuBytes   = static_cast<std::size_t>(std::max(0, engineConfig->getInt("Residency", "GpuBudgetMB", 0))) * 1024 * 1024;
+        residencyBudget.cpuBytes   = static_cast<std::size_t>(std::max(0, engineConfig->getInt("Residency", "CpuBudgetMB", 0))) * 1024 * 1024;
+        residencyBudget.idleFrames = static_cast<std::uint32_t>(std::max(0, engineConfig->getInt("Residency", "IdleFrames", static_cast<int>(residencyBudget.idleFrames))));
+        prefetchSliceMs = engineConfig->getFloat("Residency", "PrefetchSliceMs", prefetchSliceMs);
+    };
+    loadResidencySettings();
+    auto textureCache = std::make_shared<TextureCache>();
+    textureCache->setBudget(residencyBudget);
+    textureCache->setRawImageCache(rawImageCache);
+    textureCache->setProfiler(profiler);
 
     // 创建菜单场景
     std::shared_ptr<Scene> menuScene = std::make_shared<Scene>();
+    menuScene->setRenderSettings(renderSettings);
+    menuScene->setTaskScheduler(taskScheduler);
+    menuScene->setDecodeScheduler(decodeScheduler);
+    menuScene->setProfiler(profiler);
+    menuScene->setRawImageCache(rawImageCache);
+    menuScene->setTextureCache(textureCache);
+    menuScene->setMergeStaticBlocks(mergeStaticBlocks);
+    menuScene->setTimestepSettings(timestepSettings);
     menuScene->init(
         menupth,
         eventSys,
@@ -68,9 +151,19 @@ int main()
     );
     menuScene->setUseParallaxWithCamera(false); // 菜单使用基于时间的自动滚动
 
-    // 创建关卡场景
+    // 创建关卡场景：在菜单显示期间后台预加载
     std::shared_ptr<Scene> level1Scene = std::make_shared<Scene>();
-    level1Scene->init(
+    level1Scene->setRenderSettings(renderSettings);
+    level1Scene->setStreamSettings(streamSettings);
+    level1Scene->setSimLodSettings(lodSettings);
+    level1Scene->setTaskScheduler(taskScheduler);
+    level1Scene->setDecodeScheduler(decodeScheduler);
+    level1Scene->setProfiler(profiler);
+    level1Scene->setRawImageCache(rawImageCache);
+    level1Scene->setTextureCache(textureCache);
+    level1Scene->setMergeStaticBlocks(mergeStaticBlocks);
+    level1Scene->setTimestepSettings(timestepSettings);
+    level1Scene->beginAsyncInit(
         level1pth,
         eventSys,
         windowPtr,
@@ -78,28 +171,141 @@ int main()
     );
     level1Scene->setUseParallaxWithCamera(true); // 关卡使用基于相机的视差滚动
 
-    // 创建玩家对象（先给 level1 用的）
-    std::shared_ptr<Player> player = std::make_shared<Player>(
-        eventSys,
-        windowPtr,
-        level1Scene->getWorldId(),
-        gameInput
-    );
-    player->initialize();
-    player->setSpawnPosition(100.0f, 500.0f);
-    level1Scene->setPlayerPtr(player);
+    // 玩家对象（level1 加载完成、物理世界创建之后再创建）
+    std::shared_ptr<Player> player;
+    // 玩家手感参数（engine.ini的[Player]节）
+    auto loadPlayerTuning = [&]() {
+        if (!player) {
+            return;
+        }
+        // 缺失的键保持玩家当前的值（第一次调用时即Player中的缺省值）
+        player->setMoveSpeed(engineConfig->getFloat("Player", "MoveSpeed", player->getMoveSpeed()));
+        player->setJumpSpeed(engineConfig->getFloat("Player", "JumpSpeed", player->getJumpSpeed()));
+        player->setBuoyancyAcc(engineConfig->getFloat("Player", "BuoyancyAcc", player->getBuoyancyAcc()));
+        player->setWaterDrag(engineConfig->getFloat("Player", "WaterDrag", player->getWaterDrag()));
+    };
+    auto finishLevel1Setup = [&]() {
+        // 相机右边界来自关卡数据
+        display->camera.setHorizontalBounds(0.0f, level1Scene->getLevelWidth());
+
+        player = std::make_shared<Player>(
+            eventSys,
+            windowPtr,
+            level1Scene->getWorldId(),
+            gameInput
+        );
+        player->initialize();
+        player->setSpawnPosition(100.0f, 500.0f);
+        loadPlayerTuning();
+        level1Scene->setPlayerPtr(player);
+        // 关卡记录最近若干帧的完整状态，按住Backspace逐帧回放
+        level1Scene->enableRollback(rollbackFrames, rollbackSlotBytes);
+        printf("Level1 preloaded.\n");
+        // 菜单与关卡的加载耗时
+        for (const Profiler::Event& e : profiler->getEvents()) {
+            if (e.category == "decode" || e.category == "cached") {
+                printf("[Profiler] %-6s %8.2f ms  %s\n", e.category.c_str(), e.ms, e.name.c_str());
+            }
+        }
+        if (rawImageCache) {
+            printf("[RawImageCache] %llu hit(s), %llu miss(es)\n",
+                   static_cast<unsigned long long>(rawImageCache->getHits()),
+                   static_cast<unsigned long long>(rawImageCache->getMisses()));
+        }
+        profiler->report();
+    };
+    // 在菜单按下Space时关卡还没加载完，加载完成后自动进入
+    bool level1Requested = false;
 
     // 当前场景：初始为菜单
     std::string            sceneName    = "Menu";
     std::shared_ptr<Scene> currentScene = menuScene;
 
+    // 热重载：engine.ini、音频配置与关卡文件保存后，在下一帧开始时只应用改变的值
+    FileWatcher fileWatcher;
+    fileWatcher.setEventSys(eventSys);
+    if (engineConfig->getBool("HotReload", "Enabled", true)) {
+        fileWatcher.watch("config/engine.ini", [&](const std::string& path) {
+            std::shared_ptr<const ConfigLoader> next = ConfigLoader::reload(path);
+            if (!next) {
+                return;
+            }
+            std::vector<std::pair<std::string, std::string>> changes = engineConfig->diff(*next);
+            engineConfig = next;
+            bool timestepChanged = false, lodChanged = false, residencyChanged = false, playerChanged = false;
+            for (const auto& [section, key] : changes) {
+                if (section == "Engine" && key == "DeltaTime") {
+                    deltaTime = engineConfig->getFloat(section, key, deltaTime);
+                } else if (section == "Engine" && key == "subStepCount") {
+                    subStepCount = engineConfig->getInt(section, key, subStepCount);
+                } else if (section == "Engine" && (key == "PhysicsRate" || key == "MaxPhysicsSteps" || key == "Interpolate")) {
+                    timestepChanged = true;
+                } else if (section == "Display" && key == "FrameLimit") {
+                    display->window.setFramerateLimit(static_cast<unsigned>(std::max(0, engineConfig->getInt(section, key, 60))));
+                } else if (section == "Loading" && key == "SliceBudgetMs") {
+                    loadSliceMs = engineConfig->getFloat(section, key, loadSliceMs);
+                } else if (section == "SimLOD") {
+                    lodChanged = true;
+                } else if (section == "Residency") {
+                    residencyChanged = true;
+                } else if (section == "Player") {
+                    playerChanged = true;
+                } else {
+                    // 窗口尺寸、线程数、图集与区块尺寸等在启动时决定
+                    printf("[HotReload] [%s] %s takes effect after a restart\n", section.c_str(), key.c_str());
+                    continue;
+                }
+                printf("[HotReload] [%s] %s updated\n", section.c_str(), key.c_str());
+            }
+            if (timestepChanged) {
+                loadTimestepSettings();
+                menuScene->setTimestepSettings(timestepSettings);
+                level1Scene->setTimestepSettings(timestepSettings);
+            }
+            if (lodChanged) {
+                loadLodSettings();
+                level1Scene->setSimLodSettings(lodSettings);
+            }
+            if (residencyChanged) {
+                loadResidencySettings();
+                textureCache->setBudget(residencyBudget);
+            }
+            if (playerChanged) {
+                loadPlayerTuning();
+            }
+        });
+        fileWatcher.watch("config/audio_config.json", [&](const std::string& path) {
+            for (const std::shared_ptr<Scene>& scene : {menuScene, level1Scene}) {
+                if (std::shared_ptr<AudioManager> audio = scene->getAudioManager()) {
+                    audio->reloadConfig(path);
+                }
+            }
+        });
+        fileWatcher.watch(menupth, [&](const std::string&) {
+            menuScene->reloadLevelFile();
+        });
+        fileWatcher.watch(level1pth, [&](const std::string&) {
+            if (level1Scene->reloadLevelFile()) {
+                display->camera.setHorizontalBounds(0.0f, level1Scene->getLevelWidth());
+            }
+        });
+    }
+
     // 进入主循环
     printf("Entering main loop.\n");
+    sf::Time lastFrameStartTime = eventSys->getElapsedTime();
 
     while (display->window.isOpen())
     {
+        // 帧边界：应用上一帧检测到的文件修改（热重载）
+        eventSys->executeFrameEvents();
+
         // 记录帧开始时间
         sf::Time frameStartTime = eventSys->getElapsedTime();
+        // 固定频率步进时场景按实际帧间隔累积时间（限制上限，避免断点或拖动窗口后一次补太多）
+        float frameTime = std::min((frameStartTime - lastFrameStartTime).asSeconds(), 0.25f);
+        lastFrameStartTime = frameStartTime;
+        float sceneDeltaTime = timestepSettings.physicsRate > 0.0f ? frameTime : deltaTime;
 
         // 清空窗口内容
         display->clear();
@@ -117,7 +323,7 @@ int main()
         auto cameraUpdateEvent = [&display, &player, &sceneName, &currentScene]() {
             if (sceneName == "Level1") {
                 if (player) {
-                    sf::Vector2f playerPos = player->getPosition();
+                    sf::Vector2f playerPos = player->getRenderPosition();
                     display->camera.updateFollowPoint(playerPos);
                 }
                 // 将相机位置传递给场景（用于视差背景）
@@ -131,10 +337,37 @@ int main()
         };
         eventSys->regImmEvent(EventSys::ImmEventPriority::PRE_UPDATE, cameraUpdateEvent);
 
+        // 推进 level1 的后台加载（每帧只占用一小段主线程时间）
+        if (!player && level1Scene->pollAsyncInit(loadSliceMs)) {
+            finishLevel1Setup();
+        }
+
         // 场景更新 & 渲染
-        currentScene->update(deltaTime, subStepCount);
+        currentScene->update(sceneDeltaTime, subStepCount);
         currentScene->render();
 
+        // 菜单上显示关卡加载进度条
+        if (sceneName == "Menu" && !player) {
+            float progress = level1Scene->getLoadProgress();
+            eventSys->regImmEvent(EventSys::ImmEventPriority::DRAWPLAYER, [&display, progress]() {
+                sf::View view       = display->window.getView();
+                sf::Vector2f size   = view.getSize();
+                sf::Vector2f origin = view.getCenter() - size * 0.5f;
+                sf::Vector2f barSize(size.x * 0.4f, 12.0f);
+                sf::Vector2f barPos(origin.x + (size.x - barSize.x) * 0.5f, origin.y + size.y - 60.0f);
+
+                sf::RectangleShape back(barSize);
+                back.setPosition(barPos);
+                back.setFillColor(sf::Color(0, 0, 0, 150));
+                display->window.draw(back);
+
+                sf::RectangleShape fill({barSize.x * progress, barSize.y});
+                fill.setPosition(barPos);
+                fill.setFillColor(sf::Color(230, 230, 230));
+                display->window.draw(fill);
+            });
+        }
+
         // 执行事件系统中的即时事件和定时事件
         eventSys->executeImmEvents();
         eventSys->executeTimedEvents();
@@ -142,6 +375,11 @@ int main()
         // 显示渲染结果
         display->display();
 
+        // 本帧绘制结束：在时间片内重新加载预取的纹理，超出预算时驱逐
+        textureCache->update(prefetchSliceMs);
+        // 检查监视的文件，改变的在下一帧开始时应用
+        fileWatcher.poll();
+
         // 控制帧率
         sf::Time frameEndTime = eventSys->getElapsedTime();
         float    frameDuration = frameEndTime.asSeconds() - frameStartTime.asSeconds();
@@ -157,36 +395,28 @@ int main()
 
         // 小工具函数：重置 Level1 场景 + 玩家
         auto resetLevel1 = [&]() {
+            // 从快照恢复关卡，玩家对象复用（在reload中回到出生点）
             level1Scene->reload();
 
-            // 删除旧玩家对象
-            player.reset();
-
-            // 使用新的 worldId 创建新玩家
-            player = std::make_shared<Player>(
-                eventSys,
-                windowPtr,
-                level1Scene->getWorldId(),
-                gameInput
-            );
-            player->initialize();
-            player->setSpawnPosition(100.0f, 500.0f);
-
-            // 重新添加玩家指针
-            level1Scene->setPlayerPtr(player);
-
             printf("Level1 scene reloaded.\n");
         };
 
         if (sceneName == "Menu")
         {
-            // 从菜单进入关卡：按 Space
+            // 从菜单进入关卡：按 Space（关卡还在加载时等加载完成再进入）
             GameInputRead::KeyState spaceState =
                 gameInput->getKeyState(sf::Keyboard::Key::Space);
             if (spaceState == GameInputRead::KeyState::KEY_PRESSED)
             {
+                level1Requested = true;
+            }
+            if (level1Requested && player)
+            {
+                level1Requested = false;
                 // 每次从菜单进入关卡前，重置一次关卡和玩家
                 resetLevel1();
+                // 菜单期间被驱逐的关卡纹理在进入前几帧里分片重新加载
+                level1Scene->prefetchTextures();
 
                 currentScene = level1Scene;
                 sceneName    = "Level1";
@@ -195,6 +425,10 @@ int main()
         }
         else if (sceneName == "Level1")
         {
+            // Backspace：按住时逐帧回放
+            level1Scene->setRewinding(
+                gameInput->getKeyState(sf::Keyboard::Key::Backspace) != GameInputRead::KeyState::KEY_RELEASED);
+
             // R：重载关卡
             GameInputRead::KeyState rState =
                 gameInput->getKeyState(sf::Keyboard::Key::R);
@@ -210,6 +444,7 @@ int main()
                     gameInput->getKeyState(sf::Keyboard::Key::Space);
                 if (spaceState == GameInputRead::KeyState::KEY_PRESSED)
                 {
+                    menuScene->prefetchTextures();
                     currentScene = menuScene;
                     sceneName    = "Menu";
 
@@ -225,6 +460,7 @@ int main()
                 gameInput->getKeyState(sf::Keyboard::Key::Escape);
             if (escState == GameInputRead::KeyState::KEY_PRESSED)
             {
+                menuScene->prefetchTextures();
                 currentScene = menuScene;
                 sceneName    = "Menu";
 
@@ -1,7 +1,7 @@
 // 包含必要的头文件
 #include "../include/AudioManager.hpp"
 #include <iostream>       // 控制台输出
-#include <fstream>        // 文件操作
+#include "AssetPack.hpp"  // 资源包读取
 #include <nlohmann/json.hpp>  // JSON解析库
 #include <algorithm>  // for std::clamp
 
@@ -81,9 +81,10 @@ void AudioManager::draw() {
 
 // ================= 加载音频配置 =================
 void AudioManager::loadAudioConfig(const std::string& configPath) {
-    // 打开配置文件
-    std::ifstream file(configPath);
-    if (!file.is_open()) {
+    // 读取配置文件（资源包中直接使用映射内存）
+    std::string storage;
+    std::string_view text;
+    if (!AssetVfs::readText(configPath, storage, text)) {
         // 文件打开失败，输出错误信息
         std::cerr << "[AudioManager] Failed to load audio config: " << configPath << std::endl;
         return;  // 提前返回
@@ -91,9 +92,7 @@ void AudioManager::loadAudioConfig(const std::string& configPath) {
     
     try {
         // 解析JSON文件
-        json config;
-        file >> config;
-        file.close();  // 关闭文件
+        json config = json::parse(text.begin(), text.end());
         
         // 读取主音量设置
         if (config.contains("master_volume")) {
@@ -135,6 +134,70 @@ void AudioManager::loadAudioConfig(const std::string& configPath) {
     }
 }
 
+// ================= 重新加载音频配置 =================
+void AudioManager::reloadConfig(const std::string& configPath) {
+    // 读取磁盘上刚编辑过的文件（资源包中是打包时的旧内容）
+    std::string storage;
+    std::string_view text;
+    if (!AssetVfs::readText(configPath, storage, text, true)) {
+        std::cerr << "[AudioManager] Failed to reload audio config: " << configPath << std::endl;
+        return;
+    }
+
+    json config;
+    try {
+        config = json::parse(text.begin(), text.end());
+    } catch (const json::exception& e) {
+        // 编辑到一半的文件：保留当前设置，下次保存再试
+        std::cerr << "[AudioManager] JSON parsing error: " << e.what() << std::endl;
+        return;
+    }
+
+    // 音量：只在数值改变时重新设置
+    if (config.contains("master_volume") && config["master_volume"].is_number()) {
+        float volume = config["master_volume"].get<float>();
+        if (volume != m_masterVolume) {
+            setMasterVolume(volume);
+        }
+    }
+    if (config.contains("music_volume") && config["music_volume"].is_number()) {
+        float volume = config["music_volume"].get<float>();
+        if (volume != m_musicVolume) {
+            setMusicVolume(volume);
+        }
+    }
+
+    // 音乐映射：当前曲目的文件改变时重新播放
+    bool restartCurrent = false;
+    if (config.contains("music") && config["music"].is_object()) {
+        for (auto& [key, value] : config["music"].items()) {
+            if (!value.is_string()) {
+                continue;
+            }
+            std::string filePath = value.get<std::string>();
+            auto it = m_musicFiles.find(key);
+            if (it != m_musicFiles.end() && it->second == filePath) {
+                continue;
+            }
+            bool current = key == m_currentMusicName && m_musicState == AudioState::PLAYING;
+            if (current) {
+                // 新文件打不开（路径写错等）时继续播放原来的曲目
+                sf::Music probe;
+                if (!AssetVfs::open(probe, filePath)) {
+                    std::cerr << "[AudioManager] Cannot open " << filePath << ", keeping " << key << std::endl;
+                    continue;
+                }
+                restartCurrent = true;
+            }
+            m_musicFiles[key] = filePath;
+            std::cout << "[AudioManager] Reloaded music: " << key << " -> " << filePath << std::endl;
+        }
+    }
+    if (restartCurrent) {
+        playMusic(m_currentMusicName);
+    }
+}
+
 // ================= 播放音乐 =================
 void AudioManager::playMusic(const std::string& musicName) {
     // 检查请求的音乐是否存在
@@ -155,7 +218,8 @@ void AudioManager::playMusic(const std::string& musicName) {
     m_currentMusic = std::make_unique<sf::Music>();
     
     // 尝试打开音乐文件
-    if (!m_currentMusic->openFromFile(filePath)) {
+    // 资源包中的音乐直接从映射内存流式读取
+    if (!AssetVfs::open(*m_currentMusic, filePath)) {
         std::cerr << "[AudioManager] Failed to load music file: " << filePath << std::endl;
         m_currentMusic.reset();  // 重置智能指针
         return;  // 文件加载失败，提前返回
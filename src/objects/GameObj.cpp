@@ -1,4 +1,6 @@
 #include "../include/GameObj.hpp"
+#include "AssetPack.hpp"
+#include <algorithm>
 #include <cmath>
 
 BaseObj::BaseObj(){
@@ -23,7 +25,16 @@ void BaseObj::update(const float deltaTime) {
 }
 
 void BaseObj::draw() {
-    // 默认绘制行为，通过任务系统调度绘制事件
+    // 默认绘制行为，在DRAW图层绘制
+    submitDraw(EventSys::ImmEventPriority::DRAW);
+}
+
+void BaseObj::submitDraw(const EventSys::ImmEventPriority priority) {
+    // 通过任务系统调度绘制事件
+    // 已烘焙进静态区块的对象由区块统一绘制
+    if (hasFeature("baked")) {
+        return;
+    }
     // 检查类是否为可以画图的对象
     if (features.find("drawable") == features.end() || !features.at("drawable")) {
         // 该对象不支持绘制
@@ -36,6 +47,11 @@ void BaseObj::draw() {
         printf("No sprite available for drawing.\n");
         return;
     }
+    // 有合批渲染器时只提交sprite，由批次在该图层统一生成顶点并绘制
+    if (auto batch = batchPtr.lock()) {
+        batch->submit(priority, sprite.value(), spriteDirty());
+        return;
+    }
     // envrntSys不是optional类型，直接lock
     auto eventSys = eventSysPtr.lock();
     // 先从optional中取出weak_ptr指针,再对取出的weak_ptr进行lock操作
@@ -43,9 +59,12 @@ void BaseObj::draw() {
         auto window = windowPtr.value().lock();
         if (eventSys && window) {
             auto drawEvent = [this, window]() {
+                if (auto cache = textureCachePtr.lock()) {
+                    cache->touch(&this->sprite->getTexture());
+                }
                 window->draw(this->sprite.value());
             };
-            eventSys->regImmEvent(EventSys::ImmEventPriority::DRAW, drawEvent);
+            eventSys->regImmEvent(priority, drawEvent);
             // printf("Draw event registered.\n");
         }
         else {
@@ -68,6 +87,43 @@ void BaseObj::regTimedEvent(const sf::Time delay, const EventSys::EventFunc& fun
     }
 }
 
+sf::FloatRect BaseObj::getRenderBounds() const {
+    if (!sprite.has_value()) {
+        return sf::FloatRect();
+    }
+    return sprite->getGlobalBounds();
+}
+
+bool BaseObj::loadSpriteTexture(const std::string& path) {
+    // 优先使用图集：sprite直接引用图集页上的子矩形，同页的对象可以合批绘制
+    if (auto atlas = atlasPtr.lock()) {
+        if (const TextureAtlas::Region* region = atlas->find(path)) {
+            sprite.emplace(atlas->getPage(region->page), region->rect);
+            textureRect = region->rect;
+            return true;
+        }
+    }
+    // 不在图集中（图片过大或者没有图集），通过纹理缓存与同路径的对象共享纹理
+    if (auto cache = textureCachePtr.lock()) {
+        sharedTexture = cache->acquire(path);
+        if (!sharedTexture) {
+            return false;
+        }
+        sprite.emplace(*sharedTexture);
+        textureRect = sf::IntRect({0, 0}, sf::Vector2i(sharedTexture->getSize()));
+        return true;
+    }
+    // 没有缓存时单独加载纹理
+    texture.emplace();
+    if (!AssetVfs::load(*texture, path)) {
+        texture.reset();
+        return false;
+    }
+    sprite.emplace(texture.value());
+    textureRect = sf::IntRect({0, 0}, sf::Vector2i(texture->getSize()));
+    return true;
+}
+
 // -------------------------------- GraphicObj类实现 --------------------------------
 GraphicObj::GraphicObj() : BaseObj() {
     // 构造函数
@@ -77,15 +133,19 @@ GraphicObj::~GraphicObj() {
     // 析构函数
 }
 
-void GraphicObj::initialize(const ResourceLoader::ResourceDict& objConfig) {
+void GraphicObj::initialize(const GraphicDesc& desc) {
     // 初始化图形对象
     // Debug
     printf(".............Initializing GraphicObj...........\n");
     // 设置特征，例如支持绘制
     features["drawable"] = true;
+    features["cullable"] = true;
+    features["static"] = true;
     // 设置图形类型
-    std::string typeStr = std::get<std::string>(objConfig.at("type"));
-    // 解析objConfig以设置图形类型（BACKGROUND或BUTTON）
+    const std::string& typeStr = desc.type;
+    // 背景图形不会变化，可以烘焙进静态区块（按钮可能有交互效果，保持单独绘制）
+    features["bakeable"] = (typeStr == "BACKGROUND");
+    // 根据desc设置图形类型（BACKGROUND或BUTTON）
     if (typeStr == "BACKGROUND") {
         // 处理背景图形的特定初始化
         // Debug
@@ -99,19 +159,15 @@ void GraphicObj::initialize(const ResourceLoader::ResourceDict& objConfig) {
     }
     // Debug
     printf("..........Loading Texture and Setting Sprite..........\n");
-    // 解析objConfig以设置纹理等
-    std::string texturePath = std::get<std::string>(objConfig.at("texture"));
+    // 根据desc设置纹理等
+    const std::string& texturePath = desc.texture;
     printf("Texture Path: %s\n", texturePath.c_str());
-    texture.emplace();
-    if (texture->loadFromFile(texturePath)) {
-        sprite.emplace(texture.value());
+    if (loadSpriteTexture(texturePath)) {
         // Debug
         printf("Texture and Sprite Loaded.\n");
     }
     // 设置纹理位置
-    float posX = std::get<float>(objConfig.at("x"));
-    float posY = std::get<float>(objConfig.at("y"));
-    sf::Vector2f position(posX, posY);
+    sf::Vector2f position(desc.x, desc.y);
     if (sprite.has_value()) {
         sprite->setPosition(position);
     }
@@ -144,22 +200,8 @@ void GraphicObj::draw() {
         // 没有可用的Sprite进行绘制
         return;
     }
-    // envrntSys不是optional类型，直接lock
-    auto eventSys = eventSysPtr.lock();
-    // 先从optional中取出weak_ptr指针,再对取出的weak_ptr进行lock操作
-    if (windowPtr.has_value()) {
-        auto window = windowPtr.value().lock();
-        if (eventSys && window) {
-            auto drawEvent = [this, window]() {
-                window->draw(this->sprite.value());
-            };
-            eventSys->regImmEvent(EventSys::ImmEventPriority::DRAWBACKGROUND, drawEvent);
-            // printf("Draw event registered.\n");
-        }
-        else {
-            // 无法绘制，可能需要记录日志或抛出异常
-        }
-    }
+    // 图形对象画在背景图层
+    submitDraw(EventSys::ImmEventPriority::DRAWBACKGROUND);
 }
 
 
@@ -170,17 +212,32 @@ Block::Block() : BaseObj() {
 }
 
 Block::~Block() {
-    // 析构函数
+    // 析构函数：释放方块存储中的数据
+    if (store) {
+        store->destroy(entity);
+    }
 }
 
-void Block::initialize(const ResourceLoader::ResourceDict& objConfig) {
+void Block::initialize(const BlockDesc& desc) {
     // 初始化方块对象
     // 设置特征，例如支持绘制
     features["drawable"] = true;
     features["box2d"] = true;
-    // 解析objConfig以设置方块类型和生命值
-    std::string typeStr = std::get<std::string>(objConfig.at("type"));
-    health = std::get<float>(objConfig.at("health"));
+    features["cullable"] = true;
+    features["static"] = true;
+    features["bakeable"] = true;
+    // 方块没有逐帧逻辑，Scene不为它注册update；接触判定由BlockSystem扫描方块存储完成
+    features["entity"] = true;
+
+    if (!store) {
+        store = std::make_shared<BlockStore>();
+    }
+    entity = store->create();
+    std::size_t i = store->index(entity);
+    // 根据desc设置方块类型和生命值
+    const std::string& typeStr = desc.type;
+    store->health[i] = desc.health;
+    BlockType blockType = GRASS;
     // 根据typeStr设置blockType
     if (typeStr == "GRASS") {
         blockType = GRASS;
@@ -192,48 +249,60 @@ void Block::initialize(const ResourceLoader::ResourceDict& objConfig) {
         blockType = LAVA;
     }
     // 加载纹理和设置Sprite
-    std::string texturePath = std::get<std::string>(objConfig.at("texture"));
-    texture.emplace();
-    if (texture->loadFromFile(texturePath)) {
-        sprite.emplace(texture.value());
-    }
+    loadSpriteTexture(desc.texture);
     // 设置纹理位置
-    float posX = std::get<float>(objConfig.at("x"));
-    float posY = std::get<float>(objConfig.at("y"));
+    float posX = desc.x;
+    float posY = desc.y;
     sf::Vector2f position(posX, posY);
     if (sprite.has_value()) {
         sprite->setPosition(position);
     }
 
     // 设置碰撞箱参数等（根据不同type）
-    float width = std::get<float>(objConfig.at("width"));
-    float height = std::get<float>(objConfig.at("height"));
-    b2BodyDef groundBodyDef = b2DefaultBodyDef();
-    b2Vec2 Bodyposition = {posX+width/2, posY+height/2};
-    groundBodyDef.position = Bodyposition; // Box2D坐标系中心点
-    groundBodyDef.type = b2_staticBody; // 静态物体
-    // 创建Box2D实体和形状
-    groundId = b2CreateBody(*worldPtr->lock(), &groundBodyDef);
-    // b2Polygon groundBox = b2MakeBox(width/2, height/2);
-    // Debug
-    printf("Block Box2D body created at (%.2f, %.2f) with size (%.2f, %.2f)\n", posX, posY, width, height);
-    b2Polygon groundBox;
+    float width = desc.width;
+    float height = desc.height;
     // 微调碰撞箱位置（根据不同类型）
+    float offsetY = 0.0f;
     if (blockType == GRASS) {
-        groundBox = b2MakeOffsetBox(width/2, height/2, {0.0f, -height*0.65f}, b2Rot_identity);
+        offsetY = -height*0.65f;
         // 设置草地方块的物理属性
         // 草方块作为固定平台（不可破坏）
     }else if (blockType == WATER) {
-        groundBox = b2MakeOffsetBox(width/2, height/2, {0.0f, -height*0.65f}, b2Rot_identity);
+        offsetY = -height*0.65f;
         // 设置水地方块的属性
     }else if (blockType == ICE) {
-        groundBox = b2MakeOffsetBox(width/2, height/2, {0.0f, -height*0.55f}, b2Rot_identity);
+        offsetY = -height*0.55f;
         // 设置冰地方块的属性
     }else if (blockType == LAVA) {
-        groundBox = b2MakeOffsetBox(width/2, height/2, {0.0f, -height*0.50f}, b2Rot_identity);
+        offsetY = -height*0.50f;
         // 设置熔岩地方块的属性
     }
+    store->type[i]      = blockType;
+    store->collision[i] = sf::FloatRect({posX, posY + offsetY}, {width, height});
+    // 判定用的包围盒与原来的getHitBox相同（sprite的全局包围盒），方块不移动，初始化时记录一次
+    if (sprite.has_value()) {
+        sf::FloatRect bounds = sprite->getGlobalBounds();
+        store->left[i]   = bounds.position.x;
+        store->top[i]    = bounds.position.y;
+        store->right[i]  = bounds.position.x + bounds.size.x;
+        store->bottom[i] = bounds.position.y + bounds.size.y;
+    }
+    // 合并碰撞时由Scene统一创建实体
+    if (mergedCollision) {
+        return;
+    }
+    b2BodyDef groundBodyDef = b2DefaultBodyDef();
+    b2Vec2 Bodyposition = {posX+width/2, posY+height/2};
+    groundBodyDef.position = Bodyposition; // Box2D坐标系中心点
+    groundBodyDef.type = b2_staticBody; // 静态物体
+    // 创建Box2D实体和形状
+    b2BodyId groundId = b2CreateBody(*worldPtr->lock(), &groundBodyDef);
+    store->body[i] = groundId;
+    // Debug（区块流式加载时每个方块都会创建，默认不输出）
+    // printf("Block Box2D body created at (%.2f, %.2f) with size (%.2f, %.2f)\n", posX, posY, width, height);
+    b2Polygon groundBox = b2MakeOffsetBox(width/2, height/2, {0.0f, offsetY}, b2Rot_identity);
     b2ShapeDef groundShapeDef = b2DefaultShapeDef ();
+    groundShapeDef.material.userMaterialId = blockType;
     b2CreatePolygonShape (groundId, &groundShapeDef, &groundBox);
 }
 
@@ -250,17 +319,43 @@ void Block::update(float deltaTime) {
     // 例如处理与玩家的交互、动画等
 }
 
+void Block::draw() {
+    // 被破坏的方块不再绘制
+    if (isDestroyed()) {
+        return;
+    }
+    BaseObj::draw();
+}
+
+Block::BlockType Block::getBlockType() const {
+    return store ? static_cast<BlockType>(store->type[store->index(entity)]) : GRASS;
+}
+
+bool Block::isDestroyed() const {
+    return store && store->destroyed[store->index(entity)] != 0;
+}
+
+const sf::FloatRect& Block::getCollisionRect() const {
+    return store->collision[store->index(entity)];
+}
+
 sf::FloatRect Block::getHitBox() const {
-    // 如果没有 sprite，就返回一个空矩形
-    if (!sprite.has_value()) {
+    // 如果没有 sprite 或方块已被破坏，就返回一个空矩形
+    if (!sprite.has_value() || !store || isDestroyed()) {
         return sf::FloatRect();
     }
-    // 直接用 SFML 自带的全局包围盒作为 hitbox
-    return sprite->getGlobalBounds();
+    // 初始化时记录的sprite全局包围盒
+    std::size_t i = store->index(entity);
+    return sf::FloatRect({store->left[i], store->top[i]},
+                         {store->right[i] - store->left[i], store->bottom[i] - store->top[i]});
 }
 
 
 void Block::onhit(float damage) {
+    if (!store) {
+        return;
+    }
+    float& health = store->health[store->index(entity)];
     health -= damage;
     if (health < 0) {
         onkill();
@@ -268,9 +363,49 @@ void Block::onhit(float damage) {
     }
 }
 
+void Block::saveState(ObjectState& state) const {
+    // 方块不会移动，只记录血量；被破坏的方块不再重新创建
+    if (!store) {
+        return;
+    }
+    std::size_t i = store->index(entity);
+    state.valid  = 1;
+    state.alive  = store->destroyed[i] ? 0 : 1;
+    state.health = store->health[i];
+    if (sprite.has_value()) {
+        state.x = sprite->getPosition().x;
+        state.y = sprite->getPosition().y;
+    }
+}
+
+void Block::loadState(const ObjectState& state) {
+    if (store) {
+        store->health[store->index(entity)] = state.health;
+    }
+}
+
+void Block::releasePhysics() {
+    if (!store) {
+        return;
+    }
+    b2BodyId& groundId = store->body[store->index(entity)];
+    if (b2Body_IsValid(groundId)) {
+        b2DestroyBody(groundId);
+    }
+    groundId = b2_nullBodyId;
+}
+
 void Block::onkill() {
-    // 方块被破坏时的处理逻辑
-    // 例如播放破坏动画、移除方块等
+    // 方块被破坏时的处理逻辑：移除碰撞体，不再绘制
+    if (!store || isDestroyed()) {
+        return;
+    }
+    store->destroyed[store->index(entity)] = 1;
+    releasePhysics();
+    // 通知场景（烘焙过的方块需要重建所在的静态区块）
+    if (killCallback) {
+        killCallback(*this);
+    }
 }
 
 // -------------------------------- Enemy类实现 --------------------------------
@@ -279,51 +414,55 @@ void Block::onkill() {
     }
 
     Enemy::~Enemy() {
-        // 析构函数
+        // 析构函数：释放实体存储中的数据，实体不再指向本对象
+        if (b2Body_IsValid(bodyId)) {
+            b2Body_SetUserData(bodyId, nullptr);
+        }
+        if (store) {
+            store->destroy(entity);
+        }
     }
 
-    void Enemy::initialize(const ResourceLoader::ResourceDict& objConfig) {
+    void Enemy::initialize(const EnemyDesc& desc) {
         // 初始化敌人对象
-        // 设置特征，例如支持绘制和Box2D物理
+        // 设置特征，例如支持绘制和Box2D物理，逐帧更新由EnemySystem批量完成
         features["drawable"] = true;
         features["box2d"]    = true;
+        features["cullable"] = true;
+        features["entity"]   = true;
+
+        if (!store) {
+            store = std::make_shared<EntityStore>();
+        }
+        entity = store->create();
+        std::size_t i = store->index(entity);
 
         // 基本属性
-        maxHealth      = std::get<float>(objConfig.at("health"));
-        health         = maxHealth;
-        attackDamage   = std::get<float>(objConfig.at("attackDamage"));
-        attackCooldown = std::get<float>(objConfig.at("attackCooldown"));
-        faceRight      = true;
-        isAlive        = true;
+        store->maxHealth[i]      = desc.health;
+        store->health[i]         = store->maxHealth[i];
+        attackDamage             = desc.attackDamage;
+        store->attackCooldown[i] = desc.attackCooldown;
+        store->faceRight[i]      = 1;
+        store->alive[i]          = 1;
 
         // 敌人巡逻路径，到端点调头
-        patrolPointA = {
-            std::get<float>(objConfig.at("patrolAx")),
-            std::get<float>(objConfig.at("patrolAy"))
-        };
-        patrolPointB = {
-            std::get<float>(objConfig.at("patrolBx")),
-            std::get<float>(objConfig.at("patrolBy"))
-        };
+        store->patrolMinX[i] = desc.patrolAx;
+        store->patrolMaxX[i] = desc.patrolBx;
 
         // ===== 贴图和 Sprite =====
-        std::string texturePath = std::get<std::string>(objConfig.at("texture"));
-        texture.emplace();
-        if (texture->loadFromFile(texturePath)) {
-            sprite.emplace(texture.value());
-        } else {
-            printf("Failed to load enemy texture from %s\n", texturePath.c_str());
+        if (!loadSpriteTexture(desc.texture)) {
+            printf("Failed to load enemy texture from %s\n", desc.texture.c_str());
         }
 
         // ===== Box2D 实体 =====
-        float posX      = std::get<float>(objConfig.at("x"));
-        float posY      = std::get<float>(objConfig.at("y"));
-        float width     = std::get<float>(objConfig.at("width"));
-        float height    = std::get<float>(objConfig.at("height"));
-        float density   = std::get<float>(objConfig.at("density"));
-        float friction  = std::get<float>(objConfig.at("friction"));
-        float velocityX = std::get<float>(objConfig.at("velocityX"));
-        float velocityY = std::get<float>(objConfig.at("velocityY"));
+        float posX      = desc.x;
+        float posY      = desc.y;
+        float width     = desc.width;
+        float height    = desc.height;
+        float density   = desc.density;
+        float friction  = desc.friction;
+        float velocityX = desc.velocityX;
+        float velocityY = desc.velocityY;
 
         boxparams = { width, height };
 
@@ -342,33 +481,42 @@ void Block::onkill() {
         b2CreatePolygonShape(bodyId, &shapeDef, &box);
 
         // 设置初始速度
-        velocity = { velocityX, velocityY };
-        b2Body_SetLinearVelocity(bodyId, velocity);
-
-        // Debug
-        printf("Enemy Box2D body created...\n");
+        b2Body_SetLinearVelocity(bodyId, { velocityX, velocityY });
+        // 移动事件通过userData找到本对象
+        b2Body_SetUserData(bodyId, static_cast<BaseObj*>(this));
+
+        store->body[i]        = bodyId;
+        store->posX[i]        = Bodyposition.x;
+        store->posY[i]        = Bodyposition.y;
+        store->prevX[i]       = Bodyposition.x;
+        store->prevY[i]       = Bodyposition.y;
+        store->halfW[i]       = width * 0.5f;
+        store->halfH[i]       = height * 0.5f;
+        store->patrolSpeed[i] = std::abs(velocityX);
+        store->velX[i]        = velocityX;
+        store->velY[i]        = velocityY;
+
+        // Debug（区块流式加载时每个敌人都会创建，默认不输出）
+        // printf("Enemy Box2D body created...\n");
 
         // ===== 敌人动画：按横向 spritesheet 切帧 =====
         // 假设 enemy.png 是横向 4 帧动画，如果你是 3 帧 / 6 帧就改这个数字
         const int frameCount = 3;
 
-        if (sprite.has_value() && texture.has_value()) {
-            sf::Vector2u texSize = texture->getSize();
+        if (sprite.has_value()) {
+            // 帧矩形以贴图在纹理（或图集页）中的区域为基准
+            sf::Vector2i texSize = textureRect.size;
             if (texSize.x > 0 && texSize.y > 0 && frameCount > 0) {
-                int frameW = static_cast<int>(texSize.x) / frameCount;
-                int frameH = static_cast<int>(texSize.y);
+                int frameW = texSize.x / frameCount;
+                int frameH = texSize.y;
 
                 animFrames.clear();
                 for (int i = 0; i < frameCount; ++i) {
-                    sf::Vector2i pos(i * frameW, 0);
+                    sf::Vector2i pos(textureRect.position.x + i * frameW, textureRect.position.y);
                     sf::Vector2i size(frameW, frameH);
                     animFrames.emplace_back(pos, size);
                 }
 
-                currentAnimFrame = 0;
-                animTimer        = 0.0f;
-                animFrameTime    = 0.15f;  // 每帧 0.15 秒
-
                 if (!animFrames.empty()) {
                     sprite->setTextureRect(animFrames[0]);
                 }
@@ -376,7 +524,14 @@ void Block::onkill() {
 
             // 初始化缩放为 (1,1)，后面只改 x 的正负号来左右翻转
             sprite->setScale(sf::Vector2f{1.0f, 1.0f});
+            store->sprite[i] = &sprite.value();
         }
+
+        store->animFrame[i]      = 0;
+        store->animTimer[i]      = 0.0f;
+        store->animFrameTime[i]  = 0.15f;  // 每帧 0.15 秒
+        store->animFrameCount[i] = static_cast<std::int32_t>(animFrames.size());
+        store->frames[i]         = animFrames.empty() ? nullptr : animFrames.data();
     }
 
     void Enemy::setPtrs(const std::weak_ptr<EventSys>& eventSys,
@@ -390,87 +545,25 @@ void Block::onkill() {
     }
 
     void Enemy::update(float deltaTime) {
-    // Debug
-    // printf("Updating Enemy...\n");
-
-    // 敌人死了就不更新
-    if (!isAlive) return;
-
-    // ========= 1. 巡逻 AI（保持原来的逻辑） =========
-    b2Vec2 position = b2Body_GetPosition(bodyId);
-    if (faceRight) {
-        // 向右移动
-        b2Body_SetLinearVelocity(bodyId, { std::abs(velocity.x), velocity.y });
-        if (position.x >= patrolPointB.x) {
-            faceRight = false; // 到达右端点，调头
-        }
-    } else {
-        // 向左移动
-        b2Body_SetLinearVelocity(bodyId, { -std::abs(velocity.x), velocity.y });
-        if (position.x <= patrolPointA.x) {
-            faceRight = true; // 到达左端点，调头
-        }
-    }
-
-    // 更新一次位置（刚才改了速度）
-    position = b2Body_GetPosition(bodyId);
-
-    // ========= 2. 根据 Box2D 位置更新 Sprite 位置 =========
-    if (sprite.has_value()) {
-        sf::Vector2f spritePosition = {
-            position.x - boxparams.x / 2.0f,
-            position.y - boxparams.y / 2.0f
-        };
-        sprite->setPosition(spritePosition);
-
-        // ========= 3. 帧动画：循环播放 animFrames =========
-        if (!animFrames.empty()) {
-            animTimer += deltaTime;
-            if (animTimer >= animFrameTime) {
-                animTimer -= animFrameTime;
-                currentAnimFrame =
-                    (currentAnimFrame + 1) %
-                    static_cast<int>(animFrames.size());
-            }
-            sprite->setTextureRect(animFrames[currentAnimFrame]);
-        }
-
-        // ========= 4. 左右翻转：根据 faceRight 改 scale.x 的正负 =========
-        sf::Vector2f s = sprite->getScale();
-        if (s.x == 0.0f) s.x = 0.4f;        // 防止刚好是 0，给个默认
-        float sx = std::fabs(s.x);          // 固定大小，只改方向
-
-                // ====== 敌人左右翻转 ======
-        float scaleSize = 0.25f; // 敌人缩小倍数
-
-        if (faceRight) {
-            sprite->setScale(sf::Vector2f{ scaleSize, scaleSize });   // 朝右：x 正
-        } else {
-            sprite->setScale(sf::Vector2f{ -scaleSize, scaleSize });  // 朝左：x 负（镜像）
-        }
-
-    }
-
-    // ========= 5. 攻击冷却（保留原逻辑） =========
-    if (attackCooldown > 0.0f) {
-        attackCooldown -= deltaTime; // 使用传入的deltaTime
-        if (attackCooldown < 0.0f) {
-            attackCooldown = 0.0f;
-        }
+        // 巡逻AI、帧动画、攻击冷却和sprite同步由EnemySystem完成，这里只更新自己这一项
+        // （Scene不逐个调用，而是对整个实体存储批量调用EnemySystem::update）
+        if (!store) return;
+        std::size_t i = store->index(entity);
+        EnemySystem::update(*store, deltaTime, i, i + 1);
     }
-}
 
 
     void Enemy::draw() {
-        if (isAlive) {
+        if (isAliveFlag()) {
             BaseObj::draw();
         }
     }
 
     void Enemy::onhit(float damage) {
         // 已经死亡就不再处理
-        if (!isAlive) return;
+        if (!isAliveFlag()) return;
 
+        float& health = store->health[store->index(entity)];
         health -= damage;
         if (health <= 0.0f) {
             health = 0.0f;
@@ -480,10 +573,89 @@ void Block::onkill() {
 
     void Enemy::onkill() {
         // 敌人被击败时的处理逻辑
-        isAlive = false;
+        std::size_t i = store->index(entity);
+        store->alive[i] = 0;
         printf("Enemy killed!\n");
         b2DestroyBody(bodyId);
-        velocity = {0.0f, 0.0f};
+        store->body[i] = b2_nullBodyId;
+        store->velX[i] = 0.0f;
+        store->velY[i] = 0.0f;
+    }
+
+    void Enemy::saveState(ObjectState& state) const {
+        state.valid = 1;
+        // 被击败的敌人不再重新创建
+        if (!isAliveFlag() || !b2Body_IsValid(bodyId)) {
+            state.alive = 0;
+            return;
+        }
+        // 巡逻状态：实体位置、速度、朝向，以及血量、攻击冷却和动画帧
+        std::size_t i   = store->index(entity);
+        b2Vec2 position = b2Body_GetPosition(bodyId);
+        b2Vec2 linear   = b2Body_GetLinearVelocity(bodyId);
+        state.alive     = 1;
+        state.x         = position.x;
+        state.y         = position.y;
+        state.vx        = linear.x;
+        state.vy        = linear.y;
+        state.awake     = b2Body_IsAwake(bodyId) ? 1 : 0;
+        state.health    = store->health[i];
+        state.timer     = store->attackCooldown[i];
+        state.animTimer = store->animTimer[i];
+        state.animFrame = store->animFrame[i];
+        state.flags     = store->faceRight[i] ? 1 : 0;
+    }
+
+    void Enemy::loadState(const ObjectState& state) {
+        if (!isAliveFlag() || !b2Body_IsValid(bodyId)) {
+            return;
+        }
+        b2Body_SetTransform(bodyId, { state.x, state.y }, b2Rot_identity);
+        b2Body_SetLinearVelocity(bodyId, { state.vx, state.vy });
+        b2Body_SetAwake(bodyId, state.awake != 0);
+        std::size_t i = store->index(entity);
+        store->posX[i]           = state.x;
+        store->posY[i]           = state.y;
+        // 瞬移到快照位置，不从旧位置插值过去
+        store->prevX[i]          = state.x;
+        store->prevY[i]          = state.y;
+        store->awake[i]          = state.awake;
+        store->dirty[i]          = 1;
+        store->health[i]         = state.health;
+        store->attackCooldown[i] = state.timer;
+        store->animTimer[i]      = state.animTimer;
+        store->faceRight[i]      = (state.flags & 1) != 0;
+        if (!animFrames.empty()) {
+            store->animFrame[i] = std::clamp(state.animFrame, 0, static_cast<int>(animFrames.size()) - 1);
+        }
+
+        // sprite与EnemySystem中的同步方式一致
+        if (sprite.has_value()) {
+            sprite->setPosition({ state.x - boxparams.x / 2.0f, state.y - boxparams.y / 2.0f });
+            if (!animFrames.empty()) {
+                sprite->setTextureRect(animFrames[store->animFrame[i]]);
+            }
+            float scaleSize = EnemySystem::spriteScale;
+            sprite->setScale(sf::Vector2f{ store->faceRight[i] ? scaleSize : -scaleSize, scaleSize });
+        }
+    }
+
+    void Enemy::releasePhysics() {
+        if (isAliveFlag() && b2Body_IsValid(bodyId)) {
+            b2DestroyBody(bodyId);
+        }
+        bodyId = b2_nullBodyId;
+        if (store) {
+            std::size_t i = store->index(entity);
+            store->body[i]  = b2_nullBodyId;
+            store->alive[i] = 0;
+        }
+    }
+
+    void Enemy::onBodyMoved(const b2Transform& transform, bool fellAsleep) {
+        if (store) {
+            store->onBodyMoved(entity, transform.p, fellAsleep);
+        }
     }
 
     sf::FloatRect Enemy::getHitBox() const
@@ -512,6 +684,10 @@ Projectile::ProjectileType Projectile::fromString(const std::string& typeStr) {
     return ICE;
 }
 
+std::string Projectile::texturePathFor(ProjectileType type) {
+    return type == FIRE ? "assets/texture/fireball.png" : "assets/texture/iceball.png";
+}
+
 void Projectile::initializeDynamic(ProjectileType type, 
                                    const sf::Vector2f& position, 
                                    bool facingRight) {
@@ -521,6 +697,7 @@ void Projectile::initializeDynamic(ProjectileType type,
     // printf("[Projectile]   FacingRight: %s\n", facingRight ? "true" : "false");
     
     features["drawable"] = true;   
+    features["cullable"] = true;
 
     // 设置类型
     projectileType = type;
@@ -532,12 +709,12 @@ void Projectile::initializeDynamic(ProjectileType type,
     if (type == ProjectileType::ICE) {
         speed = 400.0f;
         damage = 1.0f;
-        texturePath = "assets/texture/iceball.png";
+        texturePath = texturePathFor(type);
         // printf("[Projectile]   ICE - speed=%.2f\n", speed);
     } else if (type == ProjectileType::FIRE) {
         speed = 500.0f;
         damage = 1.0f;
-        texturePath = "assets/texture/fireball.png";
+        texturePath = texturePathFor(type);
         // printf("[Projectile]   FIRE - speed=%.2f\n", speed);
     }
 
@@ -552,16 +729,13 @@ void Projectile::initializeDynamic(ProjectileType type,
     isActive_ = true;
     // printf("[Projectile]   isActive: true\n");
 
-    // 加载贴图（硬编码）
-    texture.emplace();
-    if (!texture->loadFromFile(texturePath)) {
+    // 加载贴图（优先从图集取，子弹频繁生成时不再重复解码图片）
+    if (!loadSpriteTexture(texturePath)) {
         // printf("[Projectile]   ERROR: Failed to load texture from %s\n", texturePath.c_str());
-    } else {
-        // printf("[Projectile]   Texture loaded successfully from %s\n", texturePath.c_str());
+        isActive_ = false;
+        return;
     }
     
-    sprite.emplace(*texture);
-    
     // 设置贴图缩放：x 0.04，y 0.05
     // 方向翻转：朝右是正数，朝左是负数（翻转贴图）
     float scaleX = faceRight ? -0.04f : 0.04f;  // 注意：原始贴图朝左，所以朝右需要翻转
@@ -618,15 +792,30 @@ void Projectile::draw() {
         return;
     }
     
-    if (!texture.has_value()) {
-        // printf("[Projectile::draw] ERROR: No texture!\n");
-        return;
-    }
-    
     BaseObj::draw();
     // printf("[Projectile::draw] BaseObj::draw() completed\n");
 }
 
+void Projectile::saveState(ObjectState& state) const {
+    state.valid = 1;
+    state.alive = isActive_ ? 1 : 0;
+    state.kind  = static_cast<std::int32_t>(projectileType);
+    state.flags = faceRight ? 1 : 0;
+    state.x     = projectilePos.x;
+    state.y     = projectilePos.y;
+    state.timer = lifetime;
+}
+
+void Projectile::loadState(const ObjectState& state) {
+    // 类型和朝向在initializeDynamic时确定，这里只恢复位置和存在时间
+    projectilePos = { state.x, state.y };
+    lifetime      = state.timer;
+    isActive_     = isActive_ && state.alive != 0;
+    if (sprite.has_value()) {
+        sprite->setPosition(projectilePos);
+    }
+}
+
 sf::FloatRect Projectile::getBounds() const
 {
     if (sprite.has_value()) {
@@ -646,7 +835,7 @@ Trap::Trap() : BaseObj() {
 Trap::~Trap() {
 }
 
-void Trap::initialize(const ResourceLoader::ResourceDict& objConfig) {
+void Trap::initialize(const TrapDesc& desc) {
     //重置所有状态变量
     isActive_ = false;
     destroyed_ = false;
@@ -655,9 +844,11 @@ void Trap::initialize(const ResourceLoader::ResourceDict& objConfig) {
 
     // 初始化陷阱对象
     features["drawable"] = true;
+    features["cullable"] = true;
+    features["static"] = true;
 
     // ========== 基础类型 ==========
-    std::string typeStr = std::get<std::string>(objConfig.at("type"));
+    const std::string& typeStr = desc.type;
     if (typeStr == "SPIKE") {
         trapType = TrapType::SPIKE;
         isGoal_ = false;
@@ -670,52 +861,35 @@ void Trap::initialize(const ResourceLoader::ResourceDict& objConfig) {
 
 
     // 伤害（碰到玩家时掉多少血）
-    damage = std::get<float>(objConfig.at("damage"));
+    damage = desc.damage;
 
     // ========== 血量 & 元素 ==========
-    if (objConfig.count("health")) {
-        maxHealth = std::get<float>(objConfig.at("health"));
-        health    = maxHealth;
-    } else {
-        maxHealth = health = 2.0f;   // 默认打两下碎
-    }
+    // 没写health时字段表给出缺省值（打两下碎），没写element时为空
+    maxHealth = health = desc.health;
 
-    if (objConfig.count("element")) {
-        std::string elemStr = std::get<std::string>(objConfig.at("element"));
-        if (elemStr == "FIRE") {
-            element = FIRE_ELEMENT;
-        } else if (elemStr == "ICE") {
-            element = ICE_ELEMENT;
-        } else {
-            element = NEUTRAL;
-        }
+    if (desc.element == "FIRE") {
+        element = FIRE_ELEMENT;
+    } else if (desc.element == "ICE") {
+        element = ICE_ELEMENT;
     } else {
         element = NEUTRAL;
     }
 
     // ========== 触发区域 ==========
-    float triggerX = std::get<float>(objConfig.at("triggerX"));
-    float triggerY = std::get<float>(objConfig.at("triggerY"));
-    float triggerW = std::get<float>(objConfig.at("triggerWidth"));
-    float triggerH = std::get<float>(objConfig.at("triggerHeight"));
-    triggerArea = sf::FloatRect({triggerX, triggerY}, {triggerW, triggerH});
+    triggerArea = sf::FloatRect({desc.triggerX, desc.triggerY}, {desc.triggerWidth, desc.triggerHeight});
 
     // ========== 贴图 & Sprite ==========
-    std::string texturePath = std::get<std::string>(objConfig.at("texture"));
-    texture.emplace();
-    if (texture->loadFromFile(texturePath)) {
-        sprite.emplace(texture.value());
-    }
+    loadSpriteTexture(desc.texture);
 
-    float posX = std::get<float>(objConfig.at("x"));
-    float posY = std::get<float>(objConfig.at("y"));
+    float posX = desc.x;
+    float posY = desc.y;
     trapPos = {posX, posY};
 
-    float width  = std::get<float>(objConfig.at("width"));
-    float height = std::get<float>(objConfig.at("height"));
+    float width  = desc.width;
+    float height = desc.height;
 
-    if (sprite.has_value() && texture.has_value()) {
-        auto texSize = texture->getSize();
+    if (sprite.has_value()) {
+        auto texSize = textureRect.size;
         if (texSize.x > 0 && texSize.y > 0) {
             float scaleX = width  / static_cast<float>(texSize.x);
             float scaleY = height / static_cast<float>(texSize.y);
@@ -765,6 +939,32 @@ void Trap::draw() {
     }
 }
 
+void Trap::saveState(ObjectState& state) const {
+    // 被摧毁的陷阱不再重新创建；flags第0位为激活，第1位为已伤害过玩家
+    state.valid  = 1;
+    state.alive  = destroyed_ ? 0 : 1;
+    state.x      = trapPos.x;
+    state.y      = trapPos.y;
+    state.health = health;
+    state.flags  = static_cast<std::uint8_t>((isActive_ ? 1 : 0) | (hasDamagedPlayer ? 2 : 0));
+}
+
+void Trap::loadState(const ObjectState& state) {
+    if (destroyed_) {
+        return;
+    }
+    health           = state.health;
+    isActive_        = (state.flags & 1) != 0;
+    hasDamagedPlayer = (state.flags & 2) != 0;
+}
+
+void Trap::releasePhysics() {
+    if (!destroyed_ && b2Body_IsValid(bodyId)) {
+        b2DestroyBody(bodyId);
+    }
+    bodyId = b2_nullBodyId;
+}
+
 // 返回陷阱对玩家造成伤害的碰撞箱（激活且没被摧毁）
 sf::FloatRect Trap::getHitBox() const {
     if (!sprite.has_value() || !isActive_ || destroyed_) {
@@ -841,45 +1041,59 @@ ParallaxLayer::~ParallaxLayer() {
     // 析构函数
 }
 
-void ParallaxLayer::initialize(const ResourceLoader::ResourceDict& objConfig) {
+void ParallaxLayer::initialize(const ParallaxDesc& desc) {
     // Debug
     printf(".............Initializing ParallaxLayer...........\n");
 
     // 加载纹理路径
-    std::string texturePath = std::get<std::string>(objConfig.at("texture"));
+    const std::string& texturePath = desc.texture;
     // Debug
     printf("Parallax texture path: %s\n", texturePath.c_str());
-    // 加载纹理
-    sf::Texture tempTexture;
-    if (!tempTexture.loadFromFile(texturePath)) {
+    // 加载纹理（有解码缓存或预先解码的图片时只需上传），纹理设为重复模式（关键：支持纹理平铺）
+    // 有纹理缓存时由缓存管理（不绘制时可以被驱逐，绘制前按需重新加载），否则图层自己持有
+    const sf::Texture* layerTexture = nullptr;
+    if (auto cache = textureCachePtr.lock()) {
+        sharedTexture = sourceRaw   ? cache->insert(texturePath, sourceRaw, true)
+                      : sourceImage ? cache->insert(texturePath, *sourceImage, true)
+                      : cache->acquire(texturePath, true);
+        layerTexture = sharedTexture.get();
+    } else {
+        texture.emplace();
+        bool loaded = sourceRaw   ? sourceRaw->upload(*texture)
+                    : sourceImage ? texture->loadFromImage(*sourceImage)
+                    : AssetVfs::load(*texture, texturePath);
+        if (loaded) {
+            texture->setRepeated(true);
+            layerTexture = &texture.value();
+        } else {
+            texture.reset();
+        }
+    }
+    sourceImage = nullptr;
+    sourceRaw.reset();
+    if (!layerTexture) {
         printf("Failed to load parallax texture: %s\n", texturePath.c_str());
         return;
     }
     printf("Parallax texture loaded: %s\n", texturePath.c_str());
     
-    // 设置纹理为重复模式（关键：支持纹理平铺）
-    tempTexture.setRepeated(true);
-    
     // 获取纹理尺寸
-    textureWidth = static_cast<float>(tempTexture.getSize().x);
-    textureHeight = static_cast<float>(tempTexture.getSize().y);
-    
-    // 保存纹理
-    texture = tempTexture;
+    textureWidth = static_cast<float>(layerTexture->getSize().x);
+    textureHeight = static_cast<float>(layerTexture->getSize().y);
     
     // 创建精灵
-    sprite1 = sf::Sprite(texture.value());
+    sprite1 = sf::Sprite(*layerTexture);
     
     // 获取滚动速度
-    scrollSpeed = std::get<float>(objConfig.at("speed"));
+    scrollSpeed = desc.speed;
     printf("Parallax scroll speed: %.2f\n", scrollSpeed);
     
     // 获取Y位置
-    yPosition = std::get<float>(objConfig.at("y"));
+    yPosition = desc.y;
     printf("Parallax Y position: %.2f\n", yPosition);
     
     // 获取图层索引（用于确定绘制优先级）
-    layerIndex = (std::get<int>(objConfig.at("layer")));
+    layerIndex = desc.layer;
     printf("Parallax layer index: %d\n", layerIndex);
     
     // 设置精灵位置
@@ -985,6 +1199,10 @@ void ParallaxLayer::draw() {
         return;
     }
     
+    // 纹理可能在不绘制期间被缓存驱逐，这里标记使用（需要时重新加载）
+    if (auto cache = textureCachePtr.lock()) {
+        cache->touch(&sprite1->getTexture());
+    }
     // 注册绘制事件（只需绘制一个精灵，纹理重复模式自动处理平铺）
     eventSys->regImmEvent(priority, [window, s1 = sprite1.value()]() {
         window->draw(s1);
@@ -1,7 +1,14 @@
 #include "../include/Scene.hpp"
+#include "LevelReader.hpp"
+#include "LevelBinary.hpp"
+#include "LevelDiff.hpp"
+#include "AssetPack.hpp"
 #include "Player.hpp"
 #include <SFML/Graphics/Rect.hpp>
 #include "AudioManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
 
 static bool rectsIntersect(const sf::FloatRect& a, const sf::FloatRect& b)
 {
@@ -27,6 +34,180 @@ void Scene::init(std::string sceneConfigPath,
             std::weak_ptr<EventSys> eventSys, 
             std::weak_ptr<sf::RenderWindow> window,
             std::weak_ptr<GameInputRead> input) {
+    beginInit(sceneConfigPath, eventSys, window, input);
+    // 同步加载：在当前线程读取，然后一次完成所有阶段
+    levelData = readLevelData(sceneConfigPath, &readProgress, decodeScheduler, profiler, rawImageCache);
+    advanceLoading(0.0f);
+}
+
+void Scene::beginAsyncInit(std::string sceneConfigPath,
+                           std::weak_ptr<EventSys> eventSys,
+                           std::weak_ptr<sf::RenderWindow> window,
+                           std::weak_ptr<GameInputRead> input) {
+    beginInit(sceneConfigPath, eventSys, window, input);
+    // 读文件、解析JSON和解码图片交给工作线程，主线程之后通过pollAsyncInit分片完成其余部分
+    loadFuture = std::async(std::launch::async, &Scene::readLevelData, sceneConfigPath, &readProgress,
+                            decodeScheduler, profiler, rawImageCache);
+    printf("[Scene] Async loading started for %s\n", sceneConfigPath.c_str());
+}
+
+bool Scene::pollAsyncInit(float budgetMs) {
+    return advanceLoading(budgetMs);
+}
+
+float Scene::getLoadProgress() const {
+    // 读取（含解码）占前一半，主线程各阶段占后一半
+    switch (loadStage) {
+        case LoadStage::Idle:     return 0.0f;
+        case LoadStage::Reading:  return 0.5f * readProgress.load();
+        case LoadStage::Setup:    return 0.5f;
+        case LoadStage::Atlas:    return 0.55f;
+        case LoadStage::Textures: return 0.65f;
+        case LoadStage::Objects:  return 0.7f;
+        case LoadStage::Chunks: {
+            float done = streamChunks.empty() ? 1.0f
+                         : static_cast<float>(loadChunkCursor) / static_cast<float>(streamChunks.size());
+            return 0.75f + 0.2f * done;
+        }
+        case LoadStage::Finish:   return 0.95f;
+        case LoadStage::Ready:    return 1.0f;
+    }
+    return 0.0f;
+}
+
+// 并行解码的共享状态：每个下标只由处理它的线程写入
+struct ImageDecodeBatch {
+    const std::vector<std::string>* paths = nullptr;
+    std::vector<sf::Image> images;
+    std::vector<std::shared_ptr<const RawImageCache::Entry>> raw;   // 解码缓存命中
+    std::vector<char> loaded;
+    RawImageCache* cache = nullptr;
+    Profiler* profiler = nullptr;
+    std::atomic<float>* progress = nullptr;
+    std::atomic<int> done{0};
+};
+
+static void decodeImageRange(int begin, int end, std::uint32_t /*worker*/, void* context) {
+    ImageDecodeBatch& batch = *static_cast<ImageDecodeBatch*>(context);
+    const std::vector<std::string>& paths = *batch.paths;
+    for (int i = begin; i < end; ++i) {
+        Profiler::Clock::time_point start = Profiler::Clock::now();
+        // 有缓存时先映射缓存，未命中再解码并写入缓存
+        const char* category = "decode";
+        if (batch.cache && (batch.raw[i] = batch.cache->find(paths[i]))) {
+            batch.loaded[i] = 1;
+            category = "cached";
+        } else if (batch.cache) {
+            batch.loaded[i] = batch.cache->decode(paths[i], batch.images[i]) ? 1 : 0;
+        } else {
+            batch.loaded[i] = AssetVfs::load(batch.images[i], paths[i]) ? 1 : 0;
+        }
+        if (batch.profiler) {
+            batch.profiler->event(category, paths[i], Profiler::elapsedMs(start));
+        }
+        int done = batch.done.fetch_add(1) + 1;
+        batch.progress->store(0.1f + 0.9f * static_cast<float>(done) / static_cast<float>(paths.size()));
+    }
+}
+
+std::unique_ptr<Scene::LevelData> Scene::readLevelData(const std::string& path, std::atomic<float>* progress,
+                                                       std::shared_ptr<TaskScheduler> decoder,
+                                                       std::shared_ptr<Profiler> profiler,
+                                                       std::shared_ptr<RawImageCache> rawCache) {
+    auto level = std::make_unique<LevelData>();
+    progress->store(0.0f);
+    // 加载场景配置：有比JSON新的.lvlb时直接展开它的记录（已在编译时校验）；
+    // 否则按对象字段表解码JSON，所有字段错误在这里一次性打印，出错的对象不会被创建
+    LevelReader reader;
+    if (LevelBinary::readCooked(path, level->desc)) {
+        printf("[Scene] %s loaded from %s.\n", path.c_str(), LevelBinary::cookedPathFor(path).c_str());
+    } else if (!reader.read(path, level->desc)) {
+        printf("[Scene] %s loaded with %zu error(s), invalid objects skipped.\n",
+               path.c_str(), reader.getErrors().size());
+    }
+    const LevelDesc& desc = level->desc;
+    progress->store(0.1f);
+
+    // 收集关卡引用的纹理路径（子弹在运行中动态生成，有地形的场景提前准备它们的贴图）
+    std::vector<std::string> paths;
+    for (const std::string& key : desc.objKeys) {
+        std::size_t objCount = desc.count(key);
+        for (std::size_t i = 0; i < objCount; ++i) {
+            const std::string& texture = *desc.texture(key, i);
+            if (std::find(paths.begin(), paths.end(), texture) != paths.end()) {
+                continue;
+            }
+            paths.push_back(texture);
+            // 视差层需要重复平铺的纹理，不能放进图集
+            if (key != "ParallaxLayer") {
+                level->atlasPaths.push_back(texture);
+            }
+        }
+    }
+    if (std::find(desc.objKeys.begin(), desc.objKeys.end(), "Block") != desc.objKeys.end()) {
+        for (Projectile::ProjectileType type : {Projectile::ICE, Projectile::FIRE}) {
+            std::string texture = Projectile::texturePathFor(type);
+            if (std::find(paths.begin(), paths.end(), texture) == paths.end()) {
+                paths.push_back(texture);
+                level->atlasPaths.push_back(texture);
+            }
+        }
+    }
+
+    // 解码图片（只在内存中，不涉及显卡）：每个文件一个任务分给线程池，显卡上传留给主线程
+    Profiler::Clock::time_point decodeStart = Profiler::Clock::now();
+    ImageDecodeBatch batch;
+    batch.paths    = &paths;
+    batch.images.resize(paths.size());
+    batch.raw.resize(paths.size());
+    batch.loaded.assign(paths.size(), 0);
+    batch.cache    = rawCache.get();
+    batch.profiler = profiler.get();
+    batch.progress = progress;
+    int threads = 1;
+    if (decoder && paths.size() > 1) {
+        // submit/wait不能在两个线程同时调用（菜单同步加载与关卡后台加载共用同一个线程池）
+        static std::mutex submitMutex;
+        std::lock_guard<std::mutex> lock(submitMutex);
+        threads = decoder->getWorkerCount();
+        if (TaskScheduler::Task* task = decoder->submit(&decodeImageRange, static_cast<int>(paths.size()), 1, &batch)) {
+            decoder->wait(task);
+        }
+    } else {
+        decodeImageRange(0, static_cast<int>(paths.size()), 0, &batch);
+    }
+    std::size_t cached = static_cast<std::size_t>(std::count_if(batch.raw.begin(), batch.raw.end(),
+        [](const std::shared_ptr<const RawImageCache::Entry>& raw) { return raw != nullptr; }));
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (batch.loaded[i] && batch.raw[i]) {
+            // 图集打包需要sf::Image（都是小图，复制像素的代价很小）；视差层保留映射，上传时直接使用
+            bool atlasCandidate = std::find(level->atlasPaths.begin(), level->atlasPaths.end(), paths[i]) !=
+                                  level->atlasPaths.end();
+            if (atlasCandidate) {
+                level->images.emplace(paths[i], batch.raw[i]->toImage());
+            } else {
+                level->rawImages.emplace(paths[i], std::move(batch.raw[i]));
+            }
+        } else if (batch.loaded[i]) {
+            level->images.emplace(paths[i], std::move(batch.images[i]));
+        } else {
+            printf("[Scene] Failed to decode image: %s\n", paths[i].c_str());
+        }
+    }
+    double decodeMs = Profiler::elapsedMs(decodeStart);
+    if (profiler) {
+        profiler->record("Scene.decodeImages", decodeMs);
+    }
+    printf("[Scene] Decoded %zu image(s) (%zu from cache) in %.1f ms on %d thread(s)\n",
+           paths.size(), cached, decodeMs, threads);
+    progress->store(1.0f);
+    return level;
+}
+
+void Scene::beginInit(const std::string& sceneConfigPath,
+                      const std::weak_ptr<EventSys>& eventSys,
+                      const std::weak_ptr<sf::RenderWindow>& window,
+                      const std::weak_ptr<GameInputRead>& input) {
     // Debug
     printf("----------------------Initializing Scene------------------------\n");
     levelCompleted_ = false;
@@ -60,23 +241,233 @@ void Scene::init(std::string sceneConfigPath,
         audioManagerPtr->playMusic("level1");
     }
 
-    // 加载场景配置
-    ResourceLoader loader(sceneConfigPath);
-    // Debug
-    printf("Scene config loaded from %s\n", sceneConfigPath.c_str());
+    // 创建合批渲染器，场景内的精灵按（图层, 纹理）合并绘制
+    spriteBatch = std::make_shared<SpriteBatch>();
+    spriteBatch->setPtrs(eventSys, window);
+    // 静态几何烘焙区块
+    staticChunks = std::make_shared<StaticChunkCache>();
+    staticChunks->setPtrs(eventSys, window);
+    staticChunks->setChunkSize(renderSettings.bakeChunkSize);
+    bakeFailed = false;
+    // 图集之外的纹理通过缓存共享（main设置了共享的缓存时与其它场景共用，由它统一管理常驻）
+    if (!textureCache) {
+        textureCache = std::make_shared<TextureCache>();
+    }
+    spriteBatch->setTextureCache(textureCache);
+    staticChunks->setTextureCache(textureCache);
+    // 敌人、方块数据集中存放，便于批量更新与判定
+    entities = std::make_shared<EntityStore>();
+    blockStore = std::make_shared<BlockStore>();
+
+    // 各阶段的进度从头开始
+    levelData.reset();
+    readProgress.store(0.0f);
+    loadKeyCursor = 0;
+    loadObjectCursor = 0;
+    loadTextureCursor = 0;
+    loadChunkCursor = 0;
+    preloadedTextures.clear();
+    loadStage = LoadStage::Reading;
+}
 
+bool Scene::advanceLoading(float budgetMs) {
+    sf::Clock sliceClock;
+    // 每完成一个单位（一个对象、一张纹理、一个区块）检查一次时间片
+    auto outOfTime = [&]() {
+        return budgetMs > 0.0f && sliceClock.getElapsedTime().asMicroseconds() >= static_cast<std::int64_t>(budgetMs * 1000.0f);
+    };
+
+    while (loadStage != LoadStage::Ready && loadStage != LoadStage::Idle) {
+        switch (loadStage) {
+            case LoadStage::Reading: {
+                // 等待工作线程，不阻塞主线程
+                if (!levelData) {
+                    if (!loadFuture.valid() ||
+                        loadFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                        return false;
+                    }
+                    levelData = loadFuture.get();
+                }
+                loadStage = LoadStage::Setup;
+                break;
+            }
+            case LoadStage::Setup: {
+                // Debug
+                printf("Scene config loaded from %s\n", configPath.c_str());
+                // 关卡描述在场景生命周期内保留，流式对象和reload按下标引用
+                levelDesc = std::move(levelData->desc);
+                setupWorld(levelDesc);
+                // Debug
+                for (const std::string& key : levelDesc.objKeys) {
+                    printf("Object Key Found: %s\n", key.c_str());
+                }
+                loadStage = LoadStage::Atlas;
+                break;
+            }
+            case LoadStage::Atlas: {
+                // 先把关卡用到的小纹理打包成图集，之后创建的对象直接引用图集子区域
+                Profiler::Scope scope(profiler.get(), "Scene.buildAtlas");
+                buildTextureAtlas(*levelData);
+                loadStage = LoadStage::Textures;
+                break;
+            }
+            case LoadStage::Textures: {
+                // 放不进图集的纹理逐张上传到纹理缓存，对象创建时直接共享
+                const std::vector<std::string>& paths = levelData->atlasPaths;
+                while (loadTextureCursor < paths.size()) {
+                    const std::string& path = paths[loadTextureCursor++];
+                    if (atlas && atlas->find(path)) {
+                        continue;
+                    }
+                    // 解码缓存命中的直接从映射内存上传（映射作为CPU副本保留，驱逐后重新加载不必读文件）
+                    std::shared_ptr<const sf::Texture> texture;
+                    Profiler::Clock::time_point start = Profiler::Clock::now();
+                    if (auto raw = findRawImage(path)) {
+                        texture = textureCache->insert(path, std::move(raw));
+                    } else if (const sf::Image* image = findDecodedImage(path)) {
+                        texture = textureCache->insert(path, *image);
+                    } else {
+                        continue;
+                    }
+                    if (texture) {
+                        preloadedTextures.push_back(std::move(texture));
+                    }
+                    if (profiler) {
+                        profiler->event("upload", path, Profiler::elapsedMs(start));
+                    }
+                    if (outOfTime()) {
+                        return false;
+                    }
+                }
+                // 流式对象按区块管理，其它对象（视差层、图形、音频）在下一阶段逐个创建
+                buildStreamChunks(levelDesc);
+                loadStage = LoadStage::Objects;
+                break;
+            }
+            case LoadStage::Objects: {
+                const std::vector<std::string>& objKeys = levelDesc.objKeys;
+                while (loadKeyCursor < objKeys.size()) {
+                    const std::string& key = objKeys[loadKeyCursor];
+                    std::size_t objCount = isStreamedType(key) ? 0 : levelDesc.count(key);
+                    if (loadObjectCursor == 0 && objCount > 0) {
+                        // Debug
+                        printf("Adding objects of type: %s, count: %zu\n", key.c_str(), objCount);
+                    }
+                    if (loadObjectCursor >= objCount) {
+                        ++loadKeyCursor;
+                        loadObjectCursor = 0;
+                        continue;
+                    }
+                    // 遍历每个对象并添加到场景
+                    std::size_t slot = addObject(key, loadObjectCursor++);
+                    if (key == "ParallaxLayer") {
+                        parallaxSlots.push_back(slot);
+                    }
+                    if (outOfTime()) {
+                        return false;
+                    }
+                }
+                // 初始加载的区块以此时的相机视野为准
+                loadFocus = getCullingRect();
+                loadStage = LoadStage::Chunks;
+                break;
+            }
+            case LoadStage::Chunks: {
+                // 视野附近的区块逐个加载（创建其中对象的Box2D实体）
+                while (loadChunkCursor < streamChunks.size()) {
+                    std::size_t index = loadChunkCursor++;
+                    if (!streamChunks[index].loaded &&
+                        streamChunkDistance(index, loadFocus) <= streamSettings.loadDistance) {
+                        loadStreamChunk(index);
+                        if (outOfTime()) {
+                            return false;
+                        }
+                    }
+                }
+                loadStage = LoadStage::Finish;
+                break;
+            }
+            case LoadStage::Finish: {
+                finishInit();
+                loadStage = LoadStage::Ready;
+                break;
+            }
+            default:
+                break;
+        }
+        if (loadStage != LoadStage::Ready && outOfTime()) {
+            return false;
+        }
+    }
+    return loadStage == LoadStage::Ready;
+}
+
+bool Scene::reloadLevelFile() {
+    if (!isLoaded() || !world) {
+        return false;
+    }
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+    LevelDesc next;
+    LevelReader reader;
+    // 读取磁盘上刚编辑过的文件（资源包中是打包时的旧内容）
+    if (!reader.read(configPath, next, true)) {
+        printf("[Scene] %s has %zu error(s), hot reload skipped.\n", configPath.c_str(), reader.getErrors().size());
+        return false;
+    }
+
+    // 只应用改变的关卡参数
+    if (next.gravityX != levelDesc.gravityX || next.gravityY != levelDesc.gravityY) {
+        b2World_SetGravity(*world, b2Vec2{next.gravityX, next.gravityY});
+        levelDesc.gravityX = next.gravityX;
+        levelDesc.gravityY = next.gravityY;
+        printf("[Scene] Gravity changed to (%.2f, %.2f)\n", next.gravityX, next.gravityY);
+    }
+    if (next.hasLevelWidth && (!levelDesc.hasLevelWidth || next.levelWidth != levelDesc.levelWidth)) {
+        levelDesc.hasLevelWidth = true;
+        levelDesc.levelWidth = next.levelWidth;
+        levelWidth = next.levelWidth;
+        printf("[Scene] Level width changed to %.1f\n", levelWidth);
+    }
+    levelDesc.name = std::move(next.name);
+    levelDesc.background = std::move(next.background);
+    levelDesc.music = std::move(next.music);
+    // 对象逐个配对，只重建改变的部分
+    patchLevelObjects(next);
+
+    if (profiler) {
+        profiler->event("hotReload", configPath, Profiler::elapsedMs(start));
+    }
+    printf("[Scene] %s hot reloaded.\n", configPath.c_str());
+    return true;
+}
+
+void Scene::setupWorld(const LevelDesc& level) {
     // 初始化Box2D物理世界
     worldDef = b2DefaultWorldDef();
-    float gravityX = std::get<float>(loader.getResource("gravityX"));
-    float gravityY = std::get<float>(loader.getResource("gravityY"));
+    float gravityX = level.gravityX;
+    float gravityY = level.gravityY;
     worldDef.gravity = {gravityX, gravityY};
+    // 有任务调度器时由它的工作线程并行求解
+    if (taskScheduler && taskScheduler->getWorkerCount() > 1) {
+        worldDef.workerCount     = taskScheduler->getWorkerCount();
+        worldDef.enqueueTask     = &TaskScheduler::enqueueBox2DTask;
+        worldDef.finishTask      = &TaskScheduler::finishBox2DTask;
+        worldDef.userTaskContext = taskScheduler.get();
+    }
     world = std::make_shared<b2WorldId>(b2CreateWorld(&worldDef));
+    // 静态方块的碰撞合并到少量实体中
+    staticMerger.reset();
+    physicsStats = PhysicsStats{};
+    if (mergeStaticBlocks) {
+        staticMerger = std::make_shared<StaticBodyMerger>();
+        staticMerger->setWorld(*world);
+    }
     // Debug
-    printf("Box2D World created with gravity (%.2f, %.2f)\n", gravityX, gravityY);
+    printf("Box2D World created with gravity (%.2f, %.2f), %d workers\n", gravityX, gravityY, worldDef.workerCount);
     printf("----------------------Adding Objects--------------------------\n");
     
     // 加载死亡提示用的字体
-    if (deathFont.openFromFile("assets/fonts/ALGER.TTF"))
+    if (AssetVfs::open(deathFont, "assets/fonts/ALGER.TTF"))
     {
         deathFontLoaded = true;
         printf("[Scene] Death UI font loaded.\n");
@@ -87,33 +478,28 @@ void Scene::init(std::string sceneConfigPath,
         printf("[Scene] WARNING: failed to load death UI font.\n");
     }
 
-    // 设定容器键
-    std::vector<std::string> objKeys = loader.getObjKeys();
-    // Debug
-    for (const std::string& key : objKeys) {
-        printf("Object Key Found: %s\n", key.c_str());
-    }
-    for (const std::string& key : objKeys) {
-        // 遍历每一种对象类型
-        loader.addObjKey(key);
-        int objCount = loader.getObjCount(key);
-        // Debug
-        printf("Adding objects of type: %s, count: %d\n", key.c_str(), objCount);
-        for (int i = 0; i < objCount; ++i) {
-            // 遍历每个对象并添加到场景
-            addObject(key, loader.getAllObjResources(i, key));
-        }
-    }
+    // 剔除网格按配置的格子尺寸重建
+    cullGrid.setCellSize(renderSettings.cullCellSize);
+    clearCullingIndex();
+}
+
+void Scene::finishInit() {
+    bakeStaticGeometry();
+    // 记录初始状态，之后reload直接从快照恢复
+    captureSnapshot();
+    // 解码的图片和预先上传的纹理已经交给对象和快照，不再需要
+    levelData.reset();
+    preloadedTextures.clear();
     // Debug
     printf("Scene initialized with %zu objects.\n", sceneAssets.size());
 
     // 3. 添加以下代码：根据场景类型触发对应音频
     if (audioManagerPtr) {
         // 判断场景类型（使用配置文件路径或名称）
-        if (sceneConfigPath.find("menu") != std::string::npos) {
+        if (configPath.find("menu") != std::string::npos) {
             printf("[Scene] Menu scene detected, playing menu music\n");
             audioManagerPtr->onSceneEvent("scene_menu");
-        } else if (sceneConfigPath.find("level1") != std::string::npos) {
+        } else if (configPath.find("level1") != std::string::npos) {
             printf("[Scene] Level1 scene detected, playing level music\n");
             audioManagerPtr->onSceneEvent("scene_level1");
         }
@@ -135,6 +521,12 @@ void Scene::init(std::string sceneConfigPath,
                     auto proj = std::make_unique<Projectile>();
                     printf("[Scene]   Projectile created\n");
                     
+                    // 使用公有方法设置指针
+                    proj->setWindowPtr(windowPtr);
+                    proj->setEventSysPtr(eventSysPtr);
+                    attachRenderPtrs(*proj);
+                    printf("[Scene]   Pointers set\n");
+
                     proj->initializeDynamic(
                         Projectile::fromString(req.type),
                         req.position,
@@ -142,11 +534,6 @@ void Scene::init(std::string sceneConfigPath,
                     );
                     printf("[Scene]   Projectile initialized\n");
                     
-                    // 使用公有方法设置指针
-                    proj->setWindowPtr(windowPtr);
-                    proj->setEventSysPtr(eventSysPtr);
-                    printf("[Scene]   Pointers set\n");
-                    
                     // 你可以根据需要添加 setWorldPtr 等
                     projectiles.push_back(std::move(proj));
                     printf("[Scene]   Projectile added to list. Total: %zu\n", projectiles.size());
@@ -160,33 +547,49 @@ void Scene::init(std::string sceneConfigPath,
 }
 
 void Scene::reload() {
+    sf::Clock reloadClock;
+    if (!snapshot.valid) {
+        printf("[Scene] No snapshot captured, reload skipped.\n");
+        return;
+    }
     // 清空子弹列表
-    projectiles.clear();   
-    // 清空对象列表
-    sceneAssets.clear();
+    projectiles.clear();
     levelCompleted_ = false;
-    // 销毁现有的Box2D物理世界
-    b2DestroyWorld(*world);
-    // 重新加载场景配置
-    ResourceLoader loader(configPath);
-    // 重载Box2D物理世界
-    worldDef = b2DefaultWorldDef();
-    float gravityX = std::get<float>(loader.getResource("gravityX"));
-    float gravityY = std::get<float>(loader.getResource("gravityY"));
-    worldDef.gravity = {gravityX, gravityY};
-    world = std::make_shared<b2WorldId>(b2CreateWorld(&worldDef));
+    playerWasDead = false;
 
-    // 设定容器键
-    std::vector<std::string> objKeys = loader.getObjKeys();
-    for (const std::string& key : objKeys) {
-        // 遍历每一种对象类型
-        loader.addObjKey(key);
-        int objCount = loader.getObjCount(key);
-        for (int i = 0; i < objCount; ++i) {
-            // 遍历每个对象并添加到场景
-            addObject(key, loader.getAllObjResources(i, key));
+    // 移除所有流式对象（只销毁它们的Box2D实体，物理世界和常驻对象保留），区块恢复为快照中的分配
+    streamChunks.resize(snapshot.chunkObjects.size());
+    for (std::size_t i = 0; i < streamChunks.size(); ++i) {
+        StreamChunk& chunk = streamChunks[i];
+        for (const LiveObject& entry : chunk.live) {
+            removeObject(entry.slot);
         }
+        chunk.live.clear();
+        chunk.loaded = false;
+        chunk.objects = snapshot.chunkObjects[i];
+    }
+    std::fill(objectStates.begin(), objectStates.end(), ObjectState{});
+    streamStats.loadedChunks = 0;
+    streamStats.residentObjects = 0;
+    // 旧的回滚帧属于上一次尝试
+    rollbackRing.clear();
+    rollbackStats.frames = 0;
+    rewinding_ = false;
+    resetFixedStep();
+
+    // 玩家回到出生点，先加载出生点附近的区块
+    sf::FloatRect focus = getCullingRect();
+    if (auto player = std::dynamic_pointer_cast<Player>(playerPtr)) {
+        player->respawn();
+        focus.position = player->getPosition() - focus.size * 0.5f;
+    }
+    if (!streamChunks.empty()) {
+        updateStreaming(focus);
     }
+    // 烘焙区块在下次绘制前按需重建
+
+    lastReloadMs = static_cast<float>(reloadClock.getElapsedTime().asMicroseconds()) / 1000.0f;
+    printf("[Scene] Reloaded from snapshot in %.3f ms.\n", lastReloadMs);
 
     // 如果之前有音频管理器，重新设置它
     if (savedAudioManager) {
@@ -203,17 +606,76 @@ void Scene::reload() {
 }
 
 void Scene::update(const float deltaTime, const int subStepCount) {
+    // 回放中：恢复上一帧的快照，本帧不步进模拟
+    if (rewinding_ && rollbackEnabled) {
+        rewindFrame();
+        return;
+    }
+
+    // 0) 根据相机视野加载/卸载关卡区块（在注册本帧事件之前完成，事件执行期间对象列表不变）
+    if (!streamChunks.empty()) {
+        updateStreaming(getCullingRect());
+    }
+    // 方块增删后重建合并的静态碰撞（步进之前完成）
+    if (staticMerger) {
+        staticMerger->rebuildDirty();
+        physicsStats.staticTiles  = staticMerger->getStats().tiles;
+        physicsStats.staticShapes = staticMerger->getStats().shapes;
+    }
+
     // 1) 更新 Box2D 物理世界
+    //    固定频率时按累积的帧时间步进0次或多次，剩余时间作为绘制插值系数
+    float stepDt = deltaTime;
+    int stepCount = 1;
+    physicsStats.alpha = 1.0f;
+    if (timestepSettings.physicsRate > 0.0f) {
+        stepDt = 1.0f / timestepSettings.physicsRate;
+        physicsAccumulator += deltaTime;
+        stepCount = std::min(static_cast<int>(physicsAccumulator / stepDt), std::max(1, timestepSettings.maxSteps));
+        physicsAccumulator -= stepCount * stepDt;
+        if (physicsAccumulator >= stepDt) {
+            // 追不上：丢弃多余的时间，画面变慢但不会越积越多
+            physicsAccumulator = std::fmod(physicsAccumulator, stepDt);
+        }
+        if (timestepSettings.interpolate) {
+            physicsStats.alpha = physicsAccumulator / stepDt;
+        }
+    }
+    physicsStats.steps = stepCount;
+    // 敌人逻辑（巡逻、冷却、动画）在每次步进之后以步长推进，与物理同频，不受帧率影响；
+    // 远离视野的敌人降频或冻结（会禁用/启用Box2D实体，必须在物理步进之前完成）
+    bool updateEnemies = entities && entities->size() > 0;
+    if (updateEnemies) {
+        lodStats = EnemySystem::updateLod(*entities, getCullingRect(), lodSettings);
+    }
     if (world) {
-        auto stepFunc = [this, deltaTime, subStepCount]() {
-            b2World_Step(*world, deltaTime, subStepCount);
+        auto stepFunc = [this, stepDt, stepCount, subStepCount, updateEnemies]() {
+            // dirty标记累积本帧所有步进中的移动
+            if (entities) {
+                entities->clearDirty();
+            }
+            physicsStats.stepMs = 0.0f;
+            for (int step = 0; step < stepCount; ++step) {
+                savePreviousTransforms();
+                b2World_Step(*world, stepDt, subStepCount);
+                physicsStats.stepMs += b2World_GetProfile(*world).step;
+                syncTransforms();
+                if (updateEnemies) {
+                    EnemySystem::update(*entities, stepDt, 0, 0, lodSettings.nearInterval);
+                }
+            }
         };
         regImmEvent(EventSys::ImmEventPriority::BOX2D, stepFunc);
     }
 
-    // 2) 更新场景内所有静态/普通游戏对象（Block、Enemy 等）
+    // 2) 更新场景内所有普通游戏对象（Trap、视差层等）
     // 特殊处理：ParallaxLayer根据场景类型使用不同更新方式
+    //          敌人的数据在实体存储中，已在上面的步进中由EnemySystem批量更新；方块没有逐帧逻辑，
+    //          数据在方块存储中由BlockSystem判定。二者（"entity"特征）都不逐个注册
     for (auto& obj : sceneAssets) {
+        // 被流式卸载的对象留下空位
+        if (!obj) continue;
+        if (obj->hasFeature("entity")) continue;
         // 尝试将对象转换为ParallaxLayer
         ParallaxLayer* parallaxLayer = dynamic_cast<ParallaxLayer*>(obj.get());
         if (parallaxLayer) {
@@ -241,6 +703,9 @@ void Scene::update(const float deltaTime, const int subStepCount) {
     }
 
     // 3) 更新玩家对象
+    //    玩家仍按帧时间更新：跳跃、射击读取只在按下那一帧有效的按键状态，放进固定步进会在
+    //    不步进的帧丢失、在一帧多步时重复触发；它只设置速度，移动本身由上面的固定步进积分，
+    //    计时器与动画都按deltaTime推进
     if (playerPtr) {
         auto playerUpdateFunc = [this, deltaTime]() {
             playerPtr->update(deltaTime);
@@ -472,42 +937,10 @@ void Scene::update(const float deltaTime, const int subStepCount) {
             }
 
             // ---------- 3) 玩家 vs Block：熔岩 & 冰面 ----------
-            bool onLava = false;
-            bool onIce  = false;
-
-            for (auto& obj : sceneAssets) {
-                if (!obj) continue;
-
-                auto block = dynamic_cast<Block*>(obj.get());
-                if (!block) continue;
-
-                sf::FloatRect bBounds = block->getHitBox();
-
-                // AABB 相交
-                float pLeft   = playerBounds.position.x;
-                float pTop    = playerBounds.position.y;
-                float pRight  = pLeft + playerBounds.size.x;
-                float pBottom = pTop  + playerBounds.size.y;
-
-                float bLeft   = bBounds.position.x;
-                float bTop    = bBounds.position.y;
-                float bRight  = bLeft + bBounds.size.x;
-                float bBottom = bTop  + bBounds.size.y;
-
-                bool intersect =
-                    (pLeft < bRight)  &&
-                    (pRight > bLeft)  &&
-                    (pTop < bBottom)  &&
-                    (pBottom > bTop);
-
-                if (!intersect) continue;
-
-                if (block->isLava()) {
-                    onLava = true;
-                } else if (block->isIce()) {
-                    onIce = true;
-                }
-            }
+            //    方块数据在方块存储中，顺序扫描包围盒数组（与sprite全局包围盒做AABB相交）
+            std::uint32_t touched = blockStore ? BlockSystem::touchedTypes(*blockStore, playerBounds) : 0;
+            bool onLava = (touched & (1u << Block::LAVA)) != 0;
+            bool onIce  = (touched & (1u << Block::ICE)) != 0;
 
             // --- LAVA：持续掉血（环境伤害，不吃无敌时间） ---
             if (onLava) {
@@ -532,12 +965,26 @@ void Scene::update(const float deltaTime, const int subStepCount) {
     projectiles.remove_if([](const std::unique_ptr<Projectile>& p) {
         return !p || !p->isActive();
     });
+
+    // 7) 本帧对象更新完成后记录回滚快照
+    if (rollbackEnabled) {
+        regImmEvent(EventSys::ImmEventPriority::POST_UPDATE, [this]() {
+            recordRollbackFrame();
+        });
+    }
 }
 
 
     
 
 void Scene::render() {
+    // 绘制在本帧的步进与对象更新之后提交：sprite已是最新位置（含插值），dirty标记也是本帧的
+    regImmEvent(EventSys::ImmEventPriority::POST_UPDATE, [this]() {
+        submitDraws();
+    });
+}
+
+void Scene::submitDraws() {
     printf("[Scene::render] called\n");
     if (!playerPtr) {
     printf("[Scene::render] playerPtr is NULL!\n");
@@ -549,9 +996,34 @@ if (playerPtr) {
     }
 }
 
-    // 1. 先画场景里的物体
-    for (auto& obj : sceneAssets) {
-        if (obj) obj->draw();
+    // 0. 固定频率步进时，动态实体的sprite放到上一步与当前步之间
+    if (timestepSettings.physicsRate > 0.0f && timestepSettings.interpolate) {
+        interpolateTransforms(physicsStats.alpha);
+    }
+
+    // 1. 先画场景里的物体：不可剔除的对象全部绘制，其余只绘制与相机视野相交的对象
+    sf::FloatRect viewRect = getCullingRect();
+    for (std::uint32_t id : dynamicCullIds) {
+        // 会移动的对象（敌人）刷新网格中的包围盒
+        if (sceneAssets[id]) {
+            cullGrid.update(id, sceneAssets[id]->getRenderBounds());
+        }
+    }
+    visibleIds.clear();
+    cullGrid.query(viewRect, visibleIds);
+    cullStats.visible = visibleIds.size();
+    cullStats.culled  = cullGrid.size() - visibleIds.size();
+
+    for (std::uint32_t id : alwaysDrawIds) {
+        if (sceneAssets[id]) sceneAssets[id]->draw();
+    }
+    // 静态几何只绘制与视野相交的烘焙区块（先于同图层的其它对象注册，保证画在下面）
+    if (staticChunks) {
+        staticChunks->draw(viewRect);
+        cullStats.chunks = staticChunks->getDrawnChunkCount();
+    }
+    for (std::uint32_t id : visibleIds) {
+        if (sceneAssets[id]) sceneAssets[id]->draw();
     }
 
     // 2. 画玩家
@@ -559,9 +1031,15 @@ if (playerPtr) {
         playerPtr->draw();
     }
 
-    // 3. 画子弹
+    // 3. 画子弹（数量很少，直接逐个判断是否在视野内）
     for (auto& proj : projectiles) {
-        if (proj) proj->draw();
+        if (!proj) continue;
+        if (rectsIntersect(proj->getRenderBounds(), viewRect)) {
+            proj->draw();
+            ++cullStats.visible;
+        } else {
+            ++cullStats.culled;
+        }
     }
 
         // 4. 如果玩家通关或死亡，叠加结束 UI（YOU WIN / YOU DIED）
@@ -660,6 +1138,745 @@ if (playerPtr) {
 }
 
 
+void Scene::buildTextureAtlas(const LevelData& level) {
+    // 图集只构建一次，reload时直接复用，避免重复解码图片
+    if (atlas) {
+        return;
+    }
+    atlas = std::make_shared<TextureAtlas>(renderSettings.atlasPageSize, renderSettings.atlasPadding);
+    // 图片已经在读取阶段解码好，这里只做打包和上传
+    for (const std::string& path : level.atlasPaths) {
+        auto image = level.images.find(path);
+        if (image != level.images.end()) {
+            atlas->addImage(path, image->second);
+        }
+    }
+    atlas->build();
+    printf("[Scene] Texture atlas built with %zu page(s).\n", atlas->getPageCount());
+}
+
+void Scene::indexObjectForCulling(std::size_t index) {
+    const auto& obj = sceneAssets[index];
+    std::uint32_t id = static_cast<std::uint32_t>(index);
+    if (!obj || !obj->hasFeature("cullable")) {
+        // 视差层、音频管理器等不参与剔除
+        alwaysDrawIds.push_back(id);
+        return;
+    }
+    // 静态方块和背景图形烘焙进区块，由区块负责绘制和剔除
+    if (obj->hasFeature("bakeable") && obj->getSprite() && staticChunks &&
+        renderSettings.bakeChunkSize > 0 && !bakeFailed) {
+        staticChunks->add(id, obj->getDrawLayer(), obj->getSprite());
+        obj->setFeature("baked", true);
+        return;
+    }
+    cullGrid.insert(id, obj->getRenderBounds());
+    if (!obj->hasFeature("static")) {
+        dynamicCullIds.push_back(id);
+    }
+}
+
+void Scene::clearCullingIndex() {
+    cullGrid.clear();
+    dynamicCullIds.clear();
+    alwaysDrawIds.clear();
+    visibleIds.clear();
+    cullStats = CullStats{};
+}
+
+void Scene::bakeStaticGeometry() {
+    if (!staticChunks || bakeFailed || staticChunks->bake()) {
+        return;
+    }
+    // RenderTexture不可用：之后不再烘焙，已登记的对象退回逐个绘制
+    bakeFailed = true;
+    for (std::size_t i = 0; i < sceneAssets.size(); ++i) {
+        const auto& obj = sceneAssets[i];
+        if (obj && obj->hasFeature("baked")) {
+            obj->setFeature("baked", false);
+            cullGrid.insert(static_cast<std::uint32_t>(i), obj->getRenderBounds());
+        }
+    }
+    staticChunks->clear();
+}
+
+void Scene::attachRenderPtrs(BaseObj& obj) {
+    obj.setAtlasPtr(atlas);
+    obj.setBatchPtr(spriteBatch);
+    obj.setTextureCachePtr(textureCache);
+}
+
+std::size_t Scene::nextObjectSlot() const {
+    return freeSlots.empty() ? sceneAssets.size() : freeSlots.back();
+}
+
+std::size_t Scene::storeObject(std::shared_ptr<BaseObj> obj) {
+    // 优先复用被卸载对象留下的空位，sceneAssets的长度只取决于同时驻留的对象数
+    if (!freeSlots.empty()) {
+        std::size_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        sceneAssets[slot] = std::move(obj);
+        return slot;
+    }
+    sceneAssets.push_back(std::move(obj));
+    return sceneAssets.size() - 1;
+}
+
+void Scene::removeObject(std::size_t slot) {
+    if (slot >= sceneAssets.size() || !sceneAssets[slot]) {
+        return;
+    }
+    sceneAssets[slot]->releasePhysics();
+    std::uint32_t id = static_cast<std::uint32_t>(slot);
+    if (staticMerger) {
+        staticMerger->removeTile(id);
+    }
+    cullGrid.remove(id);
+    dynamicCullIds.erase(std::remove(dynamicCullIds.begin(), dynamicCullIds.end(), id), dynamicCullIds.end());
+    alwaysDrawIds.erase(std::remove(alwaysDrawIds.begin(), alwaysDrawIds.end(), id), alwaysDrawIds.end());
+    if (staticChunks) {
+        staticChunks->remove(id);
+    }
+    sceneAssets[slot].reset();
+    freeSlots.push_back(slot);
+}
+
+bool Scene::isStreamedType(const std::string& type) {
+    return type == "Block" || type == "Enemy" || type == "Trap";
+}
+
+// 流式对象（方块、敌人、陷阱）在x方向上的范围
+static void streamExtent(const LevelDesc& level, const std::string& type, std::size_t index,
+                         float& x, float& width) {
+    if (type == "Block") {
+        x = level.blocks[index].x;
+        width = level.blocks[index].width;
+    } else if (type == "Enemy") {
+        x = level.enemies[index].x;
+        width = level.enemies[index].width;
+    } else {
+        x = level.traps[index].x;
+        width = level.traps[index].width;
+    }
+}
+
+void Scene::buildStreamChunks(const LevelDesc& level) {
+    streamChunks.clear();
+    streamObjects.clear();
+    objectStates.clear();
+    streamStats = StreamStats{};
+
+    float rightMost = 0.0f;
+    std::vector<float> homeX;
+    for (const std::string& key : level.objKeys) {
+        if (!isStreamedType(key)) {
+            continue;
+        }
+        std::size_t objCount = level.count(key);
+        for (std::size_t i = 0; i < objCount; ++i) {
+            float x = 0.0f, width = 0.0f;
+            streamExtent(level, key, i, x, width);
+            rightMost = std::max(rightMost, x + width);
+            homeX.push_back(x);
+            streamObjects.push_back(StreamObject{key, static_cast<std::uint32_t>(i)});
+        }
+    }
+    objectStates.assign(streamObjects.size(), ObjectState{});
+
+    // 关卡宽度优先取关卡文件的levelWidth，没有时取对象的最右端
+    levelWidth = level.hasLevelWidth ? level.levelWidth : rightMost;
+    if (streamObjects.empty()) {
+        return;
+    }
+
+    float chunkWidth = std::max(1.0f, streamSettings.chunkWidth);
+    std::size_t chunkCount = static_cast<std::size_t>(std::ceil(std::max(levelWidth, rightMost) / chunkWidth));
+    streamChunks.resize(std::max<std::size_t>(chunkCount, 1));
+    for (std::size_t uid = 0; uid < streamObjects.size(); ++uid) {
+        StreamObject& obj = streamObjects[uid];
+        obj.homeChunk = streamChunkIndexFor(homeX[uid]);
+        streamChunks[obj.homeChunk].objects.push_back(static_cast<std::uint32_t>(uid));
+    }
+    streamStats.totalChunks = streamChunks.size();
+    printf("[Scene] Level width %.1f split into %zu stream chunk(s) of %.1f.\n",
+           levelWidth, streamChunks.size(), chunkWidth);
+}
+
+std::size_t Scene::streamChunkIndexFor(float x) const {
+    if (streamChunks.empty()) {
+        return 0;
+    }
+    float chunkWidth = std::max(1.0f, streamSettings.chunkWidth);
+    float index = std::floor(x / chunkWidth);
+    if (index < 0.0f) {
+        return 0;
+    }
+    return std::min(static_cast<std::size_t>(index), streamChunks.size() - 1);
+}
+
+void Scene::patchLevelObjects(LevelDesc& next) {
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+    // 1) 每种类型分别配对
+    const std::string streamedTypes[] = { "Block", "Enemy", "Trap" };
+    LevelDiff diffs[] = {
+        diffLevelObjects(levelDesc.blocks,  next.blocks),
+        diffLevelObjects(levelDesc.enemies, next.enemies),
+        diffLevelObjects(levelDesc.traps,   next.traps),
+    };
+    LevelDiff parallaxDiff = diffLevelObjects(levelDesc.parallaxLayers, next.parallaxLayers);
+    std::size_t added = parallaxDiff.added, removed = parallaxDiff.removed, modified = parallaxDiff.modified;
+    for (const LevelDiff& diff : diffs) {
+        added += diff.added;
+        removed += diff.removed;
+        modified += diff.modified;
+    }
+    if (!diffLevelObjects(levelDesc.graphics, next.graphics).empty()) {
+        printf("[Scene] GraphicObj changes take effect after a restart.\n");
+    }
+    if (added == 0 && removed == 0 && modified == 0) {
+        return;
+    }
+    auto typeIndex = [&streamedTypes](const std::string& type) {
+        return static_cast<std::size_t>(std::find(std::begin(streamedTypes), std::end(streamedTypes), type) -
+                                        std::begin(streamedTypes));
+    };
+
+    // 2) 旧uid按（类型, 旧下标）查找
+    std::vector<std::uint32_t> oldUids[3];
+    oldUids[0].assign(levelDesc.blocks.size(), 0);
+    oldUids[1].assign(levelDesc.enemies.size(), 0);
+    oldUids[2].assign(levelDesc.traps.size(), 0);
+    for (std::uint32_t uid = 0; uid < streamObjects.size(); ++uid) {
+        const StreamObject& obj = streamObjects[uid];
+        oldUids[typeIndex(obj.type)][obj.index] = uid;
+    }
+
+    // 3) 按新数组重新编号：未改变的对象沿用旧uid的运行时状态（被破坏的仍是被破坏的），
+    //    新增和改变的对象从配置状态开始，稍后创建
+    std::vector<StreamObject> nextObjects;
+    std::vector<ObjectState> nextStates;
+    std::vector<std::uint32_t> oldToNew(streamObjects.size(), static_cast<std::uint32_t>(npos));
+    std::vector<std::uint32_t> pending;
+    for (const std::string& key : next.objKeys) {
+        if (!isStreamedType(key)) {
+            continue;
+        }
+        std::size_t type = typeIndex(key);
+        const LevelDiff& diff = diffs[type];
+        for (std::size_t i = 0; i < next.count(key); ++i) {
+            std::uint32_t uid = static_cast<std::uint32_t>(nextObjects.size());
+            nextObjects.push_back(StreamObject{key, static_cast<std::uint32_t>(i)});
+            if (diff.unchanged(i)) {
+                std::uint32_t oldUid = oldUids[type][diff.previous[i]];
+                oldToNew[oldUid] = uid;
+                nextStates.push_back(objectStates[oldUid]);
+            } else {
+                nextStates.push_back(ObjectState{});
+                pending.push_back(uid);
+            }
+        }
+    }
+
+    // 4) 已创建的实例：删除和改变的移除（同时销毁Box2D实体，方块从合并碰撞和烘焙区块中去掉），其余改用新uid
+    for (StreamChunk& chunk : streamChunks) {
+        for (std::size_t k = 0; k < chunk.live.size();) {
+            LiveObject& entry = chunk.live[k];
+            std::uint32_t uid = oldToNew[entry.uid];
+            if (uid == static_cast<std::uint32_t>(npos)) {
+                removeObject(entry.slot);
+                entry = chunk.live.back();
+                chunk.live.pop_back();
+                --streamStats.residentObjects;
+                continue;
+            }
+            entry.uid = uid;
+            ++k;
+        }
+        std::size_t kept = 0;
+        for (std::uint32_t uid : chunk.objects) {
+            if (oldToNew[uid] != static_cast<std::uint32_t>(npos)) {
+                chunk.objects[kept++] = oldToNew[uid];
+            }
+        }
+        chunk.objects.resize(kept);
+    }
+
+    // 5) 换上新的描述，之后创建的对象都从这里读取
+    levelDesc.objKeys        = std::move(next.objKeys);
+    levelDesc.parallaxLayers = std::move(next.parallaxLayers);
+    levelDesc.blocks         = std::move(next.blocks);
+    levelDesc.enemies        = std::move(next.enemies);
+    levelDesc.traps          = std::move(next.traps);
+    streamObjects.swap(nextObjects);
+    objectStates.swap(nextStates);
+
+    // 对象超出原来的区块范围时追加区块（不缩减，已有区块的加载状态不变）
+    float rightMost = 0.0f;
+    for (const StreamObject& obj : streamObjects) {
+        float x = 0.0f, width = 0.0f;
+        streamExtent(levelDesc, obj.type, obj.index, x, width);
+        rightMost = std::max(rightMost, x + width);
+    }
+    float chunkWidth = std::max(1.0f, streamSettings.chunkWidth);
+    std::size_t chunkCount = static_cast<std::size_t>(std::ceil(std::max(levelWidth, rightMost) / chunkWidth));
+    if (!streamObjects.empty() && chunkCount > streamChunks.size()) {
+        streamChunks.resize(chunkCount);
+        streamStats.totalChunks = streamChunks.size();
+    }
+    for (StreamObject& obj : streamObjects) {
+        float x = 0.0f, width = 0.0f;
+        streamExtent(levelDesc, obj.type, obj.index, x, width);
+        obj.homeChunk = streamChunkIndexFor(x);
+    }
+
+    // 6) 新增和改变的对象：归属区块已加载的直接创建，否则等区块加载
+    for (std::uint32_t uid : pending) {
+        StreamChunk& chunk = streamChunks[streamObjects[uid].homeChunk];
+        if (!chunk.loaded) {
+            chunk.objects.push_back(uid);
+            continue;
+        }
+        std::size_t slot = instantiateStreamObject(uid);
+        if (slot != npos) {
+            chunk.live.push_back(LiveObject{slot, uid});
+            ++streamStats.residentObjects;
+        }
+    }
+    // 视差层：未改变的保留，其余移除后按新描述重建；重建的被追加在绘制列表末尾，按图层描述的顺序放回原来的位置
+    parallaxSlots = patchOrderedSlots(parallaxDiff, parallaxSlots, alwaysDrawIds,
+        [this](std::size_t slot) { removeObject(slot); },
+        [this](std::size_t index) { return addObject("ParallaxLayer", index); });
+
+    // uid重新编号后旧的回滚帧不再适用；reload改为回到编辑后的关卡
+    rollbackRing.clear();
+    rollbackStats.frames = 0;
+    rewinding_ = false;
+    captureSnapshot();
+    // 合并碰撞在下一次步进前、烘焙区块在下一次绘制前按需重建
+
+    float elapsed = Profiler::elapsedMs(start);
+    if (profiler) {
+        profiler->event("levelPatch", configPath, elapsed);
+    }
+    printf("[Scene] Level objects patched in %.3f ms: %zu added, %zu removed, %zu changed.\n",
+           elapsed, added, removed, modified);
+}
+
+void Scene::captureSnapshot() {
+    snapshot = LevelSnapshot{};
+    // 初始状态下每个对象都在按配置坐标归属的区块中
+    snapshot.chunkObjects.resize(streamChunks.size());
+    for (std::size_t uid = 0; uid < streamObjects.size(); ++uid) {
+        const StreamObject& obj = streamObjects[uid];
+        snapshot.chunkObjects[obj.homeChunk].push_back(static_cast<std::uint32_t>(uid));
+        // 图集之外的纹理在这里加载并持有，reload时不会再读文件
+        const std::string& path = *levelDesc.texture(obj.type, obj.index);
+        if ((atlas && atlas->find(path)) || !textureCache) {
+            continue;
+        }
+        if (auto texture = textureCache->acquire(path)) {
+            snapshot.textures.push_back(std::move(texture));
+        }
+    }
+    snapshot.valid = true;
+}
+
+std::size_t Scene::instantiateStreamObject(std::uint32_t uid) {
+    const StreamObject& obj = streamObjects[uid];
+    std::size_t slot = addObject(obj.type, obj.index);
+    if (slot != npos && objectStates[uid].valid) {
+        sceneAssets[slot]->loadState(objectStates[uid]);
+    }
+    return slot;
+}
+
+std::size_t Scene::streamChunkFor(std::uint32_t uid) const {
+    const ObjectState& state = objectStates[uid];
+    return state.valid ? streamChunkIndexFor(state.x) : streamObjects[uid].homeChunk;
+}
+
+float Scene::streamChunkDistance(std::size_t index, const sf::FloatRect& focus) const {
+    float chunkWidth = std::max(1.0f, streamSettings.chunkWidth);
+    float chunkLeft  = static_cast<float>(index) * chunkWidth;
+    float chunkRight = chunkLeft + chunkWidth;
+    float left  = focus.position.x;
+    float right = focus.position.x + focus.size.x;
+    return std::max(0.0f, std::max(chunkLeft - right, left - chunkRight));
+}
+
+void Scene::syncTransforms() {
+    // 只处理本次步进中移动过的实体；睡着的实体不会产生移动事件，也就没有任何开销
+    b2BodyEvents events = b2World_GetBodyEvents(*world);
+    for (int i = 0; i < events.moveCount; ++i) {
+        const b2BodyMoveEvent& event = events.moveEvents[i];
+        if (!event.userData) continue;
+        static_cast<BaseObj*>(event.userData)->onBodyMoved(event.transform, event.fellAsleep);
+    }
+}
+
+void Scene::savePreviousTransforms() {
+    if (entities) {
+        entities->savePrevious();
+    }
+    if (playerPtr) {
+        playerPtr->savePreviousTransform();
+    }
+}
+
+void Scene::resetFixedStep() {
+    physicsAccumulator = 0.0f;
+    physicsStats.alpha = 1.0f;
+}
+
+void Scene::interpolateTransforms(float alpha) {
+    if (entities) {
+        EnemySystem::interpolate(*entities, alpha);
+    }
+    if (playerPtr) {
+        playerPtr->interpolateTransform(alpha);
+    }
+}
+
+void Scene::updateStreaming(const sf::FloatRect& focus) {
+    // 先卸载再加载：卸载时走到已加载区块里的敌人可以直接移交过去
+    for (std::size_t i = 0; i < streamChunks.size(); ++i) {
+        if (streamChunks[i].loaded && streamChunkDistance(i, focus) > streamSettings.unloadDistance) {
+            unloadStreamChunk(i);
+        }
+    }
+    for (std::size_t i = 0; i < streamChunks.size(); ++i) {
+        if (!streamChunks[i].loaded && streamChunkDistance(i, focus) <= streamSettings.loadDistance) {
+            loadStreamChunk(i);
+        } else if (!streamChunks[i].loaded && textureCache &&
+                   streamChunkDistance(i, focus) <= streamSettings.loadDistance + streamSettings.chunkWidth) {
+            // 再走一个区块宽度就要加载的区块：提前提示它的纹理，被驱逐的在之后几帧里分片重新加载
+            for (std::uint32_t uid : streamChunks[i].objects) {
+                const StreamObject& obj = streamObjects[uid];
+                const std::string& path = *levelDesc.texture(obj.type, obj.index);
+                if (!(atlas && atlas->find(path))) {
+                    textureCache->prefetch(path);
+                }
+            }
+        }
+    }
+}
+
+void Scene::prefetchTextures() {
+    if (!textureCache) {
+        return;
+    }
+    for (const std::string& key : levelDesc.objKeys) {
+        for (std::size_t i = 0; i < levelDesc.count(key); ++i) {
+            const std::string* path = levelDesc.texture(key, i);
+            if (path && !path->empty() && !(atlas && atlas->find(*path))) {
+                textureCache->prefetch(*path);
+            }
+        }
+    }
+}
+
+const sf::Image* Scene::findDecodedImage(const std::string& texture) const {
+    if (!levelData) {
+        return nullptr;
+    }
+    auto image = levelData->images.find(texture);
+    return image != levelData->images.end() ? &image->second : nullptr;
+}
+
+std::shared_ptr<const RawImageCache::Entry> Scene::findRawImage(const std::string& texture) const {
+    if (!levelData) {
+        return nullptr;
+    }
+    auto raw = levelData->rawImages.find(texture);
+    return raw != levelData->rawImages.end() ? raw->second : nullptr;
+}
+
+void Scene::loadStreamChunk(std::size_t index) {
+    StreamChunk& chunk = streamChunks[index];
+    for (std::uint32_t uid : chunk.objects) {
+        std::size_t slot = instantiateStreamObject(uid);
+        if (slot != npos) {
+            chunk.live.push_back(LiveObject{slot, uid});
+        }
+    }
+    chunk.objects.clear();
+    chunk.loaded = true;
+    ++streamStats.loadedChunks;
+    streamStats.residentObjects += chunk.live.size();
+    printf("[Scene] Stream chunk %zu loaded (%zu objects).\n", index, chunk.live.size());
+}
+
+void Scene::unloadStreamChunk(std::size_t index) {
+    std::vector<LiveObject> live;
+    live.swap(streamChunks[index].live);
+    streamChunks[index].loaded = false;
+    --streamStats.loadedChunks;
+
+    std::size_t saved = 0;
+    for (LiveObject& entry : live) {
+        const auto& obj = sceneAssets[entry.slot];
+        if (!obj) {
+            --streamStats.residentObjects;
+            continue;
+        }
+        // 会移动的对象（敌人）按当前位置归属区块
+        std::size_t target = index;
+        if (!obj->hasFeature("static")) {
+            target = streamChunkIndexFor(obj->getRenderBounds().position.x);
+        }
+        if (target != index && streamChunks[target].loaded) {
+            // 已经走进仍在加载中的区块，直接移交，不销毁
+            streamChunks[target].live.push_back(entry);
+            continue;
+        }
+        // 记录运行时状态，被破坏/击败的对象不再放回区块
+        ObjectState& state = objectStates[entry.uid];
+        obj->saveState(state);
+        if (state.alive) {
+            streamChunks[target].objects.push_back(entry.uid);
+            ++saved;
+        }
+        removeObject(entry.slot);
+        --streamStats.residentObjects;
+    }
+    printf("[Scene] Stream chunk %zu unloaded (%zu objects saved).\n", index, saved);
+}
+
+// 场景状态缓冲的格式标记，格式改变时需要修改
+static const std::uint32_t sceneStateMagic = 0x31544353;
+// 自动估算快照容量时为子弹预留的数量
+static const std::size_t rollbackProjectileReserve = 64;
+
+bool Scene::captureState(StateWriter& out) {
+    // 已加载对象的状态刷新到objectStates，未加载对象的状态在卸载时已经记录
+    for (const StreamChunk& chunk : streamChunks) {
+        for (const LiveObject& entry : chunk.live) {
+            if (sceneAssets[entry.slot]) {
+                sceneAssets[entry.slot]->saveState(objectStates[entry.uid]);
+            }
+        }
+    }
+    std::uint32_t count = static_cast<std::uint32_t>(objectStates.size());
+    out.write(sceneStateMagic);
+    out.write(count);
+    out.writeBytes(objectStates.data(), count * sizeof(ObjectState));
+
+    std::uint8_t sceneFlags = static_cast<std::uint8_t>((levelCompleted_ ? 1 : 0) | (playerWasDead ? 2 : 0));
+    out.write(sceneFlags);
+
+    Player::State playerState{};
+    std::uint8_t hasPlayer = 0;
+    if (auto player = dynamic_cast<Player*>(playerPtr.get())) {
+        player->captureState(playerState);
+        hasPlayer = 1;
+    }
+    out.write(hasPlayer);
+    out.write(playerState);
+
+    std::uint32_t projectileCount = 0;
+    for (const auto& proj : projectiles) {
+        if (proj && proj->isActive()) {
+            ++projectileCount;
+        }
+    }
+    out.write(projectileCount);
+    for (const auto& proj : projectiles) {
+        if (!proj || !proj->isActive()) {
+            continue;
+        }
+        ObjectState state;
+        proj->saveState(state);
+        out.write(state);
+    }
+    return out.ok();
+}
+
+bool Scene::restoreState(StateReader& in) {
+    // 先完整读出缓冲，格式不符时不修改场景
+    std::uint32_t magic = 0;
+    std::uint32_t count = 0;
+    in.read(magic);
+    in.read(count);
+    if (!in.ok() || magic != sceneStateMagic || count != objectStates.size()) {
+        return false;
+    }
+    restoreStates.resize(count);
+    in.readBytes(restoreStates.data(), count * sizeof(ObjectState));
+    std::uint8_t sceneFlags = 0;
+    std::uint8_t hasPlayer = 0;
+    Player::State playerState{};
+    std::uint32_t projectileCount = 0;
+    in.read(sceneFlags);
+    in.read(hasPlayer);
+    in.read(playerState);
+    in.read(projectileCount);
+    if (!in.ok() || projectileCount > in.remaining() / sizeof(ObjectState)) {
+        return false;
+    }
+    projectileStates.resize(projectileCount);
+    in.readBytes(projectileStates.data(), projectileCount * sizeof(ObjectState));
+    if (!in.ok()) {
+        return false;
+    }
+
+    objectStates.swap(restoreStates);
+    levelCompleted_ = (sceneFlags & 1) != 0;
+    playerWasDead   = (sceneFlags & 2) != 0;
+    if (hasPlayer) {
+        if (auto player = dynamic_cast<Player*>(playerPtr.get())) {
+            player->restoreState(playerState);
+        }
+    }
+
+    // 1) 已加载的流式对象：快照中已不存在的移除，存活的原地恢复；
+    //    当前已被破坏（或快照时还没加载过）的按配置重新创建
+    liveMarks.assign(objectStates.size(), 0);
+    for (StreamChunk& chunk : streamChunks) {
+        for (std::size_t k = 0; k < chunk.live.size();) {
+            LiveObject& entry = chunk.live[k];
+            const ObjectState& target = objectStates[entry.uid];
+            ObjectState current;
+            current.alive = 0;
+            if (sceneAssets[entry.slot]) {
+                sceneAssets[entry.slot]->saveState(current);
+            }
+            if (target.valid && current.alive) {
+                sceneAssets[entry.slot]->loadState(target);
+            } else {
+                removeObject(entry.slot);
+                entry.slot = npos;
+                if (!target.valid || target.alive) {
+                    entry.slot = instantiateStreamObject(entry.uid);
+                }
+            }
+            if (entry.slot == npos) {
+                entry = chunk.live.back();
+                chunk.live.pop_back();
+                --streamStats.residentObjects;
+                continue;
+            }
+            liveMarks[entry.uid] = 1;
+            ++k;
+        }
+    }
+
+    // 2) 其余对象按快照中的位置重新分配区块，归属区块已加载的直接创建
+    for (StreamChunk& chunk : streamChunks) {
+        chunk.objects.clear();
+    }
+    for (std::uint32_t uid = 0; uid < objectStates.size(); ++uid) {
+        const ObjectState& state = objectStates[uid];
+        if (liveMarks[uid] || (state.valid && !state.alive)) {
+            continue;
+        }
+        StreamChunk& chunk = streamChunks[streamChunkFor(uid)];
+        if (!chunk.loaded) {
+            chunk.objects.push_back(uid);
+            continue;
+        }
+        std::size_t slot = instantiateStreamObject(uid);
+        if (slot != npos) {
+            chunk.live.push_back(LiveObject{slot, uid});
+            ++streamStats.residentObjects;
+        }
+    }
+
+    // 3) 子弹：类型和朝向一致的原地恢复，其余重新生成
+    auto it = projectiles.begin();
+    for (const ObjectState& state : projectileStates) {
+        bool reusable = false;
+        if (it != projectiles.end() && *it && (*it)->isActive()) {
+            ObjectState current;
+            (*it)->saveState(current);
+            reusable = current.kind == state.kind && current.flags == state.flags;
+        }
+        if (!reusable) {
+            auto proj = std::make_unique<Projectile>();
+            proj->setWindowPtr(windowPtr);
+            proj->setEventSysPtr(eventSysPtr);
+            attachRenderPtrs(*proj);
+            proj->initializeDynamic(static_cast<Projectile::ProjectileType>(state.kind),
+                                    sf::Vector2f(state.x, state.y),
+                                    (state.flags & 1) != 0);
+            it = projectiles.insert(it, std::move(proj));
+        }
+        (*it)->loadState(state);
+        ++it;
+    }
+    projectiles.erase(it, projectiles.end());
+    resetFixedStep();
+    return true;
+}
+
+void Scene::enableRollback(std::size_t frames, std::size_t slotBytes) {
+    rewinding_ = false;
+    rollbackStats = RollbackStats{};
+    if (frames == 0) {
+        rollbackEnabled = false;
+        rollbackRing.reset(0, 0);
+        return;
+    }
+    if (slotBytes == 0) {
+        // 头部 + 全部流式对象 + 玩家 + 预留的子弹
+        slotBytes = sizeof(std::uint32_t) * 3 + sizeof(std::uint8_t) * 2 +
+                    objectStates.size() * sizeof(ObjectState) + sizeof(Player::State) +
+                    rollbackProjectileReserve * sizeof(ObjectState);
+    }
+    rollbackRing.reset(frames, slotBytes);
+    // 恢复时用到的临时数组也提前分配好
+    restoreStates.reserve(objectStates.size());
+    liveMarks.reserve(objectStates.size());
+    projectileStates.reserve(rollbackProjectileReserve);
+    rollbackEnabled = true;
+    printf("[Scene] Rollback enabled: %zu frame(s) x %zu bytes.\n", frames, slotBytes);
+}
+
+void Scene::recordRollbackFrame() {
+    sf::Clock captureClock;
+    StateWriter writer = rollbackRing.beginWrite();
+    if (captureState(writer) && rollbackRing.commit(writer)) {
+        rollbackStats.lastBytes = writer.size();
+    } else {
+        printf("[Scene] Rollback frame dropped: state exceeds %zu bytes.\n", rollbackRing.slotCapacity());
+    }
+    rollbackStats.frames = rollbackRing.size();
+    rollbackStats.captureMs = static_cast<float>(captureClock.getElapsedTime().asMicroseconds()) / 1000.0f;
+}
+
+void Scene::rewindFrame() {
+    sf::Clock restoreClock;
+    StateReader reader;
+    // 最旧的一帧保留，一直回放时停在那里
+    bool found = rollbackRing.size() > 1 ? rollbackRing.pop(reader) : rollbackRing.peek(0, reader);
+    if (!found) {
+        return;
+    }
+    if (!restoreState(reader)) {
+        printf("[Scene] Rollback frame could not be restored.\n");
+        return;
+    }
+    rollbackStats.frames = rollbackRing.size();
+    // 按住回放键时每帧调用，不输出日志：耗时和剩余帧数见getRollbackStats，耗时统计记入Profiler
+    rollbackStats.restoreMs = static_cast<float>(restoreClock.getElapsedTime().asMicroseconds()) / 1000.0f;
+    if (profiler) {
+        profiler->record("Scene.rewindFrame", rollbackStats.restoreMs);
+    }
+}
+
+sf::FloatRect Scene::getCullingRect() const {
+    auto window = windowPtr.lock();
+    if (!window) {
+        return sf::FloatRect();
+    }
+    // 相机视野向外扩展一圈边距，避免对象在屏幕边缘突然出现
+    const sf::View& view = window->getView();
+    sf::Vector2f size = view.getSize();
+    sf::Vector2f topLeft = view.getCenter() - size * 0.5f;
+    float margin = renderSettings.cullMargin;
+    return sf::FloatRect({topLeft.x - margin, topLeft.y - margin},
+                         {size.x + margin * 2.0f, size.y + margin * 2.0f});
+}
+
 void Scene::regImmEvent(const EventSys::ImmEventPriority priority, const EventSys::EventFunc& func) {
     // 注册即时事件
     if (auto eventSys = eventSysPtr.lock()) {
@@ -674,11 +1891,14 @@ void Scene::regTimedEvent(const sf::Time delay, const EventSys::EventFunc& func)
     }
 }
 
-void Scene::addObject(const std::string type, const ResourceLoader::ResourceDict& objConfig) {
-    // 根据objConfig创建游戏对象并添加到sceneAssets
-    // 分支逻辑根据objConfig中的类型信息决定创建哪种GameObj子类
-    // Debug
-    printf("Adding object of type: %s\n", type.c_str());
+std::size_t Scene::addObject(const std::string& type, std::size_t index) {
+    // 根据levelDesc中的描述创建游戏对象并添加到sceneAssets
+    // 分支逻辑根据类型决定创建哪种GameObj子类，index为该类型描述数组中的下标
+    // Debug（流式对象随区块加载反复创建，不逐个输出）
+    if (!isStreamedType(type)) {
+        printf("Adding object of type: %s\n", type.c_str());
+    }
+    std::size_t slot = npos;
     if (type == "GraphicObj") {
         // Debug
         printf("Adding GraphicObj to Scene.\n");
@@ -686,10 +1906,11 @@ void Scene::addObject(const std::string type, const ResourceLoader::ResourceDict
         auto newGraphic = std::make_unique<GraphicObj>();
         // 设置GraphicObj的核心指针
         newGraphic->setPtrs(eventSysPtr, windowPtr, inputPtr);
+        attachRenderPtrs(*newGraphic);
         // 初始化GraphicObj对象
-        newGraphic->initialize(objConfig);
+        newGraphic->initialize(levelDesc.graphics[index]);
         // 添加到场景对象列表
-        sceneAssets.push_back(std::move(newGraphic));
+        slot = storeObject(std::move(newGraphic));
     } else if (type == "ParallaxLayer") {
         // Debug
         printf("Adding ParallaxLayer to Scene.\n");
@@ -697,43 +1918,84 @@ void Scene::addObject(const std::string type, const ResourceLoader::ResourceDict
         auto newParallax = std::make_unique<ParallaxLayer>();
         // 设置ParallaxLayer的核心指针（不需要物理世界和输入）
         newParallax->setPtrs(eventSysPtr, windowPtr);
-        // 初始化ParallaxLayer对象
-        newParallax->initialize(objConfig);
+        newParallax->setTextureCachePtr(textureCache);
+        // 纹理矩形至少覆盖整个关卡宽度
+        newParallax->setLevelWidth(std::max(levelWidth, 10000.0f));
+        // 加载期间使用工作线程解码好的图片
+        const ParallaxDesc& desc = levelDesc.parallaxLayers[index];
+        newParallax->setSourceImage(findDecodedImage(desc.texture));
+        newParallax->setSourceRaw(findRawImage(desc.texture));
+        // 初始化ParallaxLayer对象（上传重复平铺的纹理）
+        Profiler::Clock::time_point start = Profiler::Clock::now();
+        newParallax->initialize(desc);
+        if (profiler) {
+            profiler->event("upload", desc.texture, Profiler::elapsedMs(start));
+        }
         // 添加到场景对象列表
-        sceneAssets.push_back(std::move(newParallax));
+        slot = storeObject(std::move(newParallax));
     } else if (type == "Block") {
         // Debug
-        printf("Adding Block to Scene.\n");
+        // printf("Adding Block to Scene.\n");
         // 创建Block对象
         auto newBlock = std::make_unique<Block>();
         // 设置Block的核心指针
         newBlock->setPtrs(eventSysPtr, windowPtr, world);
+        attachRenderPtrs(*newBlock);
+        // 方块被破坏时只重建它所在的静态区块
+        std::uint32_t blockId = static_cast<std::uint32_t>(nextObjectSlot());
+        std::weak_ptr<StaticChunkCache> chunks = staticChunks;
+        std::weak_ptr<StaticBodyMerger> merger = staticMerger;
+        newBlock->setKillCallback([chunks, merger, blockId](Block&) {
+            if (auto cache = chunks.lock()) {
+                cache->invalidate(blockId);
+            }
+            // 合并碰撞中去掉该方块，下一帧步进前重建所在分组
+            if (auto bodies = merger.lock()) {
+                bodies->removeTile(blockId);
+            }
+        });
+        // 相邻方块的碰撞由staticMerger合并
+        newBlock->setMergedCollision(staticMerger != nullptr);
+        newBlock->setBlockStore(blockStore);
         // 初始化Block对象
-        newBlock->initialize(objConfig);
+        newBlock->initialize(levelDesc.blocks[index]);
+        if (staticMerger) {
+            const sf::FloatRect& rect = newBlock->getCollisionRect();
+            StaticBodyMerger::Tile tile;
+            tile.left     = rect.position.x;
+            tile.top      = rect.position.y;
+            tile.right    = rect.position.x + rect.size.x;
+            tile.bottom   = rect.position.y + rect.size.y;
+            tile.material = static_cast<int>(newBlock->getBlockType());
+            staticMerger->addTile(blockId, static_cast<std::uint32_t>(streamChunkIndexFor(tile.left)), tile);
+        }
         // 添加到场景对象列表
-        sceneAssets.push_back(std::move(newBlock));
+        slot = storeObject(std::move(newBlock));
     } else if (type == "Enemy") {
         // Debug
-        printf("Adding Enemy to Scene.\n");
+        // printf("Adding Enemy to Scene.\n");
         // 创建Enemy对象
         auto newEnemy = std::make_unique<Enemy>();
         // 设置Enemy的核心指针
         newEnemy->setPtrs(eventSysPtr, windowPtr, world, inputPtr);
+        attachRenderPtrs(*newEnemy);
+        newEnemy->setEntityStore(entities);
         // 初始化Enemy对象
-        newEnemy->initialize(objConfig);
+        newEnemy->initialize(levelDesc.enemies[index]);
         // 添加到场景对象列表
-        sceneAssets.push_back(std::move(newEnemy));
+        slot = storeObject(std::move(newEnemy));
     } else if (type == "Trap") {
         // Debug
-        printf("Adding Trap to Scene.\n");
+        // printf("Adding Trap to Scene.\n");
         // 创建Trap对象
         auto newTrap = std::make_unique<Trap>();
         // 设置Trap的核心指针
         newTrap->setPtrs(eventSysPtr, windowPtr, world);
+        attachRenderPtrs(*newTrap);
         // 初始化Trap对象
-        newTrap->initialize(objConfig);
+        newTrap->initialize(levelDesc.traps[index]);
         // 添加到场景对象列表
-        sceneAssets.push_back(std::move(newTrap));
+        slot = storeObject(std::move(newTrap));
         
     } 
     else if (type == "AudioManager") {
@@ -751,7 +2013,7 @@ void Scene::addObject(const std::string type, const ResourceLoader::ResourceDict
         audioManagerPtr = audioManager;
         
         // 添加到场景对象列表
-        sceneAssets.push_back(audioManager);
+        slot = storeObject(audioManager);
         printf("AudioManager added to scene.\n");
     } 
     else {
@@ -759,6 +2021,11 @@ void Scene::addObject(const std::string type, const ResourceLoader::ResourceDict
         printf("Unknown object type: %s. Object not added.\n", type.c_str());
     }
 
+    // 新对象登记到剔除索引
+    if (slot != npos) {
+        indexObjectForCulling(slot);
+    }
+    return slot;
 }
 
 void Scene::setPlayerPtr(const std::shared_ptr<BaseObj>& player) {
@@ -781,6 +2048,12 @@ void Scene::setPlayerPtr(const std::shared_ptr<BaseObj>& player) {
                     auto proj = std::make_unique<Projectile>();
                     // printf("[Scene]   Projectile created\n");
                     
+                    // 使用公有方法设置指针
+                    proj->setWindowPtr(windowPtr);
+                    proj->setEventSysPtr(eventSysPtr);
+                    attachRenderPtrs(*proj);
+                    // printf("[Scene]   Pointers set\n");
+
                     proj->initializeDynamic(
                         Projectile::fromString(req.type),
                         req.position,
@@ -788,11 +2061,6 @@ void Scene::setPlayerPtr(const std::shared_ptr<BaseObj>& player) {
                     );
                     // printf("[Scene]   Projectile initialized\n");
                     
-                    // 使用公有方法设置指针
-                    proj->setWindowPtr(windowPtr);
-                    proj->setEventSysPtr(eventSysPtr);
-                    // printf("[Scene]   Pointers set\n");
-                    
                     projectiles.push_back(std::move(proj));
                     // printf("[Scene]   Projectile added to list. Total: %zu\n", projectiles.size());
                 } 
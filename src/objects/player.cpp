@@ -1,5 +1,7 @@
 #include "Player.hpp"
 #include "GameInput.hpp"
+#include "AssetPack.hpp"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -29,6 +31,14 @@ sf::Vector2f Player::getPosition() const
     return sf::Vector2f(pos.x, pos.y);
 }
 
+sf::Vector2f Player::getRenderPosition() const
+{
+    if (!sprite.has_value()) {
+        return getPosition();
+    }
+    return sprite->getPosition();
+}
+
 sf::FloatRect Player::getBounds() const
 {
     if (!sprite.has_value()) {
@@ -128,6 +138,8 @@ void Player::initialize()
     def.type     = b2_dynamicBody;
     def.position = { m_spawnPos.x, m_spawnPos.y };
     m_body = b2CreateBody(m_world, &def);
+    // 移动事件通过userData找到玩家
+    b2Body_SetUserData(m_body, static_cast<BaseObj*>(this));
 
     b2Polygon box = b2MakeBox(0.5f, 1.0f);
     // 碰撞箱微调
@@ -143,20 +155,20 @@ void Player::initialize()
 
     // ========== 贴图 ==========
     m_idleTexture.emplace();
-    if (!m_idleTexture->loadFromFile("assets/texture/player_idle.png"))
+    if (!AssetVfs::load(*m_idleTexture, "assets/texture/player_idle.png"))
         std::cout << "Fail idle\n";
 
     m_runTexture.emplace();
-    if (!m_runTexture->loadFromFile("assets/texture/player_run.png"))
+    if (!AssetVfs::load(*m_runTexture, "assets/texture/player_run.png"))
         std::cout << "Fail run\n";
 
     m_jumpTexture.emplace();
-    if (!m_jumpTexture->loadFromFile("assets/texture/player_jump.png"))
+    if (!AssetVfs::load(*m_jumpTexture, "assets/texture/player_jump.png"))
         std::cout << "Fail jump\n";
 
     // 🆕 游泳贴图
     m_swimTexture.emplace();
-    if (!m_swimTexture->loadFromFile("assets/texture/player_swim.png"))
+    if (!AssetVfs::load(*m_swimTexture, "assets/texture/player_swim.png"))
         std::cout << "Fail swim\n";
 
     // ========== 初始 Sprite ==========
@@ -224,6 +236,108 @@ void Player::initialize()
     syncSpriteWithBody();
 }
 
+void Player::respawn()
+{
+    // ========== Box2D Body：移回出生点，清空速度 ==========
+    if (b2Body_IsValid(m_body)) {
+        b2Body_SetTransform(m_body, { m_spawnPos.x, m_spawnPos.y }, b2Rot_identity);
+        b2Body_SetLinearVelocity(m_body, { 0.0f, 0.0f });
+        b2Body_SetAngularVelocity(m_body, 0.0f);
+        b2Body_SetAwake(m_body, true);
+    }
+
+    // ===== 血量 =====
+    m_health              = m_maxHealth;
+    m_isAlive             = true;
+    m_invincibleTime      = 0.0f;
+    m_spawnProtectionTime = 0.1f;
+
+    // ===== 移动 / 跳跃 / 射击 =====
+    m_jumpCount     = 0;
+    m_grounded      = false;
+    m_isJumpingUp   = false;
+    m_envSpeedScale = 1.0f;
+    m_inWater       = false;
+    m_moveDir       = 0.0f;
+    m_fireCooldown  = 0.0f;
+
+    // ===== 动画：回到待机贴图，朝右 =====
+    m_facingRight      = true;
+    m_currentRunFrame  = 0;
+    m_currentSwimFrame = 0;
+    m_animTimer        = 0.0f;
+    if (m_idleTexture.has_value()) {
+        sprite.emplace(*m_idleTexture);
+        sprite->setScale({0.1f, 0.1f});
+        m_baseScaleX = sprite->getScale().x;
+        auto bounds = sprite->getLocalBounds();
+        sprite->setOrigin({bounds.size.x / 2, bounds.size.y / 2});
+    }
+
+    syncSpriteWithBody();
+}
+
+void Player::captureState(State& state) const
+{
+    if (b2Body_IsValid(m_body)) {
+        b2Vec2 pos = b2Body_GetPosition(m_body);
+        b2Vec2 vel = b2Body_GetLinearVelocity(m_body);
+        state.x     = pos.x;
+        state.y     = pos.y;
+        state.vx    = vel.x;
+        state.vy    = vel.y;
+        state.awake = b2Body_IsAwake(m_body) ? 1 : 0;
+    }
+    state.health              = m_health;
+    state.invincibleTime      = m_invincibleTime;
+    state.spawnProtectionTime = m_spawnProtectionTime;
+    state.envSpeedScale       = m_envSpeedScale;
+    state.moveDir             = m_moveDir;
+    state.fireCooldown        = m_fireCooldown;
+    state.animTimer           = m_animTimer;
+    state.jumpCount           = m_jumpCount;
+    state.runFrame            = m_currentRunFrame;
+    state.swimFrame           = m_currentSwimFrame;
+    state.alive               = m_isAlive ? 1 : 0;
+    state.grounded            = m_grounded ? 1 : 0;
+    state.jumpingUp           = m_isJumpingUp ? 1 : 0;
+    state.inWater             = m_inWater ? 1 : 0;
+    state.facingRight         = m_facingRight ? 1 : 0;
+}
+
+void Player::restoreState(const State& state)
+{
+    if (b2Body_IsValid(m_body)) {
+        b2Body_SetTransform(m_body, { state.x, state.y }, b2Rot_identity);
+        b2Body_SetLinearVelocity(m_body, { state.vx, state.vy });
+        b2Body_SetAngularVelocity(m_body, 0.0f);
+        b2Body_SetAwake(m_body, state.awake != 0);
+    }
+    m_health              = state.health;
+    m_invincibleTime      = state.invincibleTime;
+    m_spawnProtectionTime = state.spawnProtectionTime;
+    m_envSpeedScale       = state.envSpeedScale;
+    m_moveDir             = state.moveDir;
+    m_fireCooldown        = state.fireCooldown;
+    m_animTimer           = state.animTimer;
+    m_jumpCount           = state.jumpCount;
+    m_isAlive             = state.alive != 0;
+    m_grounded            = state.grounded != 0;
+    m_isJumpingUp         = state.jumpingUp != 0;
+    m_inWater             = state.inWater != 0;
+    if (!m_runFrames.empty()) {
+        m_currentRunFrame = std::clamp(state.runFrame, 0, static_cast<int>(m_runFrames.size()) - 1);
+    }
+    if (!m_swimFrames.empty()) {
+        m_currentSwimFrame = std::clamp(state.swimFrame, 0, static_cast<int>(m_swimFrames.size()) - 1);
+    }
+
+    // 按恢复后的状态选动画帧（不推进计时），再设置朝向和位置
+    updateAnimation(0.0f);
+    updateSpriteFacing(state.facingRight ? 1.0f : -1.0f);
+    syncSpriteWithBody();
+}
+
 void Player::draw()
 {
         // 检查类是否为可以画图的对象
@@ -298,7 +412,6 @@ void Player::update(float deltaTime)
 {
      // 死亡后先直接不更新逻辑
     if (!m_isAlive) {
-        syncSpriteWithBody();
         return;
     }
     
@@ -351,15 +464,15 @@ void Player::update(float deltaTime)
     if (m_inWater)
     {
         // 水下：不再使用space跳跃t逻辑，只用浮力自动上升和下潜
-        applyWaterPhysics(1.0f / 60.0f);
+        applyWaterPhysics(deltaTime);
     }
     else
     {
         // 陆地：正常跳，二段跳
         handleJump();
     }
-    updateAnimation(1.0f / 60.0f);
-    syncSpriteWithBody();
+    updateAnimation(deltaTime);
+    // sprite位置在物理步进后由onBodyMoved同步（实体没有移动时不需要更新）
 }
 
 void Player::syncSpriteWithBody()
@@ -368,6 +481,32 @@ void Player::syncSpriteWithBody()
 
     auto pos = b2Body_GetPosition(m_body);
     sprite->setPosition({pos.x, pos.y});
+    // 瞬移（出生、重生、回滚）不插值
+    m_prevBodyPos = m_currBodyPos = {pos.x, pos.y};
+    m_blending = false;
+}
+
+void Player::onBodyMoved(const b2Transform& transform, bool fellAsleep)
+{
+    m_currBodyPos = {transform.p.x, transform.p.y};
+    if (!sprite.has_value()) return;
+
+    sprite->setPosition(m_currBodyPos);
+}
+
+void Player::savePreviousTransform()
+{
+    m_prevBodyPos = m_currBodyPos;
+}
+
+void Player::interpolateTransform(float alpha)
+{
+    if (!sprite.has_value()) return;
+
+    bool moved = m_prevBodyPos != m_currBodyPos;
+    if (!moved && !m_blending) return;
+    sprite->setPosition(m_prevBodyPos + (m_currBodyPos - m_prevBodyPos) * alpha);
+    m_blending = moved;
 }
 
 void Player::updateGroundedState(float deltaTime)
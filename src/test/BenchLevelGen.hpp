@@ -0,0 +1,49 @@
+#pragma once
+// 基准共用：生成合成关卡JSON（LevelLoad_bench、LevelReader_bench读取同一种关卡，结果可以互相对照）
+#include "ResourceLoader.hpp"
+#include <chrono>
+#include <fstream>
+#include <string>
+
+namespace benchlevel {
+
+// objectCount个对象沿x排开，方块/敌人/陷阱按8:1:1，字段与config下的关卡文件相同
+inline void writeLevel(const std::string& path, int objectCount)
+{
+    json level;
+    level["name"] = "Bench";
+    level["gravityX"] = 0.0;
+    level["gravityY"] = 500.0;
+    level["objKeys"] = { "Block", "Enemy", "Trap" };
+    json blocks = json::array(), enemies = json::array(), traps = json::array();
+    for (int i = 0; i < objectCount; ++i) {
+        float x = 50.0f * i;
+        if (i % 10 == 8) {
+            enemies.push_back({ {"health", 3.0}, {"attackDamage", 1.0}, {"attackCooldown", 2.0},
+                                {"x", x}, {"y", 520.0}, {"width", 100.0}, {"height", 200.0},
+                                {"density", 0.0}, {"friction", 0.3}, {"velocityX", 200.0}, {"velocityY", 0.0},
+                                {"patrolAx", x}, {"patrolAy", 520.0}, {"patrolBx", x + 500.0}, {"patrolBy", 520.0},
+                                {"texture", "assets/texture/enemy.png"} });
+        } else if (i % 10 == 9) {
+            traps.push_back({ {"type", "SPIKE"}, {"element", "FIRE"}, {"health", 2.0}, {"damage", 1.0},
+                              {"x", x}, {"y", 640.0}, {"width", 100.0}, {"height", 100.0},
+                              {"triggerX", x - 200.0}, {"triggerY", 500.0}, {"triggerWidth", 200.0}, {"triggerHeight", 200.0},
+                              {"texture", "assets/texture/spike_fire.png"} });
+        } else {
+            blocks.push_back({ {"type", i % 3 == 0 ? "ICE" : "GRASS"}, {"health", 1000000.0},
+                               {"x", x}, {"y", 700.0}, {"width", 50.0}, {"height", 50.0},
+                               {"texture", "assets/texture/grass.png"} });
+        }
+    }
+    level["Block"] = blocks;
+    level["Enemy"] = enemies;
+    level["Trap"] = traps;
+    std::ofstream(path) << level.dump();
+}
+
+inline double msSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace benchlevel
@@ -14,6 +14,17 @@ int main()
 
     printf("Display Width: %d\n", std::get<int>(configLoader.getValue("DisplayWidth")));
     printf("Display Height: %d\n", std::get<int>(configLoader.getValue("DisplayHeight")));
+
+    // 共享实例：整个文件只解析一次，按（节, 键）类型化查找，整数与浮点自动转换，缺失时返回缺省值
+    std::shared_ptr<const ConfigLoader> shared = ConfigLoader::shared("config/engine.ini");
+    printf("DeltaTime: %f\n", shared->getFloat("Engine", "DeltaTime", 1.0f / 60.0f));
+    printf("CullMargin (int as float): %f\n", shared->getFloat("Render", "CullMargin", 0.0f));
+    printf("MergeStaticBlocks: %s\n", shared->getBool("Engine", "MergeStaticBlocks", false) ? "true" : "false");
+    printf("Missing key: %d\n", shared->getInt("Engine", "NoSuchKey", -1));
+    printf("Same instance: %s\n", shared == ConfigLoader::shared("config/engine.ini") ? "true" : "false");
+    // 句柄：名字只换成id一次，之后每次查找是一次整数哈希查找
+    ConfigLoader::Key frameLimit = shared->key("Display", "FrameLimit");
+    printf("FrameLimit (handle): %d\n", shared->getInt(frameLimit, 60));
     // printf("Fullscreen: %s\n", std::get<bool>(configLoader.getValue("FullScreen")) ? "true" : "false");
     // auto fullscreenValue = configLoader.getValue("FullScreen");
     // if (std::holds_alternative<bool>(fullscreenValue)) {
@@ -0,0 +1,279 @@
+// 敌人更新基准：逐对象虚函数更新（旧Enemy的写法） vs EntityStore + EnemySystem批量更新，
+// 以及巡逻/冷却/动画一段的标量实现 vs SIMD实现（开启GAME_ENABLE_AVX2时为AVX2，否则SSE2）；
+// 方块：逐对象注册update并逐个dynamic_cast做玩家接触判定（旧Block的写法） vs BlockStore + BlockSystem
+// 用法：EntityStore_bench [敌人数量] [帧数] [方块数量]，默认100000个敌人、100帧、100000个方块
+#include "EntityStore.hpp"
+#include <SFML/Graphics.hpp>
+#include <box2d/box2d.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// 旧写法：每个敌人一个堆对象，数据和特征表、sprite放在一起，通过虚函数逐个更新
+class LegacyObj {
+public:
+    virtual ~LegacyObj() = default;
+    virtual void update(float deltaTime) = 0;
+protected:
+    std::unordered_map<std::string, bool> features;
+};
+
+class LegacyEnemy : public LegacyObj {
+public:
+    LegacyEnemy(b2BodyId body, const sf::Texture& texture, const sf::IntRect* frames, float minX, float maxX)
+        : bodyId(body), sprite(texture), animFrames(frames), patrolMinX(minX), patrolMaxX(maxX)
+    {
+        features["drawable"] = true;
+        features["box2d"]    = true;
+        features["cullable"] = true;
+    }
+
+    void update(float deltaTime) override
+    {
+        b2Vec2 position = b2Body_GetPosition(bodyId);
+        if (faceRight) {
+            b2Body_SetLinearVelocity(bodyId, { std::abs(velocity.x), velocity.y });
+            if (position.x >= patrolMaxX) faceRight = false;
+        } else {
+            b2Body_SetLinearVelocity(bodyId, { -std::abs(velocity.x), velocity.y });
+            if (position.x <= patrolMinX) faceRight = true;
+        }
+        position = b2Body_GetPosition(bodyId);
+        sprite.setPosition({ position.x - 16.0f, position.y - 16.0f });
+        animTimer += deltaTime;
+        if (animTimer >= animFrameTime) {
+            animTimer -= animFrameTime;
+            currentAnimFrame = (currentAnimFrame + 1) % 3;
+        }
+        sprite.setTextureRect(animFrames[currentAnimFrame]);
+        sprite.setScale({ faceRight ? 0.25f : -0.25f, 0.25f });
+        if (attackCooldown > 0.0f) {
+            attackCooldown -= deltaTime;
+            if (attackCooldown < 0.0f) attackCooldown = 0.0f;
+        }
+    }
+
+private:
+    float health = 100.0f, maxHealth = 100.0f, attackDamage = 10.0f, attackCooldown = 1.0f;
+    bool isAlive = true, faceRight = true;
+    b2BodyId bodyId;
+    b2Vec2 velocity = { 60.0f, 0.0f };
+    sf::Sprite sprite;
+    const sf::IntRect* animFrames;
+    int currentAnimFrame = 0;
+    float animTimer = 0.0f, animFrameTime = 0.15f;
+    float patrolMinX, patrolMaxX;
+};
+
+// 旧写法的方块：数据和特征表、sprite放在一起，判定时逐个dynamic_cast并从sprite取包围盒
+class LegacyBlock : public LegacyObj {
+public:
+    LegacyBlock(const sf::Texture& texture, sf::Vector2f position, int type)
+        : sprite(texture, { { 0, 0 }, { 50, 50 } }), blockType(type)
+    {
+        features["drawable"] = true;
+        features["static"]   = true;
+        sprite.setPosition(position);
+    }
+
+    // 方块没有逐帧逻辑，但旧Scene每帧仍为每个方块调用一次
+    void update(float) override {}
+    sf::FloatRect getHitBox() const { return sprite.getGlobalBounds(); }
+    int getBlockType() const { return blockType; }
+
+private:
+    float health = 1000000.0f;
+    b2BodyId groundId = b2_nullBodyId;
+    sf::Sprite sprite;
+    int blockType;
+};
+
+// 在无重力世界中创建count个敌人实体（互不接触，只测更新开销）
+std::vector<b2BodyId> createBodies(b2WorldId world, int count)
+{
+    std::vector<b2BodyId> bodies;
+    bodies.reserve(count);
+    b2Polygon box = b2MakeBox(16.0f, 16.0f);
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = 1.0f;
+    for (int i = 0; i < count; ++i) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = { static_cast<float>(i % 1000) * 100.0f, static_cast<float>(i / 1000) * 100.0f };
+        b2BodyId body = b2CreateBody(world, &bodyDef);
+        b2CreatePolygonShape(body, &shapeDef, &box);
+        bodies.push_back(body);
+    }
+    return bodies;
+}
+
+template <typename Func>
+double measureMs(int frames, Func&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int enemyCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int frameCount = argc > 2 ? std::atoi(argv[2]) : 100;
+    int blockCount = argc > 3 ? std::atoi(argv[3]) : 100000;
+    const float deltaTime = 1.0f / 60.0f;
+
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = { 0.0f, 0.0f };
+    b2WorldId world = b2CreateWorld(&worldDef);
+    std::vector<b2BodyId> bodies = createBodies(world, enemyCount);
+
+    sf::Texture texture;
+    const sf::IntRect frames[3] = {
+        { { 0, 0 }, { 32, 32 } }, { { 32, 0 }, { 32, 32 } }, { { 64, 0 }, { 32, 32 } }
+    };
+
+    // 旧写法
+    std::vector<std::unique_ptr<LegacyObj>> legacy;
+    legacy.reserve(enemyCount);
+    for (int i = 0; i < enemyCount; ++i) {
+        float x = b2Body_GetPosition(bodies[i]).x;
+        legacy.push_back(std::make_unique<LegacyEnemy>(bodies[i], texture, frames, x - 40.0f, x + 40.0f));
+    }
+    double legacyMs = measureMs(frameCount, [&]() {
+        for (auto& obj : legacy) {
+            obj->update(deltaTime);
+        }
+    });
+    legacy.clear();
+
+    // SoA：sprite仍由对象持有，这里集中放在一个数组中
+    EntityStore store;
+    store.reserve(enemyCount);
+    std::vector<sf::Sprite> sprites(enemyCount, sf::Sprite(texture));
+    for (int i = 0; i < enemyCount; ++i) {
+        EntityStore::Entity entity = store.create();
+        std::size_t index = store.index(entity);
+        float x = b2Body_GetPosition(bodies[i]).x;
+        store.body[index]           = bodies[i];
+        store.halfW[index]          = 16.0f;
+        store.halfH[index]          = 16.0f;
+        store.patrolMinX[index]     = x - 40.0f;
+        store.patrolMaxX[index]     = x + 40.0f;
+        store.patrolSpeed[index]    = 60.0f;
+        store.health[index]         = 100.0f;
+        store.maxHealth[index]      = 100.0f;
+        store.attackCooldown[index] = 1.0f;
+        store.animFrameCount[index] = 3;
+        store.frames[index]         = frames;
+        store.sprite[index]         = &sprites[i];
+        store.posX[index]           = x;
+        store.posY[index]           = b2Body_GetPosition(bodies[i]).y;
+        // 移动事件通过userData找到实体（游戏中userData为Enemy对象）
+        b2Body_SetUserData(bodies[i], reinterpret_cast<void*>(static_cast<std::uintptr_t>(entity) + 1));
+    }
+    // 与Scene一致：步进后只应用移动事件，再批量更新（步进本身不计时）
+    auto applyMoveEvents = [&]() {
+        b2World_Step(world, deltaTime, 4);
+        store.clearDirty();
+        b2BodyEvents events = b2World_GetBodyEvents(world);
+        for (int e = 0; e < events.moveCount; ++e) {
+            const b2BodyMoveEvent& event = events.moveEvents[e];
+            auto entity = static_cast<EntityStore::Entity>(reinterpret_cast<std::uintptr_t>(event.userData) - 1);
+            store.onBodyMoved(entity, event.transform.p, event.fellAsleep);
+        }
+    };
+    double soaMs = 0.0;
+    for (int f = 0; f < frameCount; ++f) {
+        applyMoveEvents();
+        soaMs += measureMs(1, [&]() {
+            EnemySystem::update(store, deltaTime);
+        });
+    }
+    soaMs /= frameCount;
+
+    // 只比较纯数组计算部分（不含Box2D读写与sprite同步），所有敌人按视野内逐帧更新
+    EnemySystem::scheduleSteps(store, deltaTime, 1, 0, store.size());
+    double scalarMs = measureMs(frameCount, [&]() {
+        EnemySystem::stepPatrol(store, 0, store.size(), EnemySystem::Path::Scalar);
+    });
+    double simdMs = measureMs(frameCount, [&]() {
+        EnemySystem::stepPatrol(store, 0, store.size(), EnemySystem::Path::Simd);
+    });
+
+    // 方块：一行行地面，材质按GRASS/WATER/ICE/LAVA轮换；玩家包围盒每帧右移，沿地面扫过
+    const int lavaType = 3, iceType = 2;
+    std::vector<std::unique_ptr<LegacyObj>> legacyBlocks;
+    legacyBlocks.reserve(blockCount);
+    BlockStore blockStore;
+    blockStore.reserve(blockCount);
+    for (int i = 0; i < blockCount; ++i) {
+        float x = static_cast<float>(i % 2000) * 50.0f;
+        float y = 700.0f + static_cast<float>(i / 2000) * 50.0f;
+        legacyBlocks.push_back(std::make_unique<LegacyBlock>(texture, sf::Vector2f(x, y), i % 4));
+        BlockStore::Entity entity = blockStore.create();
+        std::size_t index = blockStore.index(entity);
+        blockStore.left[index]   = x;
+        blockStore.top[index]    = y;
+        blockStore.right[index]  = x + 50.0f;
+        blockStore.bottom[index] = y + 50.0f;
+        blockStore.type[index]   = i % 4;
+        blockStore.health[index] = 1000000.0f;
+    }
+    auto playerBounds = [](int frame) {
+        return sf::FloatRect({ static_cast<float>(frame) * 7.0f, 640.0f }, { 40.0f, 70.0f });
+    };
+    int legacyTouches = 0, soaTouches = 0;
+    int frame = 0;
+    double legacyBlockMs = measureMs(frameCount, [&]() {
+        sf::FloatRect player = playerBounds(frame++);
+        bool onLava = false, onIce = false;
+        for (auto& obj : legacyBlocks) {
+            obj->update(deltaTime);
+        }
+        for (auto& obj : legacyBlocks) {
+            auto block = dynamic_cast<LegacyBlock*>(obj.get());
+            if (!block) continue;
+            sf::FloatRect b = block->getHitBox();
+            bool intersect = player.position.x < b.position.x + b.size.x && player.position.x + player.size.x > b.position.x &&
+                             player.position.y < b.position.y + b.size.y && player.position.y + player.size.y > b.position.y;
+            if (!intersect) continue;
+            onLava |= block->getBlockType() == lavaType;
+            onIce  |= block->getBlockType() == iceType;
+        }
+        legacyTouches += (onLava ? 1 : 0) + (onIce ? 1 : 0);
+    });
+    frame = 0;
+    double soaBlockMs = measureMs(frameCount, [&]() {
+        std::uint32_t touched = BlockSystem::touchedTypes(blockStore, playerBounds(frame++));
+        soaTouches += ((touched >> lavaType) & 1u) + ((touched >> iceType) & 1u);
+    });
+
+    printf("[EntityStore_bench] %d enemies, %d frames\n", enemyCount, frameCount);
+    printf("  legacy objects : %.3f ms/frame\n", legacyMs);
+    printf("  EnemySystem    : %.3f ms/frame\n", soaMs);
+    printf("  speedup        : %.2fx\n", soaMs > 0.0 ? legacyMs / soaMs : 0.0);
+    printf("  patrol scalar  : %.3f ms/frame\n", scalarMs);
+    printf("  patrol SIMD x%d : %.3f ms/frame\n", EnemySystem::simdWidth(), simdMs);
+    printf("  SIMD speedup   : %.2fx\n", simdMs > 0.0 ? scalarMs / simdMs : 0.0);
+    printf("[EntityStore_bench] %d blocks, player contact (lava/ice)\n", blockCount);
+    printf("  legacy objects : %.3f ms/frame\n", legacyBlockMs);
+    printf("  BlockSystem    : %.3f ms/frame\n", soaBlockMs);
+    printf("  speedup        : %.2fx, contacts %s\n", soaBlockMs > 0.0 ? legacyBlockMs / soaBlockMs : 0.0,
+           legacyTouches == soaTouches ? "match" : "MISMATCH");
+
+    b2DestroyWorld(world);
+    return 0;
+}
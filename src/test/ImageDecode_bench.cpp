@@ -0,0 +1,92 @@
+// 图片解码基准：关卡引用的全部纹理逐个解码 vs 在TaskScheduler上并行解码（与Scene加载阶段相同）
+// 用法：ImageDecode_bench [关卡.json] [线程数]，默认config/level1.json、全部硬件线程；需在仓库根目录运行
+#include "LevelReader.hpp"
+#include "Profiler.hpp"
+#include "TaskScheduler.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Batch
+{
+    const std::vector<std::string>* paths = nullptr;
+    std::vector<sf::Image> images;
+    Profiler* profiler = nullptr;
+};
+
+void decodeRange(int begin, int end, std::uint32_t, void* context)
+{
+    Batch& batch = *static_cast<Batch*>(context);
+    for (int i = begin; i < end; ++i) {
+        Profiler::Clock::time_point start = Profiler::Clock::now();
+        if (!batch.images[i].loadFromFile((*batch.paths)[i])) {
+            printf("Failed to decode %s\n", (*batch.paths)[i].c_str());
+        }
+        batch.profiler->event("decode", (*batch.paths)[i], Profiler::elapsedMs(start));
+    }
+}
+
+double run(const std::vector<std::string>& paths, TaskScheduler* scheduler, Profiler& profiler)
+{
+    Batch batch;
+    batch.paths = &paths;
+    batch.images.resize(paths.size());
+    batch.profiler = &profiler;
+    Profiler::Clock::time_point start = Profiler::Clock::now();
+    if (scheduler) {
+        if (TaskScheduler::Task* task = scheduler->submit(&decodeRange, static_cast<int>(paths.size()), 1, &batch)) {
+            scheduler->wait(task);
+        }
+    } else {
+        decodeRange(0, static_cast<int>(paths.size()), 0, &batch);
+    }
+    return Profiler::elapsedMs(start);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string levelPath = argc > 1 ? argv[1] : "config/level1.json";
+    int threads = argc > 2 ? std::atoi(argv[2]) : 0;
+
+    LevelReader reader;
+    LevelDesc level;
+    reader.read(levelPath, level);
+    std::vector<std::string> paths;
+    for (const std::string& key : level.objKeys) {
+        for (std::size_t i = 0; i < level.count(key); ++i) {
+            const std::string& texture = *level.texture(key, i);
+            if (std::find(paths.begin(), paths.end(), texture) == paths.end()) {
+                paths.push_back(texture);
+            }
+        }
+    }
+    if (paths.empty()) {
+        printf("No textures referenced by %s\n", levelPath.c_str());
+        return 1;
+    }
+
+    TaskScheduler scheduler(threads);
+    Profiler serialProfiler;
+    Profiler parallelProfiler;
+    // 先各跑一次预热文件缓存，再取5次中的最好成绩
+    run(paths, nullptr, serialProfiler);
+    double serialMs = 1e30, parallelMs = 1e30;
+    for (int i = 0; i < 5; ++i) {
+        serialMs = std::min(serialMs, run(paths, nullptr, serialProfiler));
+        parallelMs = std::min(parallelMs, run(paths, &scheduler, parallelProfiler));
+    }
+
+    printf("[ImageDecode_bench] %s: %zu image(s), best of 5\n", levelPath.c_str(), paths.size());
+    printf("serial              %10.2f ms\n", serialMs);
+    printf("parallel (%2d thr)   %10.2f ms   speedup x%.1f\n",
+           scheduler.getWorkerCount(), parallelMs, serialMs / std::max(parallelMs, 1e-6));
+    serialProfiler.report();
+    return 0;
+}
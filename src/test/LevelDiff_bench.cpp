@@ -0,0 +1,106 @@
+// 关卡热重载配对基准：生成大关卡的方块/敌人/陷阱数组，修改其中少量对象后计时diffLevelObjects
+// 检查配对结果（新增、删除、改变的数量）是否与编辑一致，以及配对耗时是否远小于一帧
+// 用法：LevelDiff_bench [每种对象的数量] [编辑次数] [重复次数]，默认5000个、10次编辑、20次
+#include "LevelDiff.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 与关卡文件相同的布局：一行行地面方块，上方分布敌人和陷阱；每隔一段带id的对象
+void buildLevel(LevelDesc& level, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        BlockDesc block;
+        block.type    = (i / 8) % 2 ? "ICE" : "GRASS";
+        block.texture = "assets/textures/blocks/grass.png";
+        block.health  = 3.0f;
+        block.x       = static_cast<float>(i / 3) * 32.0f;
+        block.y       = 600.0f + static_cast<float>(i % 3) * 32.0f;
+        block.width   = block.height = 32.0f;
+        level.blocks.push_back(block);
+
+        EnemyDesc enemy;
+        enemy.texture  = "assets/textures/enemy.png";
+        enemy.health   = 5.0f;
+        enemy.x        = static_cast<float>(i) * 96.0f;
+        enemy.y        = 500.0f;
+        enemy.width    = enemy.height = 48.0f;
+        enemy.patrolAx = enemy.x - 100.0f;
+        enemy.patrolBx = enemy.x + 100.0f;
+        if (i % 16 == 0) {
+            enemy.id = "enemy" + std::to_string(i);
+        }
+        level.enemies.push_back(enemy);
+
+        TrapDesc trap;
+        trap.type    = "SPIKE";
+        trap.texture = "assets/textures/spike.png";
+        trap.damage  = 1.0f;
+        trap.x       = static_cast<float>(i) * 64.0f + 16.0f;
+        trap.y       = 568.0f;
+        trap.width   = trap.height = 32.0f;
+        level.traps.push_back(trap);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int count   = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int edits   = argc > 2 ? std::atoi(argv[2]) : 10;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 20;
+    if (count <= edits * 3) {
+        printf("object count must exceed three times the edit count\n");
+        return 1;
+    }
+
+    LevelDesc before;
+    buildLevel(before, count);
+    // 编辑：改方块的生命值、移动带id的敌人、删除陷阱、新增方块
+    LevelDesc after = before;
+    for (int e = 0; e < edits; ++e) {
+        after.blocks[e * 3].health += 1.0f;
+        after.enemies[e * 16 % count].x += 10.0f;
+    }
+    after.traps.erase(after.traps.begin(), after.traps.begin() + edits);
+    for (int e = 0; e < edits; ++e) {
+        BlockDesc block = before.blocks[0];
+        block.y = -32.0f * static_cast<float>(e + 1);
+        after.blocks.push_back(block);
+    }
+
+    double best = 1e9;
+    LevelDiff blocks, enemies, traps;
+    for (int r = 0; r < repeats; ++r) {
+        Clock::time_point start = Clock::now();
+        blocks  = diffLevelObjects(before.blocks, after.blocks);
+        enemies = diffLevelObjects(before.enemies, after.enemies);
+        traps   = diffLevelObjects(before.traps, after.traps);
+        double ms = elapsedMs(start);
+        best = ms < best ? ms : best;
+    }
+
+    printf("objects: %d per type (%d total)\n", count, count * 3);
+    printf("Block:  %zu added, %zu removed, %zu changed\n", blocks.added, blocks.removed, blocks.modified);
+    printf("Enemy:  %zu added, %zu removed, %zu changed\n", enemies.added, enemies.removed, enemies.modified);
+    printf("Trap:   %zu added, %zu removed, %zu changed\n", traps.added, traps.removed, traps.modified);
+    printf("diff time (best of %d): %.3f ms\n", repeats, best);
+
+    // 带id的敌人移动后仍与原对象配对（改变），其余编辑按坐标配对
+    std::size_t expected = static_cast<std::size_t>(edits);
+    bool ok = blocks.added == expected && blocks.removed == 0 && blocks.modified == expected &&
+              enemies.added == 0 && enemies.removed == 0 && enemies.modified == expected &&
+              traps.added == 0 && traps.removed == expected && traps.modified == 0;
+    printf("%s\n", ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// 检测热重载修补视差层后的绘制顺序：patchOrderedSlots（Scene::patchLevelObjects修补视差层用的同一个函数）
+// 移除改变的图层后重建（追加到绘制列表末尾），修补后的顺序应与按新描述完整加载时的顺序一致
+#include "LevelDiff.hpp"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const std::size_t audioSlot = 0;    // AudioManager，同样是常驻绘制的对象
+
+std::vector<ParallaxDesc> buildLayers()
+{
+    // 与config/level1.json相同：图层1（mountains_2）与图层2（mountains_1）同属FAR优先级
+    const char* textures[] = { "background.png", "mountains_2.png", "mountains_1.png", "clouds_big.png" };
+    std::vector<ParallaxDesc> layers;
+    for (int i = 0; i < 4; ++i) {
+        ParallaxDesc desc;
+        desc.layer   = i;
+        desc.texture = std::string("assets/pixel_art_mountains_parallax/layers/") + textures[i];
+        desc.speed   = 0.1f * static_cast<float>(i);
+        layers.push_back(desc);
+    }
+    return layers;
+}
+
+// 修补时使用的对象表：与Scene::removeObject/addObject一样，移除时从绘制列表删去并回收槽位，
+// 创建时优先复用回收的槽位并追加到绘制列表末尾
+struct FakeScene
+{
+    std::vector<std::uint32_t> drawIds{ static_cast<std::uint32_t>(audioSlot) };
+    std::vector<std::size_t> freeSlots;
+    std::size_t slotCount = 1;
+
+    std::size_t add()
+    {
+        std::size_t slot = slotCount;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            ++slotCount;
+        }
+        drawIds.push_back(static_cast<std::uint32_t>(slot));
+        return slot;
+    }
+
+    void remove(std::size_t slot)
+    {
+        drawIds.erase(std::remove(drawIds.begin(), drawIds.end(), static_cast<std::uint32_t>(slot)), drawIds.end());
+        freeSlots.push_back(slot);
+    }
+
+    // 与Scene::patchLevelObjects调用同一个函数
+    std::vector<std::size_t> patch(const LevelDiff& diff, const std::vector<std::size_t>& slots)
+    {
+        return patchOrderedSlots(diff, slots, drawIds,
+            [this](std::size_t slot) { remove(slot); },
+            [this](std::size_t) { return add(); });
+    }
+};
+
+bool check(const char* name, const std::vector<std::uint32_t>& drawIds, const std::vector<std::size_t>& slots)
+{
+    // 期望：AudioManager在前，之后按图层描述的顺序
+    std::vector<std::uint32_t> expected{ static_cast<std::uint32_t>(audioSlot) };
+    for (std::size_t slot : slots) {
+        expected.push_back(static_cast<std::uint32_t>(slot));
+    }
+    bool ok = drawIds == expected;
+    printf("%-28s %s\n", name, ok ? "PASS" : "FAIL");
+    return ok;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<ParallaxDesc> layers = buildLayers();
+    FakeScene scene;
+    std::vector<std::size_t> slots;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        slots.push_back(scene.add());
+    }
+    bool ok = true;
+
+    // 1) 修改中间的图层1：只有它被重建，仍画在图层2下面
+    std::vector<ParallaxDesc> edited = layers;
+    edited[1].speed = 0.5f;
+    LevelDiff diff = diffLevelObjects(layers, edited);
+    ok &= diff.modified == 1 && diff.added == 0 && diff.removed == 0 && diff.changed[1];
+    slots = scene.patch(diff, slots);
+    ok &= check("edit mid-stack layer", scene.drawIds, slots);
+    layers = edited;
+
+    // 2) 在图层0与图层1之间插入新图层
+    edited = layers;
+    ParallaxDesc inserted = layers[0];
+    inserted.layer = 9;
+    edited.insert(edited.begin() + 1, inserted);
+    diff = diffLevelObjects(layers, edited);
+    ok &= diff.added == 1 && diff.modified == 0 && diff.removed == 0;
+    slots = scene.patch(diff, slots);
+    ok &= check("insert layer", scene.drawIds, slots);
+    layers = edited;
+
+    // 3) 删除图层并修改最底下的图层
+    edited = layers;
+    edited.erase(edited.begin() + 2);
+    edited[0].y = 40.0f;
+    diff = diffLevelObjects(layers, edited);
+    ok &= diff.removed == 1 && diff.modified == 1 && diff.added == 0;
+    slots = scene.patch(diff, slots);
+    ok &= check("remove and edit bottom layer", scene.drawIds, slots);
+
+    printf("%s\n", ok ? "ALL PASSED" : "FAILED");
+    return ok ? 0 : 1;
+}
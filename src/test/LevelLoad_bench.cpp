@@ -0,0 +1,79 @@
+// 关卡加载基准：JSON（ResourceLoader + 每个对象getAllObjResources + 按字段std::get）vs 编译后的二进制关卡（内存映射 + 定长记录）
+// 先生成一个含objectCount个对象（方块/敌人/陷阱按8:1:1）的关卡JSON，用LevelBinary::cook编译，再分别计时
+// 用法：LevelLoad_bench [对象数量] [重复次数]，默认10万个对象、5次
+#include "LevelBinary.hpp"
+#include "ResourceLoader.hpp"
+#include "BenchLevelGen.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// 与Scene::init相同的读取方式：整个DOM -> 每个对象一个字典 -> 按字段查找
+double loadJson(const std::string& path, double& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    ResourceLoader loader(path);
+    for (const std::string& key : loader.getObjKeys()) {
+        loader.addObjKey(key);
+        int count = loader.getObjCount(key);
+        for (int i = 0; i < count; ++i) {
+            ResourceLoader::ResourceDict config = loader.getAllObjResources(i, key);
+            checksum += std::get<float>(config.at("x")) + std::get<float>(config.at("width"));
+            checksum += std::get<std::string>(config.at("texture")).size();
+        }
+    }
+    return benchlevel::msSince(start);
+}
+
+// 映射文件后直接遍历定长记录
+double loadBinary(const std::string& path, double& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    LevelBinary level;
+    if (!level.open(path)) {
+        return -1.0;
+    }
+    for (const auto& r : level.records<LevelBinary::BlockRecord>()) {
+        checksum += r.x + r.width + level.string(r.texture).size();
+    }
+    for (const auto& r : level.records<LevelBinary::EnemyRecord>()) {
+        checksum += r.x + r.width + level.string(r.texture).size();
+    }
+    for (const auto& r : level.records<LevelBinary::TrapRecord>()) {
+        checksum += r.x + r.width + level.string(r.texture).size();
+    }
+    return benchlevel::msSince(start);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int repeat      = argc > 2 ? std::atoi(argv[2]) : 5;
+    const std::string jsonPath = "LevelLoad_bench.json";
+    const std::string binPath  = "LevelLoad_bench.lvlb";
+
+    benchlevel::writeLevel(jsonPath, objectCount);
+    auto cookStart = std::chrono::steady_clock::now();
+    if (!LevelBinary::cook(jsonPath, binPath)) {
+        return 1;
+    }
+    double cookMs = benchlevel::msSince(cookStart);
+
+    double jsonBest = 1e30, binaryBest = 1e30;
+    double jsonSum = 0.0, binarySum = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        jsonBest   = std::min(jsonBest, loadJson(jsonPath, jsonSum));
+        binaryBest = std::min(binaryBest, loadBinary(binPath, binarySum));
+    }
+    printf("[LevelLoad_bench] %d objects, best of %d\n", objectCount, repeat);
+    printf("  cook (offline) : %10.3f ms\n", cookMs);
+    printf("  JSON           : %10.3f ms\n", jsonBest);
+    printf("  binary (mmap)  : %10.3f ms  (x%.1f)\n", binaryBest, binaryBest > 0.0 ? jsonBest / binaryBest : 0.0);
+    printf("  checksum %s\n", jsonSum == binarySum ? "match" : "MISMATCH");
+    return 0;
+}
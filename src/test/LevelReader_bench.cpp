@@ -0,0 +1,131 @@
+// 关卡解析基准：ResourceLoader（JSON DOM + 每个对象一个ResourceDict，与Scene保存的对象配置相同）vs LevelReader（SAX直接写入类型化数组）
+// 统计解析耗时与堆内存峰值（替换全局operator new/delete记录当前与峰值字节数）
+// 用法：LevelReader_bench [对象数量] [重复次数]，默认10万个对象、5次
+#include "LevelReader.hpp"
+#include "ResourceLoader.hpp"
+#include "BenchLevelGen.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::size_t currentBytes = 0;
+std::size_t peakBytes = 0;
+
+void resetPeak()
+{
+    peakBytes = currentBytes;
+}
+
+} // namespace
+
+// 每块内存前面记录大小，释放时扣除
+void* operator new(std::size_t size)
+{
+    std::size_t* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (!block) throw std::bad_alloc();
+    *block = size;
+    currentBytes += size;
+    if (currentBytes > peakBytes) peakBytes = currentBytes;
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+void operator delete(void* ptr) noexcept
+{
+    if (!ptr) return;
+    std::size_t* block = reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    currentBytes -= *block;
+    std::free(block);
+}
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+namespace {
+
+struct Result
+{
+    double ms = 0.0;
+    std::size_t peak = 0;
+    std::size_t retained = 0;   // 解析结束后仍占用的字节数（关卡数据本身）
+    double checksum = 0.0;
+};
+
+// 现有路径：DOM + 每个对象的ResourceDict（Scene在流式区块中保存这些字典）
+Result loadResourceLoader(const std::string& path)
+{
+    Result result;
+    std::size_t base = currentBytes;
+    resetPeak();
+    auto start = std::chrono::steady_clock::now();
+    {
+        ResourceLoader loader(path);
+        std::vector<ResourceLoader::ResourceDict> configs;
+        for (const std::string& key : loader.getObjKeys()) {
+            loader.addObjKey(key);
+            int count = loader.getObjCount(key);
+            for (int i = 0; i < count; ++i) {
+                configs.push_back(loader.getAllObjResources(i, key));
+            }
+        }
+        for (const auto& config : configs) {
+            result.checksum += std::get<float>(config.at("x"));
+        }
+        result.ms = benchlevel::msSince(start);
+        result.retained = currentBytes - base;
+    }
+    result.peak = peakBytes - base;
+    return result;
+}
+
+Result loadLevelReader(const std::string& path)
+{
+    Result result;
+    std::size_t base = currentBytes;
+    resetPeak();
+    auto start = std::chrono::steady_clock::now();
+    {
+        LevelReader reader;
+        LevelDesc level;
+        reader.read(path, level);
+        for (const auto& d : level.blocks)  result.checksum += d.x;
+        for (const auto& d : level.enemies) result.checksum += d.x;
+        for (const auto& d : level.traps)   result.checksum += d.x;
+        result.ms = benchlevel::msSince(start);
+        result.retained = currentBytes - base;
+    }
+    result.peak = peakBytes - base;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int repeat      = argc > 2 ? std::atoi(argv[2]) : 5;
+    const std::string path = "LevelReader_bench.json";
+    benchlevel::writeLevel(path, objectCount);
+
+    Result dom, sax;
+    dom.ms = sax.ms = 1e30;
+    for (int i = 0; i < repeat; ++i) {
+        Result a = loadResourceLoader(path);
+        Result b = loadLevelReader(path);
+        if (a.ms < dom.ms) dom = a;
+        if (b.ms < sax.ms) sax = b;
+    }
+    printf("[LevelReader_bench] %d objects, best of %d\n", objectCount, repeat);
+    printf("%-16s %10s %14s %14s\n", "loader", "ms", "peak MB", "retained MB");
+    printf("%-16s %10.2f %14.2f %14.2f\n", "ResourceLoader", dom.ms, dom.peak / 1048576.0, dom.retained / 1048576.0);
+    printf("%-16s %10.2f %14.2f %14.2f\n", "LevelReader", sax.ms, sax.peak / 1048576.0, sax.retained / 1048576.0);
+    printf("speedup x%.1f, peak memory x%.1f less, checksum %s\n",
+           sax.ms > 0.0 ? dom.ms / sax.ms : 0.0,
+           sax.peak > 0 ? static_cast<double>(dom.peak) / sax.peak : 0.0,
+           dom.checksum == sax.checksum ? "match" : "MISMATCH");
+    return 0;
+}
@@ -0,0 +1,112 @@
+// 静态碰撞合并基准：逐方块创建静态实体 vs StaticBodyMerger合并后的形状
+// 场景：若干行地面/平台方块（混合草地、冰面两种材质），上方落下一批动态方块，计时步进
+// 用法：StaticMerge_bench [方块列数] [动态实体数量] [帧数]，默认2000列、1000个实体、300帧
+#include "StaticBodyMerger.hpp"
+#include <box2d/box2d.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const float TileSize = 1.0f;
+
+// 三行地面 + 每隔一段的悬空平台，每8列换一次材质
+std::vector<StaticBodyMerger::Tile> buildTiles(int columns)
+{
+    std::vector<StaticBodyMerger::Tile> tiles;
+    for (int x = 0; x < columns; ++x) {
+        int material = (x / 8) % 2;
+        for (int row = 0; row < 3; ++row) {
+            float top = row * TileSize;
+            tiles.push_back({ x * TileSize, top, (x + 1) * TileSize, top + TileSize, material });
+        }
+        if ((x / 16) % 2 == 0) {
+            float top = 8.0f * TileSize;
+            tiles.push_back({ x * TileSize, top, (x + 1) * TileSize, top + TileSize, material });
+        }
+    }
+    return tiles;
+}
+
+void addDynamicBodies(b2WorldId world, int columns, int bodyCount)
+{
+    b2Polygon box = b2MakeBox(0.4f, 0.4f);
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = 1.0f;
+    for (int i = 0; i < bodyCount; ++i) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = { (i * 7 % columns) + 0.5f, -2.0f - (i % 10) * 1.0f };
+        b2BodyId body = b2CreateBody(world, &bodyDef);
+        b2CreatePolygonShape(body, &shapeDef, &box);
+    }
+}
+
+// 与Block::initialize相同：每个方块一个静态实体
+void addPerTileBodies(b2WorldId world, const std::vector<StaticBodyMerger::Tile>& tiles)
+{
+    for (const auto& tile : tiles) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.position = { (tile.left + tile.right) * 0.5f, (tile.top + tile.bottom) * 0.5f };
+        b2BodyId body = b2CreateBody(world, &bodyDef);
+        b2Polygon box = b2MakeBox((tile.right - tile.left) * 0.5f, (tile.bottom - tile.top) * 0.5f);
+        b2ShapeDef shapeDef = b2DefaultShapeDef();
+        shapeDef.material.userMaterialId = tile.material;
+        b2CreatePolygonShape(body, &shapeDef, &box);
+    }
+}
+
+double runSteps(b2WorldId world, int frameCount)
+{
+    const float deltaTime = 1.0f / 60.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frameCount; ++i) {
+        b2World_Step(world, deltaTime, 8);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / frameCount;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int columns    = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int bodyCount  = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int frameCount = argc > 3 ? std::atoi(argv[3]) : 300;
+    std::vector<StaticBodyMerger::Tile> tiles = buildTiles(columns);
+    printf("[StaticMerge_bench] %zu tiles, %d dynamic bodies, %d frames\n", tiles.size(), bodyCount, frameCount);
+
+    // 逐方块
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = { 0.0f, 10.0f };
+    b2WorldId perTileWorld = b2CreateWorld(&worldDef);
+    addPerTileBodies(perTileWorld, tiles);
+    addDynamicBodies(perTileWorld, columns, bodyCount);
+    b2Counters perTileCounters = b2World_GetCounters(perTileWorld);
+    double perTileMs = runSteps(perTileWorld, frameCount);
+    b2DestroyWorld(perTileWorld);
+
+    // 合并（按64列分组，与Scene按流式区块分组相同）
+    b2WorldId mergedWorld = b2CreateWorld(&worldDef);
+    StaticBodyMerger merger;
+    merger.setWorld(mergedWorld);
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        std::uint32_t group = static_cast<std::uint32_t>(tiles[i].left / (64.0f * TileSize));
+        merger.addTile(static_cast<std::uint32_t>(i), group, tiles[i]);
+    }
+    merger.rebuildDirty();
+    addDynamicBodies(mergedWorld, columns, bodyCount);
+    b2Counters mergedCounters = b2World_GetCounters(mergedWorld);
+    double mergedMs = runSteps(mergedWorld, frameCount);
+    b2DestroyWorld(mergedWorld);
+
+    printf("%-10s %10s %10s %12s\n", "mode", "bodies", "shapes", "ms/step");
+    printf("%-10s %10d %10d %12.3f\n", "per-tile", perTileCounters.bodyCount, perTileCounters.shapeCount, perTileMs);
+    printf("%-10s %10d %10d %12.3f\n", "merged", mergedCounters.bodyCount, mergedCounters.shapeCount, mergedMs);
+    printf("static shapes %zu -> %zu, step time x%.2f\n",
+           tiles.size(), merger.getStats().shapes, mergedMs > 0.0 ? perTileMs / mergedMs : 0.0);
+    return 0;
+}
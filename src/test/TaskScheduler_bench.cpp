@@ -0,0 +1,85 @@
+// 物理步进基准：不同线程数下Box2D步进的耗时
+// 压力场景：地面上堆叠bodyCount个动态方块，先预热让方块落下相互挤压，再计时
+// 用法：TaskScheduler_bench [动态实体数量] [帧数] [最大线程数]，默认4000个实体、300帧、全部硬件线程
+#include "TaskScheduler.hpp"
+#include <box2d/box2d.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+b2WorldId createStressWorld(TaskScheduler* scheduler, int bodyCount)
+{
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity = { 0.0f, -10.0f };
+    if (scheduler && scheduler->getWorkerCount() > 1) {
+        worldDef.workerCount     = scheduler->getWorkerCount();
+        worldDef.enqueueTask     = &TaskScheduler::enqueueBox2DTask;
+        worldDef.finishTask      = &TaskScheduler::finishBox2DTask;
+        worldDef.userTaskContext = scheduler;
+    }
+    b2WorldId world = b2CreateWorld(&worldDef);
+
+    // 地面
+    b2BodyDef groundDef = b2DefaultBodyDef();
+    groundDef.position = { 0.0f, -1.0f };
+    b2BodyId ground = b2CreateBody(world, &groundDef);
+    b2Polygon groundBox = b2MakeBox(400.0f, 1.0f);
+    b2ShapeDef groundShapeDef = b2DefaultShapeDef();
+    b2CreatePolygonShape(ground, &groundShapeDef, &groundBox);
+
+    // 按列堆叠的动态方块
+    const int columns = 100;
+    b2Polygon box = b2MakeBox(0.5f, 0.5f);
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    shapeDef.density = 1.0f;
+    shapeDef.material.friction = 0.6f;
+    for (int i = 0; i < bodyCount; ++i) {
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.position = { (i % columns) * 1.5f - columns * 0.75f, 0.5f + (i / columns) * 1.05f };
+        b2BodyId body = b2CreateBody(world, &bodyDef);
+        b2CreatePolygonShape(body, &shapeDef, &box);
+    }
+    return world;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int bodyCount  = argc > 1 ? std::atoi(argv[1]) : 4000;
+    int frameCount = argc > 2 ? std::atoi(argv[2]) : 300;
+    int maxWorkers = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxWorkers < 1) maxWorkers = 1;
+    const float deltaTime = 1.0f / 60.0f;
+    const int subStepCount = 8;
+
+    printf("[TaskScheduler_bench] %d dynamic bodies, %d frames, %d substeps\n", bodyCount, frameCount, subStepCount);
+    double singleMs = 0.0;
+    for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+        TaskScheduler scheduler(workers);
+        b2WorldId world = createStressWorld(&scheduler, bodyCount);
+        // 预热：方块落地并形成稳定的接触
+        for (int f = 0; f < 60; ++f) {
+            b2World_Step(world, deltaTime, subStepCount);
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < frameCount; ++f) {
+            b2World_Step(world, deltaTime, subStepCount);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double stepMs = std::chrono::duration<double, std::milli>(end - start).count() / frameCount;
+        if (workers == 1) {
+            singleMs = stepMs;
+        }
+        printf("  %2d threads : %.3f ms/step (%.2fx)\n", workers, stepMs, stepMs > 0.0 ? singleMs / stepMs : 0.0);
+        b2DestroyWorld(world);
+        if (workers < maxWorkers && workers * 2 > maxWorkers) {
+            workers = maxWorkers / 2;   // 最后一轮使用maxWorkers
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// assetpack：把资源目录打包成运行时内存映射的单文件资源包（.pak）
+// 用法：assetpack [-o 输出.pak] <目录或文件>...     打包（目录递归，包内路径与传入的相对路径一致）
+//       assetpack --verify <包.pak>                   校验每个文件的校验和
+// 需在仓库根目录运行，这样包内路径（如assets/texture/grass.png）与游戏代码中的路径一致
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 展开目录（递归，按路径排序，让同一目录的文件在包中相邻）
+bool collect(const std::string& input, std::vector<std::string>& files)
+{
+    std::error_code ec;
+    if (fs::is_regular_file(input, ec)) {
+        files.push_back(input);
+        return true;
+    }
+    if (!fs::is_directory(input, ec)) {
+        printf("[assetpack] No such file or directory: %s\n", input.c_str());
+        return false;
+    }
+    std::vector<std::string> found;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input, ec)) {
+        if (entry.is_regular_file()) {
+            found.push_back(entry.path().generic_string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    files.insert(files.end(), found.begin(), found.end());
+    return !ec;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string outPath = "assets.pak";
+    std::string verifyPath;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--verify" && i + 1 < argc) {
+            verifyPath = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (!verifyPath.empty()) {
+        AssetPack pack;
+        if (!pack.open(verifyPath)) {
+            printf("[assetpack] Cannot open %s\n", verifyPath.c_str());
+            return 1;
+        }
+        bool ok = pack.verify();
+        printf("[assetpack] %s: %zu file(s), %s\n", verifyPath.c_str(), pack.entryCount(),
+               ok ? "OK" : "CORRUPT");
+        return ok ? 0 : 1;
+    }
+    if (inputs.empty()) {
+        printf("Usage: assetpack [-o <out.pak>] <dir-or-file>...\n"
+               "       assetpack --verify <pack.pak>\n");
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) {
+        if (!collect(input, files)) {
+            return 1;
+        }
+    }
+    // 不把输出文件自己打进包里
+    std::string self = AssetPack::normalize(outPath);
+    files.erase(std::remove_if(files.begin(), files.end(), [&self](const std::string& f) {
+        return AssetPack::normalize(f) == self;
+    }), files.end());
+
+    if (!AssetPack::build(files, outPath)) {
+        return 1;
+    }
+    std::error_code ec;
+    printf("[assetpack] %s: %zu file(s), %llu bytes\n", outPath.c_str(), files.size(),
+           static_cast<unsigned long long>(fs::file_size(outPath, ec)));
+    return 0;
+}
@@ -0,0 +1,59 @@
+// levelcook：把关卡JSON编译成内存映射用的二进制关卡（.lvlb）
+// 用法：levelcook [-o 输出目录] <关卡.json>...
+// 默认输出到JSON旁边（config/level1.json -> config/level1.lvlb），任一文件出错时返回非0
+#include "LevelBinary.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string outputPathFor(const std::string& input, const std::string& outDir)
+{
+    std::string name = input;
+    std::size_t slash = input.find_last_of("/\\");
+    std::string dir = slash == std::string::npos ? std::string() : input.substr(0, slash + 1);
+    if (slash != std::string::npos) {
+        name = input.substr(slash + 1);
+    }
+    std::size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) {
+        name = name.substr(0, dot);
+    }
+    if (!outDir.empty()) {
+        dir = outDir;
+        if (dir.back() != '/' && dir.back() != '\\') {
+            dir += '/';
+        }
+    }
+    return dir + name + ".lvlb";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string outDir;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            outDir = argv[++i];
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        printf("Usage: levelcook [-o <dir>] <level.json>...\n");
+        return 1;
+    }
+
+    int failed = 0;
+    for (const std::string& input : inputs) {
+        if (!LevelBinary::cook(input, outputPathFor(input, outDir))) {
+            ++failed;
+        }
+    }
+    printf("[levelcook] %zu level(s), %d failed\n", inputs.size(), failed);
+    return failed == 0 ? 0 : 1;
+}